@@ -5,6 +5,27 @@
       "sources": [
         "src/addon.cc",
         "src/ProcessWatcher.cpp",
+        "src/ProcessTable.cpp",
+        "src/ProcessLineage.cpp",
+        "src/ProcfsBatchReader.cpp",
+        "src/PatternMatcher.cpp",
+        "src/CommandLineFlags.cpp",
+        "src/WorkStealingPool.cpp",
+        "src/ModuleInventory.cpp",
+        "src/ExecutableHasher.cpp",
+        "src/SignatureScanner.cpp",
+        "src/ElfImports.cpp",
+        "src/SocketInventory.cpp",
+        "src/FlowRates.cpp",
+        "src/CidrTrie.cpp",
+        "src/DomainObserver.cpp",
+        "src/RemoteSessions.cpp",
+        "src/Sha256.cpp",
+        "src/FdInventory.cpp",
+        "src/ResourceSampler.cpp",
+        "src/ProcessDelta.cpp",
+        "src/ProcessEventSource.cpp",
+        "src/ProcessExitWatcher.cpp",
         "src/VMDetector.cpp",
         "src/NotificationBlocker.cpp"
       ],
@@ -28,6 +49,11 @@
             "src/SystemDetector_win.cpp",
             "src/SmartDeviceDetector_win.cpp"
           ]
+        }],
+        ["OS=='linux'", {
+          "sources": [
+            "src/ScreenWatcher_linux.cpp"
+          ]
         }]
       ],
       "include_dirs": [
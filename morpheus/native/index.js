@@ -167,6 +167,16 @@ module.exports = {
         }
     },
     
+    // Background loop without a callback; the getters then return its latest
+    // report. Stop with stopProcessWatcher. False where unavailable.
+    startProcessMonitor: (options) => {
+        if (nativeAddon && nativeAddon.startProcessMonitor) {
+            return nativeAddon.startProcessMonitor(options);
+        } else {
+            return false;
+        }
+    },
+
     getProcessSnapshot: () => {
         if (nativeAddon && nativeAddon.getProcessSnapshot) {
             return nativeAddon.getProcessSnapshot();
@@ -176,6 +186,14 @@ module.exports = {
         }
     },
 
+    getProcessSnapshotAsync: () => {
+        if (nativeAddon && nativeAddon.getProcessSnapshotAsync) {
+            return nativeAddon.getProcessSnapshotAsync();
+        } else {
+            return Promise.resolve(module.exports.getProcessSnapshot());
+        }
+    },
+
     detectSuspiciousBehavior: () => {
         if (nativeAddon && nativeAddon.detectSuspiciousBehavior) {
             return nativeAddon.detectSuspiciousBehavior();
@@ -184,7 +202,184 @@ module.exports = {
             return [];
         }
     },
-    
+
+    detectSuspiciousBehaviorAsync: () => {
+        if (nativeAddon && nativeAddon.detectSuspiciousBehaviorAsync) {
+            return nativeAddon.detectSuspiciousBehaviorAsync();
+        } else {
+            return Promise.resolve(module.exports.detectSuspiciousBehavior());
+        }
+    },
+
+    getProcessReport: (options) => {
+        if (nativeAddon && nativeAddon.getProcessReport) {
+            return nativeAddon.getProcessReport(options);
+        } else {
+            console.warn('[ProctorNative] Process report not available');
+            return { generation: 0, processes: [], suspiciousIndices: [] };
+        }
+    },
+
+    getProcessReportAsync: (options) => {
+        if (nativeAddon && nativeAddon.getProcessReportAsync) {
+            return nativeAddon.getProcessReportAsync(options);
+        } else {
+            return Promise.resolve(module.exports.getProcessReport(options));
+        }
+    },
+
+    getProcessDelta: (options) => {
+        if (nativeAddon && nativeAddon.getProcessDelta) {
+            return nativeAddon.getProcessDelta(options);
+        } else {
+            console.warn('[ProctorNative] Process delta not available');
+            return { fromGeneration: 0, generation: 0, fullResync: true, added: [], removed: [], reclassified: [] };
+        }
+    },
+
+    getProcessDeltaAsync: (options) => {
+        if (nativeAddon && nativeAddon.getProcessDeltaAsync) {
+            return nativeAddon.getProcessDeltaAsync(options);
+        } else {
+            return Promise.resolve(module.exports.getProcessDelta(options));
+        }
+    },
+
+    // options: { pid, direction: 'subtree' | 'ancestry', includeEvidence, ... }
+    getProcessLineage: (options) => {
+        if (nativeAddon && nativeAddon.getProcessLineage) {
+            return nativeAddon.getProcessLineage(options);
+        } else {
+            return [];
+        }
+    },
+
+    getProcessLineageAsync: (options) => {
+        if (nativeAddon && nativeAddon.getProcessLineageAsync) {
+            return nativeAddon.getProcessLineageAsync(options);
+        } else {
+            return Promise.resolve(module.exports.getProcessLineage(options));
+        }
+    },
+
+    detectNetworkPatterns: () => {
+        if (nativeAddon && nativeAddon.detectNetworkPatterns) {
+            return nativeAddon.detectNetworkPatterns();
+        } else {
+            return [];
+        }
+    },
+
+    detectNetworkPatternsAsync: () => {
+        if (nativeAddon && nativeAddon.detectNetworkPatternsAsync) {
+            return nativeAddon.detectNetworkPatternsAsync();
+        } else {
+            return Promise.resolve(module.exports.detectNetworkPatterns());
+        }
+    },
+
+    setAnalysisParallelism: (maxThreads) => {
+        if (nativeAddon && nativeAddon.setAnalysisParallelism) {
+            return nativeAddon.setAnalysisParallelism(maxThreads);
+        } else {
+            return 1;
+        }
+    },
+
+    // entries: SHA-256 hex strings or { sha256, preHash, label }
+    setKnownBadExecutables: (entries) => {
+        if (nativeAddon && nativeAddon.setKnownBadExecutables) {
+            return nativeAddon.setKnownBadExecutables(entries);
+        } else {
+            return 0;
+        }
+    },
+
+    getExecutableHash: (pid) => {
+        if (nativeAddon && nativeAddon.getExecutableHash) {
+            return nativeAddon.getExecutableHash(pid);
+        } else {
+            return { state: 'unavailable' };
+        }
+    },
+
+    // rules: [{ id, required: [strings], any: [strings], minAny, threatLevel }];
+    // an empty array or no argument restores the built-in rules
+    setSignatureRules: (rules) => {
+        if (nativeAddon && nativeAddon.setSignatureRules) {
+            return nativeAddon.setSignatureRules(rules);
+        } else {
+            return 0;
+        }
+    },
+
+    getSignatureMatches: (pid) => {
+        if (nativeAddon && nativeAddon.getSignatureMatches) {
+            return nativeAddon.getSignatureMatches(pid);
+        } else {
+            return { state: 'unavailable', matches: [] };
+        }
+    },
+
+    // Range file lines: "<cidr> <ai_tool|screen_sharing|remote_access|vpn_tool> [label]";
+    // the file is reloaded whenever it changes
+    loadEndpointRanges: (path) => {
+        if (nativeAddon && nativeAddon.loadEndpointRanges) {
+            return nativeAddon.loadEndpointRanges(path);
+        } else {
+            return { ranges: 0, rejected: 0 };
+        }
+    },
+
+    // Passive TLS SNI / DNS observer (Linux, needs CAP_NET_RAW); resolves to false where unavailable
+    startDomainObserver: () => {
+        if (nativeAddon && nativeAddon.startDomainObserver) {
+            return nativeAddon.startDomainObserver();
+        } else {
+            return false;
+        }
+    },
+
+    stopDomainObserver: () => {
+        if (nativeAddon && nativeAddon.stopDomainObserver) {
+            nativeAddon.stopDomainObserver();
+        }
+    },
+
+    // rules: [{ suffix, category: 'ai_tool' | 'screen_sharing' | 'remote_access' | 'vpn_tool', label }];
+    // an empty array or no argument restores the built-in rules
+    setDomainRules: (rules) => {
+        if (nativeAddon && nativeAddon.setDomainRules) {
+            return nativeAddon.setDomainRules(rules);
+        } else {
+            return 0;
+        }
+    },
+
+    getDomainObserverStats: () => {
+        if (nativeAddon && nativeAddon.getDomainObserverStats) {
+            return nativeAddon.getDomainObserverStats();
+        } else {
+            return { packets: 0, names: 0, hits: 0, dropped: 0 };
+        }
+    },
+
+    setProcfsIoEngine: (engine) => {
+        if (nativeAddon && nativeAddon.setProcfsIoEngine) {
+            return nativeAddon.setProcfsIoEngine(engine);
+        } else {
+            return 'unsupported';
+        }
+    },
+
+    benchmarkProcfsReaderAsync: (iterations) => {
+        if (nativeAddon && nativeAddon.benchmarkProcfsReaderAsync) {
+            return nativeAddon.benchmarkProcfsReaderAsync(iterations);
+        } else {
+            return Promise.resolve(null);
+        }
+    },
+
     // SmartDeviceDetector functions (replaces deprecated DeviceWatcher)
     startSmartDeviceDetector: (callback, intervalMs) => {
         if (nativeAddon && nativeAddon.startSmartDeviceDetector) {
@@ -211,6 +406,14 @@ module.exports = {
         }
     },
 
+    scanAllInputDevicesAsync: () => {
+        if (nativeAddon && nativeAddon.scanAllInputDevicesAsync) {
+            return nativeAddon.scanAllInputDevicesAsync();
+        } else {
+            return Promise.resolve(module.exports.scanAllInputDevices());
+        }
+    },
+
     scanAllStorageDevices: () => {
         if (nativeAddon && nativeAddon.scanAllStorageDevices) {
             return nativeAddon.scanAllStorageDevices();
@@ -219,6 +422,14 @@ module.exports = {
         }
     },
 
+    scanAllStorageDevicesAsync: () => {
+        if (nativeAddon && nativeAddon.scanAllStorageDevicesAsync) {
+            return nativeAddon.scanAllStorageDevicesAsync();
+        } else {
+            return Promise.resolve(module.exports.scanAllStorageDevices());
+        }
+    },
+
     scanVideoDevices: () => {
         if (nativeAddon && nativeAddon.scanVideoDevices) {
             return nativeAddon.scanVideoDevices();
@@ -227,6 +438,14 @@ module.exports = {
         }
     },
 
+    scanVideoDevicesAsync: () => {
+        if (nativeAddon && nativeAddon.scanVideoDevicesAsync) {
+            return nativeAddon.scanVideoDevicesAsync();
+        } else {
+            return Promise.resolve(module.exports.scanVideoDevices());
+        }
+    },
+
     getDeviceViolations: () => {
         if (nativeAddon && nativeAddon.getDeviceViolations) {
             return nativeAddon.getDeviceViolations();
@@ -289,6 +508,14 @@ module.exports = {
         }
     },
 
+    detectScreenSharingSessionsAsync: () => {
+        if (nativeAddon && nativeAddon.detectScreenSharingSessionsAsync) {
+            return nativeAddon.detectScreenSharingSessionsAsync();
+        } else {
+            return Promise.resolve(module.exports.detectScreenSharingSessions());
+        }
+    },
+
     isScreenBeingCaptured: () => {
         if (nativeAddon && nativeAddon.isScreenBeingCaptured) {
             return nativeAddon.isScreenBeingCaptured();
@@ -306,6 +533,14 @@ module.exports = {
             return 0.0;
         }
     },
+
+    calculateScreenSharingThreatLevelAsync: () => {
+        if (nativeAddon && nativeAddon.calculateScreenSharingThreatLevelAsync) {
+            return nativeAddon.calculateScreenSharingThreatLevelAsync();
+        } else {
+            return Promise.resolve(module.exports.calculateScreenSharingThreatLevel());
+        }
+    },
     
     detectRecordingAndOverlays: () => {
         if (nativeAddon && nativeAddon.detectRecordingAndOverlays) {
@@ -356,6 +591,14 @@ module.exports = {
             };
         }
     },
+
+    detectVirtualMachineAsync: () => {
+        if (nativeAddon && nativeAddon.detectVirtualMachineAsync) {
+            return nativeAddon.detectVirtualMachineAsync();
+        } else {
+            return Promise.resolve(module.exports.detectVirtualMachine());
+        }
+    },
     
     // Notification blocker specific functions
     enableNotificationBlocking: () => {
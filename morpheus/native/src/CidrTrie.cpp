@@ -0,0 +1,292 @@
+#include "CidrTrie.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include <intrin.h>
+#else
+#include <arpa/inet.h>
+#endif
+
+namespace {
+
+inline uint64_t Load64(const uint8_t* bytes) {
+    uint64_t value = 0;
+    for (int i = 0; i < 8; i++) {
+        value = (value << 8) | bytes[i];
+    }
+    return value;
+}
+
+// Mask of the top `bits` bits of a 64-bit word
+inline uint64_t TopMask(unsigned bits) {
+    return bits == 0 ? 0 : (bits >= 64 ? ~0ULL : ~0ULL << (64 - bits));
+}
+
+inline bool PrefixMatches(uint64_t high, uint64_t low, uint64_t prefixHigh, uint64_t prefixLow, unsigned length) {
+    if (length <= 64) {
+        return ((high ^ prefixHigh) & TopMask(length)) == 0;
+    }
+    return high == prefixHigh && ((low ^ prefixLow) & TopMask(length - 64)) == 0;
+}
+
+// Bit `index` counted from the most significant bit of the 128-bit key
+inline int BitAt(uint64_t high, uint64_t low, unsigned index) {
+    return index < 64 ? static_cast<int>((high >> (63 - index)) & 1) : static_cast<int>((low >> (127 - index)) & 1);
+}
+
+// `count` (at most 32) bits starting at bit `start` of the 128-bit key
+inline uint32_t BitsAt(uint64_t high, uint64_t low, unsigned start, unsigned count) {
+    uint64_t mask = (1ULL << count) - 1;
+    unsigned end = start + count;
+    if (end <= 64) {
+        return static_cast<uint32_t>((high >> (64 - end)) & mask);
+    }
+    if (start >= 64) {
+        return static_cast<uint32_t>((low >> (128 - end)) & mask);
+    }
+    return static_cast<uint32_t>(((high << (end - 64)) | (low >> (128 - end))) & mask);
+}
+
+inline unsigned LeadingZeros(uint64_t value) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    return 63 - static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_clzll(value));
+#endif
+}
+
+inline unsigned CommonPrefix(uint64_t aHigh, uint64_t aLow, uint64_t bHigh, uint64_t bLow, unsigned limit) {
+    unsigned common;
+    if (aHigh != bHigh) {
+        common = LeadingZeros(aHigh ^ bHigh);
+    } else if (aLow != bLow) {
+        common = 64 + LeadingZeros(aLow ^ bLow);
+    } else {
+        common = 128;
+    }
+    return common < limit ? common : limit;
+}
+
+} // namespace
+
+CidrTrie::CidrTrie() : nodes_(1) {
+}
+
+bool CidrTrie::ParseAddress(const std::string& address, uint8_t out[16]) {
+    memset(out, 0, 16);
+    if (address.find(':') != std::string::npos) {
+        return inet_pton(AF_INET6, address.c_str(), out) == 1;
+    }
+    out[10] = 0xff;
+    out[11] = 0xff;
+    return inet_pton(AF_INET, address.c_str(), out + 12) == 1;
+}
+
+bool CidrTrie::Insert(const std::string& cidr, int tag, const std::string& label) {
+    size_t slash = cidr.find('/');
+    std::string address = cidr.substr(0, slash);
+    uint8_t bytes[16];
+    if (!ParseAddress(address, bytes)) {
+        return false;
+    }
+
+    bool v6 = address.find(':') != std::string::npos;
+    unsigned maxLength = v6 ? 128 : 32;
+    unsigned length = maxLength;
+    if (slash != std::string::npos) {
+        char* end = nullptr;
+        unsigned long parsed = strtoul(cidr.c_str() + slash + 1, &end, 10);
+        if (end == cidr.c_str() + slash + 1 || *end != '\0' || parsed > maxLength) {
+            return false;
+        }
+        length = static_cast<unsigned>(parsed);
+    }
+    if (!v6) {
+        length += 96;
+    }
+
+    uint64_t high = Load64(bytes) & TopMask(length);
+    uint64_t low = Load64(bytes + 8) & (length > 64 ? TopMask(length - 64) : 0);
+
+    int32_t rangeIndex = static_cast<int32_t>(ranges_.size());
+    ranges_.push_back(Range{tag, label, cidr});
+
+    auto makeNode = [&](uint64_t h, uint64_t l, unsigned len, int32_t range) {
+        Node node;
+        node.high = h;
+        node.low = l;
+        node.length = static_cast<uint8_t>(len);
+        node.range = range;
+        nodes_.push_back(node);
+        return static_cast<int32_t>(nodes_.size() - 1);
+    };
+
+    // Invariant: nodes_[current] is a prefix of the new key; indexes, not
+    // references, since makeNode may reallocate
+    int32_t current = 0;
+    while (true) {
+        if (nodes_[current].length == length) {
+            nodes_[current].range = rangeIndex;
+            return true;
+        }
+
+        int bit = BitAt(high, low, nodes_[current].length);
+        int32_t child = nodes_[current].child[bit];
+        if (child < 0) {
+            int32_t leaf = makeNode(high, low, length, rangeIndex);
+            nodes_[current].child[bit] = leaf;
+            return true;
+        }
+
+        const Node& next = nodes_[child];
+        unsigned common = CommonPrefix(high, low, next.high, next.low, std::min<unsigned>(length, next.length));
+        if (common == next.length) {
+            current = child;
+            continue;
+        }
+
+        // Split the edge to `child` at the first differing bit (or at the new prefix)
+        int childBit = BitAt(next.high, next.low, common);
+        int32_t split;
+        if (common == length) {
+            split = makeNode(high, low, length, rangeIndex);
+        } else {
+            split = makeNode(high & TopMask(common), common > 64 ? low & TopMask(common - 64) : 0, common, -1);
+            int32_t leaf = makeNode(high, low, length, rangeIndex);
+            nodes_[split].child[BitAt(high, low, common)] = leaf;
+        }
+        nodes_[split].child[childBit] = child;
+        nodes_[current].child[bit] = split;
+        return true;
+    }
+}
+
+void CidrTrie::FillStride(std::vector<StrideEntry>& table, uint64_t regionHigh, uint64_t regionLow,
+                          unsigned base) const {
+    table.assign(size_t(1) << kStrideBits, StrideEntry());
+    const unsigned strideEnd = base + kStrideBits;
+
+    // Pre-order, so a longer range overwrites the blocks of the shorter one
+    // containing it
+    std::vector<std::pair<int32_t, int32_t>> pending{{0, -1}}; // (node, best range above it)
+    while (!pending.empty()) {
+        int32_t index = pending.back().first;
+        int32_t best = pending.back().second;
+        pending.pop_back();
+
+        const Node& node = nodes_[index];
+        if (!PrefixMatches(node.high, node.low, regionHigh, regionLow, std::min<unsigned>(node.length, base))) {
+            continue; // Outside this family's region
+        }
+
+        if (node.length >= strideEnd) {
+            // Topmost node in its block: any two nodes of one block share an
+            // ancestor at least strideEnd long
+            StrideEntry& entry = table[BitsAt(node.high, node.low, base, kStrideBits)];
+            entry.node = index;
+            entry.range = best;
+            continue;
+        }
+
+        if (node.range >= 0) {
+            best = node.range;
+            size_t first = 0;
+            size_t count = table.size();
+            if (node.length > base) {
+                unsigned covered = strideEnd - node.length;
+                first = size_t(BitsAt(node.high, node.low, base, node.length - base)) << covered;
+                count = size_t(1) << covered;
+            }
+            for (size_t i = first; i < first + count; i++) {
+                table[i].range = best;
+            }
+        }
+
+        for (int32_t child : node.child) {
+            if (child >= 0) pending.push_back({child, best});
+        }
+    }
+}
+
+void CidrTrie::Freeze() {
+    FillStride(stride4_, 0, 0x0000FFFF00000000ULL, 96);
+    FillStride(stride6_, 0, 0, 0);
+}
+
+const CidrTrie::Range* CidrTrie::Lookup(const uint8_t address[16]) const {
+    uint64_t high = Load64(address);
+    uint64_t low = Load64(address + 8);
+
+    int32_t best = -1;
+    int32_t current = 0;
+    if (!stride4_.empty()) {
+        bool mapped = high == 0 && (low >> 32) == 0xFFFF;
+        const StrideEntry& entry = mapped ? stride4_[(low >> 16) & 0xFFFF] : stride6_[high >> 48];
+        best = entry.range;
+        current = entry.node;
+    }
+
+    while (current >= 0) {
+        const Node& node = nodes_[current];
+        if (!PrefixMatches(high, low, node.high, node.low, node.length)) {
+            break;
+        }
+        if (node.range >= 0) {
+            best = node.range;
+        }
+        if (node.length == 128) {
+            break;
+        }
+        current = node.child[BitAt(high, low, node.length)];
+    }
+    return best >= 0 ? &ranges_[best] : nullptr;
+}
+
+const CidrTrie::Range* CidrTrie::Lookup(const std::string& address) const {
+    uint8_t bytes[16];
+    if (!ParseAddress(address, bytes)) {
+        return nullptr;
+    }
+    return Lookup(bytes);
+}
+
+std::shared_ptr<const CidrTrie> CidrTrie::Parse(const std::string& text,
+                                                const std::function<int(const std::string&)>& tagOf,
+                                                size_t& rejected) {
+    auto trie = std::make_shared<CidrTrie>();
+    rejected = 0;
+
+    std::istringstream lines(text);
+    std::string line;
+    while (std::getline(lines, line)) {
+        size_t hash = line.find('#');
+        if (hash != std::string::npos) {
+            line.erase(hash);
+        }
+
+        std::istringstream fields(line);
+        std::string cidr, tagName, label;
+        if (!(fields >> cidr)) {
+            continue; // Blank or comment-only
+        }
+        fields >> tagName;
+        std::getline(fields >> std::ws, label);
+        while (!label.empty() && (label.back() == '\r' || label.back() == ' ' || label.back() == '\t')) {
+            label.pop_back();
+        }
+
+        int tag = tagName.empty() ? -1 : tagOf(tagName);
+        if (tag < 0 || !trie->Insert(cidr, tag, label)) {
+            rejected++;
+        }
+    }
+    trie->Freeze();
+    return trie;
+}
@@ -0,0 +1,78 @@
+#ifndef CIDR_TRIE_H
+#define CIDR_TRIE_H
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Longest-prefix match over IPv4 and IPv6 ranges. IPv4 is stored as
+// IPv4-mapped IPv6 (::ffff:a.b.c.d), so one path-compressed binary trie serves
+// both families: every node holds a full prefix and only branching points
+// exist, and nodes live in one flat array. Freeze() adds a direct-indexed first
+// stride per family (the top 16 bits of the IPv4 or IPv6 address), holding the
+// best range of at most 16 bits plus the subtree of longer prefixes, so a
+// lookup is one table load plus the few nodes of its /16. A frozen trie is
+// immutable and safe to share between threads; swap in a new one to change
+// the ranges.
+class CidrTrie {
+public:
+    struct Range {
+        int tag = 0;        // Caller-defined, e.g. a ProcessCategory
+        std::string label;  // Vendor or service name from the range file
+        std::string cidr;   // As written in the file
+    };
+
+    CidrTrie();
+
+    // False for a malformed address or prefix length. A later insert of the same
+    // prefix replaces the earlier one.
+    bool Insert(const std::string& cidr, int tag, const std::string& label);
+
+    // Builds the first-stride tables; Parse freezes its result. Lookups work
+    // before Freeze too, walking from the root.
+    void Freeze();
+
+    // Longest matching range for a 16-byte address (IPv4-mapped for IPv4), or null
+    const Range* Lookup(const uint8_t address[16]) const;
+    const Range* Lookup(const std::string& address) const;
+
+    size_t RangeCount() const { return ranges_.size(); }
+    size_t NodeCount() const { return nodes_.size(); }
+
+    // Range file: one "<cidr> <tag> [label]" per line; '#' starts a comment.
+    // tagOf maps the tag token to a tag, or -1 to reject the line. Malformed
+    // lines are counted in rejected and skipped.
+    static std::shared_ptr<const CidrTrie> Parse(const std::string& text,
+                                                 const std::function<int(const std::string&)>& tagOf,
+                                                 size_t& rejected);
+
+    // Parses an address into 16 bytes, IPv4 as IPv4-mapped IPv6
+    static bool ParseAddress(const std::string& address, uint8_t out[16]);
+
+private:
+    struct Node {
+        uint64_t high = 0;
+        uint64_t low = 0;
+        int32_t child[2] = {-1, -1};
+        int32_t range = -1;
+        uint8_t length = 0;
+    };
+
+    struct StrideEntry {
+        int32_t range = -1; // Longest range of at most the stride's length covering the block
+        int32_t node = -1;  // Topmost node with a longer prefix inside the block
+    };
+
+    static constexpr unsigned kStrideBits = 16;
+
+    void FillStride(std::vector<StrideEntry>& table, uint64_t regionHigh, uint64_t regionLow, unsigned base) const;
+
+    std::vector<Node> nodes_; // nodes_[0] is the root, prefix ::/0
+    std::vector<Range> ranges_;
+    std::vector<StrideEntry> stride4_; // By bits 96..111 of IPv4-mapped addresses
+    std::vector<StrideEntry> stride6_; // By bits 0..15 of native IPv6 addresses
+};
+
+#endif // CIDR_TRIE_H
@@ -0,0 +1,81 @@
+#include "CommandLineFlags.h"
+#include <algorithm>
+
+// Values longer than this are truncated in evidence (e.g. long origin lists)
+static const size_t kMaxValueLength = 64;
+
+const CommandLineFlagMatcher& CommandLineFlagMatcher::Instance() {
+    static const CommandLineFlagMatcher instance;
+    return instance;
+}
+
+CommandLineFlagMatcher::CommandLineFlagMatcher()
+    : flags_({
+          // Capture without the picker or permission prompt
+          {"capture", "--auto-select-desktop-capture-source"},
+          {"capture", "--auto-select-tab-capture-source-by-title"},
+          {"capture", "--auto-accept-this-tab-capture"},
+          {"capture", "--auto-accept-camera-and-microphone-capture"},
+          {"capture", "--use-fake-ui-for-media-stream"},
+          {"capture", "--use-fake-device-for-media-stream"},
+          {"capture", "--enable-usermedia-screen-capturing"},
+          {"capture", "--allow-http-screen-capture"},
+
+          // DevTools protocol exposed to another process
+          {"remote-debugging", "--remote-debugging-port"},
+          {"remote-debugging", "--remote-debugging-pipe"},
+          {"remote-debugging", "--remote-debugging-address"},
+          {"remote-debugging", "--remote-allow-origins"},
+
+          // Headless / WebDriver automation
+          {"automation", "--headless"},
+          {"automation", "--enable-automation"},
+          {"automation", "--test-type"},
+          {"automation", "--silent-debugger-extension-api"},
+
+          // Same-origin and isolation protections off
+          {"policy-bypass", "--disable-web-security"},
+          {"policy-bypass", "--disable-site-isolation-trials"},
+      }),
+      matcher_(false) {
+    for (size_t i = 0; i < flags_.size(); i++) {
+        matcher_.Add(flags_[i].name, static_cast<int>(i));
+    }
+    matcher_.Compile();
+}
+
+std::vector<std::string> CommandLineFlagMatcher::Scan(const std::string& commandLine) const {
+    std::vector<std::string> evidence;
+    const char* text = commandLine.data();
+    size_t length = commandLine.size();
+
+    // Arguments are space-separated (NULs flattened on Linux) and may be quoted on Windows
+    auto isArgumentStart = [&](size_t start) {
+        return start == 0 || text[start - 1] == ' ' || text[start - 1] == '"' || text[start - 1] == '\t';
+    };
+
+    matcher_.Scan(text, length, [&](int ruleId, size_t start, size_t end) {
+        if (!isArgumentStart(start)) return;
+        if (end < length && text[end] != '=' && text[end] != ' ' && text[end] != '"' && text[end] != '\t') return;
+
+        const Flag& flag = flags_[static_cast<size_t>(ruleId)];
+        std::string item = std::string("cmdline:") + flag.category + ":" + flag.name;
+
+        if (end < length && text[end] == '=') {
+            // A quoted argument ("--switch=a b") ends at the closing quote
+            bool quoted = start > 0 && text[start - 1] == '"';
+            size_t valueEnd = end + 1;
+            while (valueEnd < length && text[valueEnd] != '"' &&
+                   (quoted || (text[valueEnd] != ' ' && text[valueEnd] != '\t'))) {
+                valueEnd++;
+            }
+            item.append(text + end, std::min(valueEnd - end, kMaxValueLength + 1));
+        }
+
+        if (std::find(evidence.begin(), evidence.end(), item) == evidence.end()) {
+            evidence.push_back(std::move(item));
+        }
+    });
+
+    return evidence;
+}
@@ -0,0 +1,33 @@
+#ifndef COMMAND_LINE_FLAGS_H
+#define COMMAND_LINE_FLAGS_H
+
+#include <string>
+#include <vector>
+
+#include "PatternMatcher.h"
+
+// Chromium/Electron switches that reveal capture or remote-control intent.
+// Compiled once into a PatternMatcher; a command line is scanned in one pass and
+// a switch only matches as a whole argument ("--headless" but not
+// "--headless-foo"), with an optional "=value".
+class CommandLineFlagMatcher {
+public:
+    static const CommandLineFlagMatcher& Instance();
+
+    // Evidence of the form "cmdline:<category>:<switch>[=<value>]", e.g.
+    // "cmdline:remote-debugging:--remote-debugging-port=9222"
+    std::vector<std::string> Scan(const std::string& commandLine) const;
+
+private:
+    CommandLineFlagMatcher();
+
+    struct Flag {
+        const char* category;
+        const char* name;
+    };
+
+    std::vector<Flag> flags_;
+    PatternMatcher matcher_;
+};
+
+#endif // COMMAND_LINE_FLAGS_H
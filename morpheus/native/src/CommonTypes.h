@@ -1,6 +1,7 @@
 #ifndef COMMON_TYPES_H
 #define COMMON_TYPES_H
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -43,12 +44,30 @@ struct StorageDeviceInfo {
     }
 };
 
+// What a process's executable is built to do, from its imports and embedded
+// library names rather than the modules loaded at scan time
+enum ProcessCapability : unsigned {
+    kCapabilityNone = 0,
+    kCapabilityScreenCapture = 1 << 0,   // XShm/XGetImage, PipeWire streams, DRM framebuffers, ScreenCast portal
+    kCapabilityInputInjection = 1 << 1,  // XTest, xdo, libei, uinput
+    kCapabilityRemoteAccess = 1 << 2,    // VNC and RDP servers/clients
+    kCapabilityCamera = 1 << 3,          // V4L2, libcamera
+    kCapabilityAudioCapture = 1 << 4,    // PulseAudio record streams, ALSA capture
+    kCapabilityVideoEncode = 1 << 5      // libavcodec, x264, libvpx encoders
+};
+
 struct ProcessInfo {
     int pid;
     std::string name;
     std::string path;
+    unsigned long long startTime = 0;  // Clock ticks since boot (Linux), 0 where unavailable
+    int parentPid = 0;                 // 0 where unknown
+    int sessionId = -1;                // Unix session id / Windows session, -1 where unavailable
+    int uid = -1;                      // Real uid (Unix), -1 where unavailable
+    std::shared_ptr<const std::string> commandLine; // Read once per process lifetime; shared across snapshots, may be null
     std::vector<std::string> loadedModules;
     std::vector<std::string> evidence;
+    unsigned capabilities = kCapabilityNone; // ProcessCapability flags; filled in process reports (Linux)
 
     // Process classification fields
     int threatLevel = 0;      // 0=NONE, 1=LOW, 2=MEDIUM, 3=HIGH, 4=CRITICAL
@@ -0,0 +1,403 @@
+#include "DomainObserver.h"
+#include <algorithm>
+#include <cstring>
+
+#ifdef __linux__
+#include <arpa/inet.h>
+#include <linux/filter.h>
+#include <linux/if_ether.h>
+#include <linux/if_packet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+DomainObserver::DomainObserver() : rules_(Compile(DefaultRules())), running_(false), fd_(-1), ring_(nullptr) {
+    pending_.reserve(kMaxPendingHits);
+}
+
+DomainObserver::~DomainObserver() {
+    Stop();
+}
+
+std::vector<DomainRule> DomainObserver::DefaultRules() {
+    // ProcessCategory values: AI_TOOL = 1, REMOTE_ACCESS = 4
+    static const char* const kAiDomains[] = {
+        "openai.com", "chatgpt.com", "oaistatic.com", "anthropic.com", "claude.ai",
+        "gemini.google.com", "aistudio.google.com", "perplexity.ai", "copilot.microsoft.com",
+        "grok.com", "x.ai", "poe.com", "character.ai", "deepseek.com", "mistral.ai",
+        "phind.com", "you.com", "cluely.com", "interviewcoder.co", "finalroundai.com",
+        "lockedinai.com", "parakeet-ai.com"};
+    static const char* const kRemoteDomains[] = {
+        "teamviewer.com", "anydesk.com", "remotedesktop.google.com", "parsec.app",
+        "splashtop.com", "logmein.com", "rustdesk.com"};
+
+    std::vector<DomainRule> rules;
+    for (const char* domain : kAiDomains) {
+        rules.push_back(DomainRule{domain, 1, domain});
+    }
+    for (const char* domain : kRemoteDomains) {
+        rules.push_back(DomainRule{domain, 4, domain});
+    }
+    return rules;
+}
+
+std::shared_ptr<const DomainObserver::CompiledRules> DomainObserver::Compile(const std::vector<DomainRule>& rules) {
+    auto compiled = std::make_shared<CompiledRules>();
+    compiled->rules = rules.empty() ? DefaultRules() : rules;
+    for (size_t i = 0; i < compiled->rules.size(); i++) {
+        std::string suffix = compiled->rules[i].suffix;
+        // "*.example.com" and ".example.com" mean the same as "example.com"
+        if (suffix.compare(0, 2, "*.") == 0) suffix.erase(0, 2);
+        while (!suffix.empty() && suffix.front() == '.') suffix.erase(0, 1);
+        while (!suffix.empty() && suffix.back() == '.') suffix.pop_back();
+        if (suffix.empty()) continue;
+        compiled->matcher.Add("." + suffix + "\n", static_cast<int>(i));
+    }
+    compiled->matcher.Compile();
+    return compiled;
+}
+
+void DomainObserver::SetRules(const std::vector<DomainRule>& rules) {
+    std::atomic_store(&rules_, Compile(rules));
+}
+
+size_t DomainObserver::Drain(std::vector<DomainHit>& out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t count = pending_.size();
+    out.insert(out.end(), pending_.begin(), pending_.end());
+    pending_.clear();
+    return count;
+}
+
+// Copies a host name, lowercased; false if it holds bytes no host name has
+static bool CopyHostName(const uint8_t* text, size_t length, char name[256]) {
+    if (length == 0 || length > 253) {
+        return false;
+    }
+    for (size_t i = 0; i < length; i++) {
+        char c = static_cast<char>(text[i]);
+        if (c >= 'A' && c <= 'Z') {
+            c = static_cast<char>(c - 'A' + 'a');
+        } else if (!((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '-' || c == '.' || c == '_')) {
+            return false;
+        }
+        name[i] = c;
+    }
+    name[length] = '\0';
+    return true;
+}
+
+size_t DomainObserver::ParseClientHelloSni(const uint8_t* data, size_t length, char name[256]) {
+    // TLS record: type 22 (handshake), version, 16-bit length
+    if (length < 5 || data[0] != 0x16) {
+        return 0;
+    }
+    size_t end = std::min(length, size_t(5) + ((data[3] << 8) | data[4]));
+
+    // Handshake: type 1 (ClientHello), 24-bit length
+    size_t pos = 5;
+    if (end < pos + 4 || data[pos] != 0x01) {
+        return 0;
+    }
+    end = std::min(end, pos + 4 + ((size_t(data[pos + 1]) << 16) | (data[pos + 2] << 8) | data[pos + 3]));
+    pos += 4;
+
+    pos += 2 + 32; // client_version, random
+    if (pos + 1 > end) return 0;
+    pos += 1 + data[pos]; // session_id
+    if (pos + 2 > end) return 0;
+    pos += 2 + ((data[pos] << 8) | data[pos + 1]); // cipher_suites
+    if (pos + 1 > end) return 0;
+    pos += 1 + data[pos]; // compression_methods
+    if (pos + 2 > end) return 0;
+    size_t extensionsEnd = std::min(end, pos + 2 + ((data[pos] << 8) | data[pos + 1]));
+    pos += 2;
+
+    while (pos + 4 <= extensionsEnd) {
+        unsigned type = (data[pos] << 8) | data[pos + 1];
+        size_t extensionLength = (data[pos + 2] << 8) | data[pos + 3];
+        pos += 4;
+        if (type != 0) {
+            pos += extensionLength;
+            continue;
+        }
+
+        // server_name: 16-bit list length, then (type 0 = host_name, 16-bit length, name)
+        size_t listEnd = std::min(extensionsEnd, pos + extensionLength);
+        pos += 2;
+        while (pos + 3 <= listEnd) {
+            unsigned nameType = data[pos];
+            size_t nameLength = (data[pos + 1] << 8) | data[pos + 2];
+            pos += 3;
+            if (pos + nameLength > listEnd) return 0;
+            if (nameType == 0) {
+                return CopyHostName(data + pos, nameLength, name) ? nameLength : 0;
+            }
+            pos += nameLength;
+        }
+        return 0;
+    }
+    return 0;
+}
+
+size_t DomainObserver::ParseDnsQueryName(const uint8_t* data, size_t length, char name[256]) {
+    // Header: id, flags (QR = 0 and opcode 0 for a standard query), qdcount
+    if (length < 12 || (data[2] & 0xF8) != 0 || ((data[4] << 8) | data[5]) == 0) {
+        return 0;
+    }
+
+    uint8_t text[256];
+    size_t textLength = 0;
+    size_t pos = 12;
+    while (pos < length) {
+        size_t label = data[pos];
+        if (label == 0) {
+            return CopyHostName(text, textLength, name) ? textLength : 0;
+        }
+        // Compression pointers never appear in the question of a query
+        if ((label & 0xC0) != 0 || pos + 1 + label > length || textLength + label + 1 > 253) {
+            return 0;
+        }
+        if (textLength > 0) text[textLength++] = '.';
+        memcpy(text + textLength, data + pos + 1, label);
+        textLength += label;
+        pos += 1 + label;
+    }
+    return 0;
+}
+
+#ifdef __linux__
+// Maps a 4- or 16-byte address into the 16-byte IPv4-mapped form
+static void CopyAddress(uint8_t out[16], const uint8_t* address, bool v6) {
+    if (v6) {
+        memcpy(out, address, 16);
+    } else {
+        memset(out, 0, 10);
+        out[10] = 0xff;
+        out[11] = 0xff;
+        memcpy(out + 12, address, 4);
+    }
+}
+
+void DomainObserver::HandlePacket(const uint8_t* data, size_t length, const CompiledRules& rules) {
+    // The filter already checked versions, protocols, ports and that the
+    // headers it read were captured; the payload may still be truncated
+    if (length < 20) return;
+    bool v6 = (data[0] >> 4) == 6;
+    size_t headerLength = v6 ? 40 : size_t(data[0] & 0x0F) * 4;
+    uint8_t protocol = v6 ? data[6] : data[9];
+    if (length < headerLength + 8) return;
+
+    DomainHit hit;
+    CopyAddress(hit.localBytes, data + (v6 ? 8 : 12), v6);
+    CopyAddress(hit.remoteBytes, data + (v6 ? 24 : 16), v6);
+    const uint8_t* transport = data + headerLength;
+    hit.localPort = static_cast<uint16_t>((transport[0] << 8) | transport[1]);
+    hit.remotePort = static_cast<uint16_t>((transport[2] << 8) | transport[3]);
+
+    size_t nameLength;
+    if (protocol == IPPROTO_TCP) {
+        if (length < headerLength + 20) return;
+        size_t payload = headerLength + size_t(transport[12] >> 4) * 4;
+        if (payload >= length) return;
+        hit.source = DomainHit::Source::Sni;
+        nameLength = ParseClientHelloSni(data + payload, length - payload, hit.name);
+    } else {
+        hit.source = DomainHit::Source::Dns;
+        nameLength = ParseDnsQueryName(transport + 8, length - headerLength - 8, hit.name);
+    }
+    if (nameLength == 0) return;
+
+    // ".<name>\n" so that ".<suffix>\n" only matches whole trailing labels;
+    // the longest matching suffix is the most specific rule
+    char text[258];
+    text[0] = '.';
+    memcpy(text + 1, hit.name, nameLength);
+    text[nameLength + 1] = '\n';
+    int best = -1;
+    size_t bestLength = 0;
+    rules.matcher.Scan(text, nameLength + 2, [&](int ruleId, size_t start, size_t end) {
+        if (end - start > bestLength) {
+            best = ruleId;
+            bestLength = end - start;
+        }
+    });
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.names++;
+    if (best < 0) return;
+    stats_.hits++;
+    if (pending_.size() >= kMaxPendingHits) {
+        stats_.dropped++;
+        return;
+    }
+    const DomainRule& rule = rules.rules[best];
+    hit.category = rule.category;
+    size_t labelLength = std::min(rule.label.size(), sizeof(hit.label) - 1);
+    memcpy(hit.label, rule.label.data(), labelLength);
+    hit.label[labelLength] = '\0';
+    pending_.push_back(hit);
+}
+
+bool DomainObserver::Start() {
+    if (running_.load()) {
+        return true;
+    }
+
+    // Offsets are from the network header (cooked socket). Outgoing only; TCP to
+    // 443 with a payload starting 0x16 (TLS handshake), or UDP to 53. Later IPv4
+    // fragments and IPv6 extension headers are not followed.
+    struct sock_filter program[] = {
+        BPF_STMT(BPF_LD | BPF_W | BPF_ABS, static_cast<uint32_t>(SKF_AD_OFF + SKF_AD_PKTTYPE)), // 0
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, PACKET_OUTGOING, 0, 26),      // 1  -> drop
+        BPF_STMT(BPF_LD | BPF_B | BPF_ABS, 0),                            // 2  version
+        BPF_STMT(BPF_ALU | BPF_AND | BPF_K, 0xF0),                        // 3
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 0x40, 0, 6),                  // 4  -> 11 (IPv6)
+        BPF_STMT(BPF_LD | BPF_H | BPF_ABS, 6),                            // 5  fragment offset
+        BPF_JUMP(BPF_JMP | BPF_JSET | BPF_K, 0x1FFF, 21, 0),              // 6  -> drop
+        BPF_STMT(BPF_LDX | BPF_B | BPF_MSH, 0),                           // 7  X = IPv4 header length
+        BPF_STMT(BPF_LD | BPF_B | BPF_ABS, 9),                            // 8  protocol
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, IPPROTO_TCP, 6, 0),           // 9  -> 16 (TCP)
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, IPPROTO_UDP, 14, 17),         // 10 -> 25 (UDP) / drop
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 0x60, 0, 16),                 // 11 -> drop
+        BPF_STMT(BPF_LDX | BPF_W | BPF_IMM, 40),                          // 12 X = IPv6 header length
+        BPF_STMT(BPF_LD | BPF_B | BPF_ABS, 6),                            // 13 next header
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, IPPROTO_TCP, 1, 0),           // 14 -> 16 (TCP)
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, IPPROTO_UDP, 9, 12),          // 15 -> 25 (UDP) / drop
+        BPF_STMT(BPF_LD | BPF_H | BPF_IND, 2),                            // 16 TCP destination port
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 443, 0, 10),                  // 17 -> drop
+        BPF_STMT(BPF_LD | BPF_B | BPF_IND, 12),                           // 18 data offset
+        BPF_STMT(BPF_ALU | BPF_RSH | BPF_K, 2),                           // 19
+        BPF_STMT(BPF_ALU | BPF_AND | BPF_K, 0x3C),                        // 20 TCP header length
+        BPF_STMT(BPF_ALU | BPF_ADD | BPF_X, 0),                           // 21
+        BPF_STMT(BPF_MISC | BPF_TAX, 0),                                  // 22 X = payload offset
+        BPF_STMT(BPF_LD | BPF_B | BPF_IND, 0),                            // 23 fails (drops) without payload
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 0x16, 2, 3),                  // 24 -> accept / drop
+        BPF_STMT(BPF_LD | BPF_H | BPF_IND, 2),                            // 25 UDP destination port
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 53, 0, 1),                    // 26 -> accept / drop
+        BPF_STMT(BPF_RET | BPF_K, kSnapBytes),                            // 27 accept
+        BPF_STMT(BPF_RET | BPF_K, 0),                                     // 28 drop
+    };
+    struct sock_fprog filter;
+    filter.len = sizeof(program) / sizeof(program[0]);
+    filter.filter = program;
+
+    // Protocol 0 receives nothing until bind, so no packet is queued before the
+    // filter is attached
+    int fd = socket(AF_PACKET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return false;
+    }
+
+    int version = TPACKET_V3;
+    struct tpacket_req3 request;
+    memset(&request, 0, sizeof(request));
+    request.tp_block_size = kBlockSize;
+    request.tp_block_nr = kBlockCount;
+    request.tp_frame_size = kFrameSize;
+    request.tp_frame_nr = (kBlockSize * kBlockCount) / kFrameSize;
+    request.tp_retire_blk_tov = kBlockTimeoutMs;
+
+    struct sockaddr_ll address;
+    memset(&address, 0, sizeof(address));
+    address.sll_family = AF_PACKET;
+    address.sll_protocol = htons(ETH_P_ALL);
+
+    void* ring = MAP_FAILED;
+    if (setsockopt(fd, SOL_SOCKET, SO_ATTACH_FILTER, &filter, sizeof(filter)) < 0 ||
+        setsockopt(fd, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) < 0 ||
+        setsockopt(fd, SOL_PACKET, PACKET_RX_RING, &request, sizeof(request)) < 0 ||
+        (ring = mmap(nullptr, kBlockSize * kBlockCount, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)) == MAP_FAILED ||
+        bind(fd, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) < 0) {
+        if (ring != MAP_FAILED) munmap(ring, kBlockSize * kBlockCount);
+        close(fd);
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        fd_ = fd;
+        ring_ = static_cast<uint8_t*>(ring);
+    }
+    running_ = true;
+    thread_ = std::thread(&DomainObserver::Loop, this);
+    return true;
+}
+
+void DomainObserver::Stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    munmap(ring_, kBlockSize * kBlockCount);
+    close(fd_);
+    ring_ = nullptr;
+    fd_ = -1;
+}
+
+DomainObserverStats DomainObserver::Stats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (fd_ >= 0) {
+        // Reading the socket statistics resets them, so accumulate
+        struct tpacket_stats_v3 kernel;
+        socklen_t size = sizeof(kernel);
+        if (getsockopt(fd_, SOL_PACKET, PACKET_STATISTICS, &kernel, &size) == 0) {
+            stats_.packets += kernel.tp_packets;
+            stats_.dropped += kernel.tp_drops;
+        }
+    }
+    return stats_;
+}
+
+void DomainObserver::Loop() {
+    size_t current = 0;
+    while (running_.load()) {
+        auto* block = reinterpret_cast<struct tpacket_block_desc*>(ring_ + current * kBlockSize);
+        if ((__atomic_load_n(&block->hdr.bh1.block_status, __ATOMIC_ACQUIRE) & TP_STATUS_USER) == 0) {
+            struct pollfd pfd = {fd_, POLLIN | POLLERR, 0};
+            poll(&pfd, 1, 200); // Bounded so Stop is noticed
+            continue;
+        }
+
+        auto rules = std::atomic_load(&rules_);
+        const uint8_t* packet = reinterpret_cast<const uint8_t*>(block) + block->hdr.bh1.offset_to_first_pkt;
+        for (uint32_t i = 0; i < block->hdr.bh1.num_pkts; i++) {
+            const auto* header = reinterpret_cast<const struct tpacket3_hdr*>(packet);
+            // tp_snaplen counts from tp_mac; cooked sockets put both offsets at the network header
+            size_t skipped = header->tp_net - header->tp_mac;
+            if (header->tp_snaplen > skipped) {
+                HandlePacket(packet + header->tp_net, header->tp_snaplen - skipped, *rules);
+            }
+            packet += header->tp_next_offset;
+        }
+
+        __atomic_store_n(&block->hdr.bh1.block_status, TP_STATUS_KERNEL, __ATOMIC_RELEASE);
+        current = (current + 1) % kBlockCount;
+    }
+}
+#else
+bool DomainObserver::Start() {
+    return false;
+}
+
+void DomainObserver::Stop() {
+}
+
+DomainObserverStats DomainObserver::Stats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void DomainObserver::Loop() {
+}
+
+void DomainObserver::HandlePacket(const uint8_t*, size_t, const CompiledRules&) {
+}
+#endif
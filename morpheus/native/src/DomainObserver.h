@@ -0,0 +1,112 @@
+#ifndef DOMAIN_OBSERVER_H
+#define DOMAIN_OBSERVER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "PatternMatcher.h"
+
+// A domain and its subdomains: "openai.com" matches "openai.com" and
+// "chat.openai.com" but not "notopenai.com"
+struct DomainRule {
+    std::string suffix;
+    int category = 0;  // A ProcessCategory value
+    std::string label;
+};
+
+// One outgoing name that matched a rule, with the packet's addresses so the
+// caller can find the socket that sent it
+struct DomainHit {
+    enum class Source : uint8_t { Sni, Dns };
+
+    Source source = Source::Sni;  // SNI comes from TCP, DNS from UDP
+    uint8_t localBytes[16] = {};  // Network order, IPv4 as IPv4-mapped IPv6
+    uint16_t localPort = 0;
+    uint8_t remoteBytes[16] = {};
+    uint16_t remotePort = 0;
+    int category = 0;
+    char name[256] = {};          // Lowercased
+    char label[64] = {};          // Of the rule, truncated
+};
+
+struct DomainObserverStats {
+    uint64_t packets = 0; // Passed the kernel filter
+    uint64_t names = 0;   // SNI or DNS names parsed out of them
+    uint64_t hits = 0;    // Names that matched a rule
+    uint64_t dropped = 0; // By the kernel (ring full) or because the hit queue was full
+};
+
+// Passive observer of outgoing TLS ClientHello server names and DNS query
+// names. An AF_PACKET socket in cooked mode carries a classic BPF filter that
+// only accepts outgoing TCP segments to port 443 whose payload starts a TLS
+// handshake record, and UDP datagrams to port 53, so ordinary traffic never
+// leaves the kernel. Accepted packets land in a TPACKET_V3 ring of fixed size
+// mapped into the process and are parsed in place; names are matched against
+// one Aho-Corasick automaton over ".<suffix>\n" patterns, which anchors each
+// rule at a label boundary and the end of the name. Matches wait in a fixed
+// queue until drained. Only the first segment of a ClientHello is read, so a
+// server_name extension pushed into a later segment is missed.
+//
+// Linux only, and needs CAP_NET_RAW; Start() fails otherwise.
+class DomainObserver {
+public:
+    static constexpr size_t kBlockSize = 256 * 1024;  // Ring: 4 x 256 KiB
+    static constexpr size_t kBlockCount = 4;
+    static constexpr size_t kFrameSize = 2048;
+    static constexpr unsigned kSnapBytes = 4096;       // Captured prefix of each packet
+    static constexpr int kBlockTimeoutMs = 50;         // Partially filled blocks are handed over after this
+    static constexpr size_t kMaxPendingHits = 256;
+
+    DomainObserver();
+    ~DomainObserver();
+
+    bool Start();
+    void Stop();
+    bool IsRunning() const { return running_.load(); }
+
+    // Replaces the rule set; an empty list restores the defaults
+    void SetRules(const std::vector<DomainRule>& rules);
+    static std::vector<DomainRule> DefaultRules();
+
+    // Moves the queued hits to out (appending) and returns how many
+    size_t Drain(std::vector<DomainHit>& out);
+
+    DomainObserverStats Stats();
+
+    // Parsers over captured bytes, exposed for reuse. Both write the lowercased
+    // name and return its length, or 0 if the data holds no usable name.
+    static size_t ParseClientHelloSni(const uint8_t* data, size_t length, char name[256]);
+    static size_t ParseDnsQueryName(const uint8_t* data, size_t length, char name[256]);
+
+private:
+    DomainObserver(const DomainObserver&) = delete;
+    DomainObserver& operator=(const DomainObserver&) = delete;
+
+    struct CompiledRules {
+        PatternMatcher matcher{true};
+        std::vector<DomainRule> rules;
+    };
+
+    static std::shared_ptr<const CompiledRules> Compile(const std::vector<DomainRule>& rules);
+
+    void Loop();
+    void HandlePacket(const uint8_t* data, size_t length, const CompiledRules& rules);
+
+    std::shared_ptr<const CompiledRules> rules_; // Swapped with atomic_store
+    std::atomic<bool> running_;
+    std::thread thread_;
+    int fd_;
+    uint8_t* ring_;
+
+    std::vector<DomainHit> pending_; // Fixed capacity kMaxPendingHits
+    DomainObserverStats stats_;
+    std::mutex mutex_;               // Guards pending_ and stats_
+};
+
+#endif // DOMAIN_OBSERVER_H
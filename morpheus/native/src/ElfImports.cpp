@@ -0,0 +1,441 @@
+#include "ElfImports.h"
+#include "PatternMatcher.h"
+#include "WorkStealingPool.h"
+#include <algorithm>
+#include <cstring>
+
+#ifdef __linux__
+#include <elf.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdio>
+#endif
+
+namespace {
+
+struct Indicator {
+    const char* text;
+    unsigned capability;
+};
+
+// Dynamic symbols, matched exactly
+const Indicator kSymbols[] = {
+    {"XShmGetImage", kCapabilityScreenCapture},
+    {"XGetImage", kCapabilityScreenCapture},
+    {"XCompositeNameWindowPixmap", kCapabilityScreenCapture},
+    {"xcb_shm_get_image", kCapabilityScreenCapture},
+    {"xcb_get_image", kCapabilityScreenCapture},
+    {"pw_stream_connect", kCapabilityScreenCapture},
+    {"drmModeGetFB", kCapabilityScreenCapture},
+    {"drmModeGetFB2", kCapabilityScreenCapture},
+    {"gdk_pixbuf_get_from_window", kCapabilityScreenCapture},
+    {"obs_startup", kCapabilityScreenCapture},
+
+    {"XTestFakeKeyEvent", kCapabilityInputInjection},
+    {"XTestFakeButtonEvent", kCapabilityInputInjection},
+    {"XTestFakeMotionEvent", kCapabilityInputInjection},
+    {"xcb_test_fake_input", kCapabilityInputInjection},
+    {"xdo_send_keysequence_window", kCapabilityInputInjection},
+    {"xdo_move_mouse", kCapabilityInputInjection},
+    {"libevdev_uinput_create_from_device", kCapabilityInputInjection},
+    {"ei_device_keyboard_key", kCapabilityInputInjection},
+
+    {"rfbGetScreen", kCapabilityRemoteAccess},
+    {"rfbInitServer", kCapabilityRemoteAccess},
+    {"rfbInitClient", kCapabilityRemoteAccess},
+    {"freerdp_new", kCapabilityRemoteAccess},
+    {"freerdp_peer_new", kCapabilityRemoteAccess},
+
+    {"v4l2_open", kCapabilityCamera},
+    {"v4l2_ioctl", kCapabilityCamera},
+
+    {"pa_stream_connect_record", kCapabilityAudioCapture},
+    {"snd_pcm_readi", kCapabilityAudioCapture},
+
+    {"avcodec_send_frame", kCapabilityVideoEncode},
+    {"avcodec_encode_video2", kCapabilityVideoEncode},
+    {"x264_encoder_encode", kCapabilityVideoEncode},
+    {"vpx_codec_encode", kCapabilityVideoEncode},
+};
+
+// DT_NEEDED entries, matched as prefixes of the library file name
+const Indicator kLibraries[] = {
+    {"libpipewire-", kCapabilityScreenCapture},
+    {"libobs.", kCapabilityScreenCapture},
+    {"libavdevice.", kCapabilityScreenCapture},
+    {"libXtst.", kCapabilityInputInjection},
+    {"libxcb-xtest.", kCapabilityInputInjection},
+    {"libxdo.", kCapabilityInputInjection},
+    {"libei.", kCapabilityInputInjection},
+    {"libvncserver.", kCapabilityRemoteAccess},
+    {"libvncclient.", kCapabilityRemoteAccess},
+    {"libfreerdp", kCapabilityRemoteAccess},
+    {"libwinpr", kCapabilityRemoteAccess},
+    {"libv4l2.", kCapabilityCamera},
+    {"libcamera.", kCapabilityCamera},
+    {"libavcodec.", kCapabilityVideoEncode},
+    {"libx264.", kCapabilityVideoEncode},
+    {"libvpx.", kCapabilityVideoEncode},
+};
+
+// Substrings of .rodata: library names handed to dlopen, device paths and
+// portal interfaces that are used without linking anything
+const Indicator kStrings[] = {
+    {"libpipewire-0.3.so", kCapabilityScreenCapture},
+    {"org.freedesktop.portal.ScreenCast", kCapabilityScreenCapture},
+    {"libXtst.so", kCapabilityInputInjection},
+    {"/dev/uinput", kCapabilityInputInjection},
+    {"org.freedesktop.portal.RemoteDesktop", kCapabilityInputInjection},
+    {"libvncserver.so", kCapabilityRemoteAccess},
+    {"libfreerdp", kCapabilityRemoteAccess},
+    {"libv4l2.so", kCapabilityCamera},
+    {"/dev/video", kCapabilityCamera},
+    {"libavcodec.so", kCapabilityVideoEncode},
+};
+
+const std::unordered_map<std::string, unsigned>& SymbolTable() {
+    static const std::unordered_map<std::string, unsigned> table = [] {
+        std::unordered_map<std::string, unsigned> symbols;
+        for (const auto& indicator : kSymbols) {
+            symbols[indicator.text] |= indicator.capability;
+        }
+        return symbols;
+    }();
+    return table;
+}
+
+const PatternMatcher& StringMatcher() {
+    static const PatternMatcher matcher = [] {
+        PatternMatcher strings;
+        for (size_t i = 0; i < sizeof(kStrings) / sizeof(kStrings[0]); i++) {
+            strings.Add(kStrings[i].text, static_cast<int>(i));
+        }
+        strings.Compile();
+        return strings;
+    }();
+    return matcher;
+}
+
+#ifdef __linux__
+bool ReadAt(int fd, void* buffer, size_t length, uint64_t offset) {
+    char* out = static_cast<char*>(buffer);
+    while (length > 0) {
+        ssize_t n = pread(fd, out, length, static_cast<off_t>(offset));
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        out += n;
+        offset += static_cast<uint64_t>(n);
+        length -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// Reads a file range bounds-checked against the file size
+bool ReadRange(int fd, uint64_t fileSize, uint64_t offset, uint64_t length, std::vector<char>& out) {
+    if (offset > fileSize || length > fileSize - offset) return false;
+    out.resize(static_cast<size_t>(length));
+    return length == 0 || ReadAt(fd, out.data(), out.size(), offset);
+}
+
+const char* StringAt(const std::vector<char>& table, uint64_t offset) {
+    if (offset >= table.size()) return nullptr;
+    // Tables end with NUL, but a corrupt one must not run past the buffer
+    if (memchr(table.data() + offset, '\0', table.size() - offset) == nullptr) return nullptr;
+    return table.data() + offset;
+}
+
+void AddIndicator(ElfImportSummary& summary, unsigned capability, const std::string& indicator) {
+    summary.capabilities |= capability;
+    if (std::find(summary.indicators.begin(), summary.indicators.end(), indicator) == summary.indicators.end()) {
+        summary.indicators.push_back(indicator);
+    }
+}
+
+void MatchNeeded(ElfImportSummary& summary, const char* name) {
+    summary.needed.push_back(name);
+    const char* base = strrchr(name, '/');
+    base = base ? base + 1 : name;
+    for (const auto& library : kLibraries) {
+        if (strncmp(base, library.text, strlen(library.text)) == 0) {
+            AddIndicator(summary, library.capability, std::string("needed:") + base);
+        }
+    }
+}
+
+template <typename Ehdr, typename Shdr, typename Phdr, typename Sym, typename Dyn>
+void AnalyzeClass(int fd, uint64_t fileSize, ElfImportSummary& summary) {
+    Ehdr header;
+    if (!ReadAt(fd, &header, sizeof(header), 0)) return;
+    summary.parsed = true;
+
+    std::vector<char> sectionData;
+    bool haveSections = header.e_shoff != 0 && header.e_shnum > 0 && header.e_shnum < 4096 &&
+                        header.e_shentsize == sizeof(Shdr) &&
+                        ReadRange(fd, fileSize, header.e_shoff, uint64_t(header.e_shnum) * sizeof(Shdr), sectionData);
+
+    if (haveSections) {
+        std::vector<Shdr> sections(header.e_shnum);
+        memcpy(sections.data(), sectionData.data(), sectionData.size());
+
+        std::vector<char> sectionNames;
+        if (header.e_shstrndx < sections.size()) {
+            const Shdr& names = sections[header.e_shstrndx];
+            if (!ReadRange(fd, fileSize, names.sh_offset, names.sh_size, sectionNames)) sectionNames.clear();
+        }
+
+        const auto& symbolTable = SymbolTable();
+        std::vector<char> data;
+        std::vector<char> strings;
+
+        for (const Shdr& section : sections) {
+            bool isSymbols = section.sh_type == SHT_DYNSYM;
+            bool isDynamic = section.sh_type == SHT_DYNAMIC;
+
+            if ((isSymbols || isDynamic) && section.sh_link < sections.size()) {
+                const Shdr& stringSection = sections[section.sh_link];
+                if (!ReadRange(fd, fileSize, section.sh_offset, section.sh_size, data) ||
+                    !ReadRange(fd, fileSize, stringSection.sh_offset, stringSection.sh_size, strings)) {
+                    continue;
+                }
+
+                if (isSymbols) {
+                    size_t count = data.size() / sizeof(Sym);
+                    for (size_t i = 0; i < count; i++) {
+                        Sym symbol;
+                        memcpy(&symbol, data.data() + i * sizeof(Sym), sizeof(Sym));
+                        const char* name = StringAt(strings, symbol.st_name);
+                        if (!name || !*name) continue;
+
+                        // Versioned names ("sym@VER") never appear in .dynsym itself
+                        auto it = symbolTable.find(name);
+                        if (it != symbolTable.end()) {
+                            AddIndicator(summary, it->second, std::string("symbol:") + name);
+                        }
+                    }
+                } else {
+                    size_t count = data.size() / sizeof(Dyn);
+                    for (size_t i = 0; i < count; i++) {
+                        Dyn entry;
+                        memcpy(&entry, data.data() + i * sizeof(Dyn), sizeof(Dyn));
+                        if (entry.d_tag == DT_NULL) break;
+                        if (entry.d_tag != DT_NEEDED) continue;
+                        const char* name = StringAt(strings, entry.d_un.d_val);
+                        if (name) MatchNeeded(summary, name);
+                    }
+                }
+                continue;
+            }
+
+            const char* name = StringAt(sectionNames, section.sh_name);
+            if (section.sh_type == SHT_PROGBITS && name && strcmp(name, ".rodata") == 0) {
+                // Streamed through the automaton so a large .rodata needs no big buffer
+                const PatternMatcher& matcher = StringMatcher();
+                uint64_t length = std::min<uint64_t>(section.sh_size, ElfImportAnalyzer::kMaxRodataBytes);
+                if (section.sh_offset > fileSize || length > fileSize - section.sh_offset) continue;
+
+                static thread_local std::vector<char> buffer(256 * 1024);
+                int32_t state = 0;
+                for (uint64_t done = 0; done < length;) {
+                    size_t chunk = static_cast<size_t>(std::min<uint64_t>(length - done, buffer.size()));
+                    if (!ReadAt(fd, buffer.data(), chunk, section.sh_offset + done)) break;
+                    state = matcher.ScanChunk(state, buffer.data(), chunk, [&](int index) {
+                        AddIndicator(summary, kStrings[index].capability, std::string("string:") + kStrings[index].text);
+                    });
+                    done += chunk;
+                }
+            }
+        }
+        return;
+    }
+
+    // No section headers (sstrip'ed): DT_NEEDED through the program headers.
+    // DT_STRTAB is a virtual address, translated via the PT_LOAD segments.
+    std::vector<char> programData;
+    if (header.e_phoff == 0 || header.e_phnum == 0 || header.e_phnum >= 4096 || header.e_phentsize != sizeof(Phdr) ||
+        !ReadRange(fd, fileSize, header.e_phoff, uint64_t(header.e_phnum) * sizeof(Phdr), programData)) {
+        return;
+    }
+    std::vector<Phdr> segments(header.e_phnum);
+    memcpy(segments.data(), programData.data(), programData.size());
+
+    auto it = std::find_if(segments.begin(), segments.end(), [](const Phdr& s) { return s.p_type == PT_DYNAMIC; });
+    std::vector<char> dynamicData;
+    if (it == segments.end() || !ReadRange(fd, fileSize, it->p_offset, it->p_filesz, dynamicData)) {
+        return;
+    }
+
+    std::vector<Dyn> dynamic(dynamicData.size() / sizeof(Dyn));
+    memcpy(dynamic.data(), dynamicData.data(), dynamic.size() * sizeof(Dyn));
+
+    uint64_t stringAddress = 0;
+    uint64_t stringSize = 0;
+    for (const Dyn& entry : dynamic) {
+        if (entry.d_tag == DT_NULL) break;
+        if (entry.d_tag == DT_STRTAB) stringAddress = entry.d_un.d_ptr;
+        if (entry.d_tag == DT_STRSZ) stringSize = entry.d_un.d_val;
+    }
+
+    std::vector<char> strings;
+    for (const Phdr& segment : segments) {
+        if (segment.p_type != PT_LOAD || stringAddress < segment.p_vaddr ||
+            stringAddress + stringSize > segment.p_vaddr + segment.p_filesz) {
+            continue;
+        }
+        if (!ReadRange(fd, fileSize, segment.p_offset + (stringAddress - segment.p_vaddr), stringSize, strings)) {
+            return;
+        }
+        for (const Dyn& entry : dynamic) {
+            if (entry.d_tag == DT_NULL) break;
+            if (entry.d_tag != DT_NEEDED) continue;
+            const char* name = StringAt(strings, entry.d_un.d_val);
+            if (name) MatchNeeded(summary, name);
+        }
+        return;
+    }
+}
+#endif
+
+} // namespace
+
+ElfImportAnalyzer::ElfImportAnalyzer() {
+}
+
+ElfImportAnalyzer::~ElfImportAnalyzer() {
+#ifdef __linux__
+    for (auto& job : jobs_) {
+        close(job.fd);
+    }
+#endif
+}
+
+ElfImportSummary ElfImportAnalyzer::Analyze(int fd, unsigned long long size) {
+    ElfImportSummary summary;
+#ifdef __linux__
+    unsigned char ident[EI_NIDENT];
+    if (size < sizeof(Elf64_Ehdr) || !ReadAt(fd, ident, sizeof(ident), 0) || memcmp(ident, ELFMAG, SELFMAG) != 0) {
+        return summary;
+    }
+
+    // Only the host byte order; a foreign-endian binary cannot run here anyway
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    const unsigned char hostData = ELFDATA2LSB;
+#else
+    const unsigned char hostData = ELFDATA2MSB;
+#endif
+    if (ident[EI_DATA] != hostData) {
+        return summary;
+    }
+
+    if (ident[EI_CLASS] == ELFCLASS64) {
+        AnalyzeClass<Elf64_Ehdr, Elf64_Shdr, Elf64_Phdr, Elf64_Sym, Elf64_Dyn>(fd, size, summary);
+    } else if (ident[EI_CLASS] == ELFCLASS32) {
+        AnalyzeClass<Elf32_Ehdr, Elf32_Shdr, Elf32_Phdr, Elf32_Sym, Elf32_Dyn>(fd, size, summary);
+    }
+#else
+    (void)fd;
+    (void)size;
+#endif
+    return summary;
+}
+
+unsigned ElfImportAnalyzer::Lookup(const ProcessInfo& process) {
+#ifdef __linux__
+    auto queued = [&](const FileKey& key) {
+        return std::any_of(jobs_.begin(), jobs_.end(), [&](const Job& job) { return job.key == key; });
+    };
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = pids_.find(process.pid);
+        if (it != pids_.end() && it->second.startTime == process.startTime && it->second.path == process.path) {
+            if (!it->second.opened) return kCapabilityNone;
+            auto result = results_.find(it->second.key);
+            if (result != results_.end()) return result->second;
+            if (queued(it->second.key)) return kCapabilityNone;
+            // Neither analyzed nor queued: the queue was full; retry below
+        }
+    }
+
+    PidEntry entry;
+    entry.startTime = process.startTime;
+    entry.path = process.path;
+
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/%d/exe", process.pid);
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    struct stat fileStat;
+    if (fd >= 0 && fstat(fd, &fileStat) == 0 && S_ISREG(fileStat.st_mode)) {
+        entry.opened = true;
+        entry.key = FileKey::FromStat(fileStat);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    PidEntry& cached = pids_[process.pid];
+    cached = std::move(entry);
+
+    if (!cached.opened || results_.count(cached.key) || queued(cached.key) || jobs_.size() >= kMaxPendingFiles) {
+        if (fd >= 0) close(fd);
+        auto result = cached.opened ? results_.find(cached.key) : results_.end();
+        return result != results_.end() ? result->second : kCapabilityNone;
+    }
+
+    jobs_.push_back({cached.key, fd});
+    return kCapabilityNone;
+#else
+    (void)process;
+    return kCapabilityNone;
+#endif
+}
+
+void ElfImportAnalyzer::Advance(size_t maxFiles) {
+#ifdef __linux__
+    std::lock_guard<std::mutex> advanceLock(advanceMutex_);
+
+    // Lookup only appends, so these stay at the front until erased below
+    std::vector<Job> batch;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        size_t count = std::min(maxFiles, jobs_.size());
+        batch.assign(jobs_.begin(), jobs_.begin() + static_cast<std::ptrdiff_t>(count));
+    }
+
+    if (batch.empty()) {
+        return;
+    }
+
+    std::vector<unsigned> capabilities(batch.size(), kCapabilityNone);
+    WorkStealingPool::Instance().ParallelFor(batch.size(), [&](size_t index) {
+        capabilities[index] = Analyze(batch[index].fd, batch[index].key.size).capabilities;
+    });
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < batch.size(); i++) {
+        results_[batch[i].key] = capabilities[i];
+        close(batch[i].fd);
+    }
+    jobs_.erase(jobs_.begin(), jobs_.begin() + static_cast<std::ptrdiff_t>(batch.size()));
+#else
+    (void)maxFiles;
+#endif
+}
+
+size_t ElfImportAnalyzer::PendingFiles() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return jobs_.size();
+}
+
+void ElfImportAnalyzer::Sweep(const std::vector<ProcessInfo>& processes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    for (auto it = pids_.begin(); it != pids_.end();) {
+        auto listed = std::lower_bound(processes.begin(), processes.end(), it->first,
+                                       [](const ProcessInfo& process, int pid) { return process.pid < pid; });
+        if (listed == processes.end() || listed->pid != it->first || listed->startTime != it->second.startTime) {
+            it = pids_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
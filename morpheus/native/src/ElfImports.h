@@ -0,0 +1,76 @@
+#ifndef ELF_IMPORTS_H
+#define ELF_IMPORTS_H
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "CommonTypes.h"
+#include "FileKey.h"
+
+struct ElfImportSummary {
+    bool parsed = false;                 // False if the file is not a native-endian ELF
+    unsigned capabilities = kCapabilityNone;
+    std::vector<std::string> needed;     // DT_NEEDED entries
+    std::vector<std::string> indicators; // Imports, libraries and strings that set a capability bit
+};
+
+// Static capability analysis of process executables. Reads DT_NEEDED from the
+// dynamic section, the names in .dynsym (imports and exports) and .rodata,
+// where lazily dlopen'ed library names and device paths such as /dev/uinput
+// sit. Binaries with stripped section headers fall back to DT_NEEDED via
+// PT_DYNAMIC. Each file is read once per (device, inode, mtime, size) with
+// pread; Advance() analyzes a bounded number of queued files per call on the
+// analysis pool. Linux only; other platforms report kCapabilityNone.
+class ElfImportAnalyzer {
+public:
+    static constexpr size_t kMaxRodataBytes = 32 * 1024 * 1024; // .rodata scanned up to this size
+    static constexpr size_t kMaxPendingFiles = 64;               // Open descriptors held for queued files
+
+    ElfImportAnalyzer();
+    ~ElfImportAnalyzer();
+
+    // Capabilities of the process's executable; kCapabilityNone until analyzed.
+    // The first lookup of a file queues it.
+    unsigned Lookup(const ProcessInfo& process);
+
+    // Analyzes up to maxFiles queued files
+    void Advance(size_t maxFiles);
+
+    // Files queued for analysis
+    size_t PendingFiles();
+
+    // Drops per-pid entries for processes not in the list (sorted by pid); file
+    // results are kept since another process may run the same binary later
+    void Sweep(const std::vector<ProcessInfo>& processes);
+
+    // Parses an open ELF file
+    static ElfImportSummary Analyze(int fd, unsigned long long size);
+
+private:
+    ElfImportAnalyzer(const ElfImportAnalyzer&) = delete;
+    ElfImportAnalyzer& operator=(const ElfImportAnalyzer&) = delete;
+
+    struct PidEntry {
+        unsigned long long startTime = 0;
+        std::string path;
+        bool opened = false;
+        FileKey key;
+    };
+
+    struct Job {
+        FileKey key;
+        int fd = -1;
+    };
+
+    std::unordered_map<FileKey, unsigned, FileKeyHash> results_;
+    std::unordered_map<int, PidEntry> pids_;
+    std::vector<Job> jobs_; // FIFO
+
+    std::mutex mutex_;        // Guards everything above
+    std::mutex advanceMutex_; // One Advance at a time
+};
+
+#endif // ELF_IMPORTS_H
@@ -0,0 +1,304 @@
+#include "ExecutableHasher.h"
+#include "ProcessTable.h"
+#include "WorkStealingPool.h"
+#include <algorithm>
+#include <cstring>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdio>
+#endif
+
+ExecutableHasher::ExecutableHasher() : knownBadAllPreHashed_(true) {
+}
+
+ExecutableHasher::~ExecutableHasher() {
+#ifdef __linux__
+    for (auto& job : jobs_) {
+        if (job->fd >= 0) close(job->fd);
+    }
+#endif
+}
+
+void ExecutableHasher::SetKnownBad(const std::vector<KnownBadExecutable>& entries) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    knownBadBySha_.clear();
+    knownBadPreHashes_.clear();
+    knownBadAllPreHashed_ = true;
+
+    for (const auto& entry : entries) {
+        knownBadBySha_[std::string(entry.sha256.begin(), entry.sha256.end())] = entry.label;
+        if (entry.hasPreHash) {
+            knownBadPreHashes_[entry.preHash]++;
+        } else {
+            knownBadAllPreHashed_ = false;
+        }
+    }
+}
+
+uint64_t ExecutableHasher::PreHash(const uint8_t* head, size_t headLength, const uint8_t* tail, size_t tailLength,
+                                   uint64_t size) {
+    // Word-at-a-time multiply/xorshift; only needs to separate files, not resist attack
+    const uint64_t multiplier = 0x9E3779B97F4A7C15ULL;
+    uint64_t h = size * multiplier ^ 0xC2B2AE3D27D4EB4FULL;
+
+    auto mix = [&](const uint8_t* data, size_t length) {
+        size_t i = 0;
+        for (; i + 8 <= length; i += 8) {
+            uint64_t word;
+            memcpy(&word, data + i, sizeof(word));
+            h = (h ^ word) * multiplier;
+            h ^= h >> 29;
+        }
+        for (; i < length; i++) {
+            h = (h ^ data[i]) * multiplier;
+        }
+        h ^= h >> 32;
+    };
+
+    mix(head, headLength);
+    mix(tail, tailLength);
+    return h;
+}
+
+bool ExecutableHasher::HasJobLocked(const FileKey& key) const {
+    return std::any_of(jobs_.begin(), jobs_.end(), [&](const std::unique_ptr<Job>& job) { return job->key == key; });
+}
+
+ExecutableVerdict ExecutableHasher::VerdictLocked(const PidEntry& entry) const {
+    ExecutableVerdict verdict;
+    if (!entry.opened) {
+        return verdict;
+    }
+
+    auto digest = digests_.find(entry.key);
+    if (digest != digests_.end()) {
+        verdict.preHash = digest->second.preHash;
+        verdict.preHashed = true;
+        verdict.sha256 = Sha256::ToHex(digest->second.sha256);
+
+        auto bad = knownBadBySha_.find(std::string(digest->second.sha256.begin(), digest->second.sha256.end()));
+        if (bad != knownBadBySha_.end()) {
+            verdict.state = ExecutableVerdict::State::KnownBad;
+            verdict.label = bad->second;
+        } else {
+            verdict.state = ExecutableVerdict::State::Clean;
+        }
+        return verdict;
+    }
+
+    verdict.state = ExecutableVerdict::State::Pending;
+
+    // A pre-hash that matches no known-bad entry rules the file out early
+    auto preHash = preHashes_.find(entry.key);
+    if (preHash != preHashes_.end()) {
+        verdict.preHash = preHash->second;
+        verdict.preHashed = true;
+        if (knownBadAllPreHashed_ && knownBadPreHashes_.find(preHash->second) == knownBadPreHashes_.end()) {
+            verdict.state = ExecutableVerdict::State::Clean;
+        }
+    }
+    return verdict;
+}
+
+ExecutableVerdict ExecutableHasher::Lookup(const ProcessInfo& process) {
+#ifdef __linux__
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = pids_.find(process.pid);
+        if (it != pids_.end() && it->second.startTime == process.startTime && it->second.path == process.path) {
+            // Not opened, digested or queued: the queue was full last time; retry below
+            if (!it->second.opened || digests_.count(it->second.key) || HasJobLocked(it->second.key)) {
+                return VerdictLocked(it->second);
+            }
+        }
+    }
+
+    PidEntry entry;
+    entry.startTime = process.startTime;
+    entry.path = process.path;
+
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/%d/exe", process.pid);
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    struct stat fileStat;
+    if (fd >= 0 && fstat(fd, &fileStat) == 0 && S_ISREG(fileStat.st_mode)) {
+        entry.opened = true;
+        entry.key = FileKey::FromStat(fileStat);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    PidEntry& cached = pids_[process.pid];
+    cached = std::move(entry);
+
+    if (!cached.opened || digests_.count(cached.key) || HasJobLocked(cached.key) || jobs_.size() >= kMaxPendingFiles) {
+        if (fd >= 0) close(fd);
+        return VerdictLocked(cached);
+    }
+
+    std::unique_ptr<Job> job(new Job());
+    job->key = cached.key;
+    job->fd = fd;
+    job->ownerPid = process.pid;
+    job->ownerStartTime = process.startTime;
+    jobs_.push_back(std::move(job));
+    return VerdictLocked(cached);
+#else
+    (void)process;
+    return ExecutableVerdict();
+#endif
+}
+
+void ExecutableHasher::HashSlice(Job& job, uint64_t bytes) {
+#ifdef __linux__
+    uint64_t size = job.key.size;
+
+    if (!job.preHashed) {
+        static thread_local std::vector<uint8_t> window(2 * kPreHashWindow);
+        size_t headLength = static_cast<size_t>(std::min<uint64_t>(size, kPreHashWindow));
+        size_t tailLength = static_cast<size_t>(std::min<uint64_t>(size - headLength, kPreHashWindow));
+
+        if (pread(job.fd, window.data(), headLength, 0) != static_cast<ssize_t>(headLength) ||
+            pread(job.fd, window.data() + headLength, tailLength, static_cast<off_t>(size - tailLength)) !=
+                static_cast<ssize_t>(tailLength)) {
+            job.failed = true;
+            return;
+        }
+        job.preHash = PreHash(window.data(), headLength, window.data() + headLength, tailLength, size);
+        job.preHashed = true;
+        bytes -= std::min<uint64_t>(bytes, 2 * kPreHashWindow); // Charged by Advance
+    }
+
+    bytes = std::min<uint64_t>(bytes, size - job.offset);
+    if (bytes == 0) {
+        return;
+    }
+
+    // A shrunk file would SIGBUS through the mapping. Running executables are
+    // write-protected (ETXTBSY), so map only while the opener still runs it and
+    // the size is unchanged; otherwise stream with pread.
+    struct stat fileStat;
+    if (fstat(job.fd, &fileStat) != 0 || static_cast<uint64_t>(fileStat.st_size) != size) {
+        job.failed = true;
+        return;
+    }
+
+    unsigned long long ownerStartTime = 0;
+    bool canMap = ProcessTable::ReadStartTime(job.ownerPid, ownerStartTime) && ownerStartTime == job.ownerStartTime;
+
+    if (canMap) {
+        static const uint64_t pageSize = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+        uint64_t mapOffset = job.offset & ~(pageSize - 1);
+        size_t mapLength = static_cast<size_t>(job.offset + bytes - mapOffset);
+
+        void* mapping = mmap(nullptr, mapLength, PROT_READ, MAP_PRIVATE, job.fd, static_cast<off_t>(mapOffset));
+        if (mapping != MAP_FAILED) {
+            madvise(mapping, mapLength, MADV_SEQUENTIAL);
+            job.sha.Update(static_cast<const uint8_t*>(mapping) + (job.offset - mapOffset), static_cast<size_t>(bytes));
+            munmap(mapping, mapLength);
+            job.offset += bytes;
+            return;
+        }
+    }
+
+    static thread_local std::vector<uint8_t> buffer(1024 * 1024);
+    while (bytes > 0) {
+        size_t chunk = static_cast<size_t>(std::min<uint64_t>(bytes, buffer.size()));
+        ssize_t n = pread(job.fd, buffer.data(), chunk, static_cast<off_t>(job.offset));
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) {
+            job.failed = true;
+            return;
+        }
+        job.sha.Update(buffer.data(), static_cast<size_t>(n));
+        job.offset += static_cast<uint64_t>(n);
+        bytes -= static_cast<uint64_t>(n);
+    }
+#else
+    (void)job;
+    (void)bytes;
+#endif
+}
+
+void ExecutableHasher::Advance(size_t byteBudget) {
+#ifdef __linux__
+    std::lock_guard<std::mutex> advanceLock(advanceMutex_);
+
+    struct Slice {
+        Job* job;
+        uint64_t bytes;
+    };
+    std::vector<Slice> slices;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        uint64_t remaining = byteBudget;
+        for (auto& job : jobs_) {
+            if (remaining == 0) break;
+
+            // The pre-hash window is charged to the budget too
+            uint64_t cost = job->key.size - job->offset + (job->preHashed ? 0 : 2 * kPreHashWindow);
+            uint64_t take = std::min(cost, remaining);
+            slices.push_back({job.get(), take});
+            remaining -= take;
+        }
+    }
+
+    if (slices.empty()) {
+        return;
+    }
+
+    WorkStealingPool::Instance().ParallelFor(slices.size(), [&](size_t index) {
+        HashSlice(*slices[index].job, slices[index].bytes);
+    });
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = jobs_.begin(); it != jobs_.end();) {
+        Job& job = **it;
+        bool complete = job.preHashed && job.offset >= job.key.size;
+        if (!job.failed && !complete) {
+            if (job.preHashed) {
+                preHashes_[job.key] = job.preHash;
+            }
+            ++it;
+            continue;
+        }
+
+        if (complete && !job.failed) {
+            Digest digest;
+            digest.preHash = job.preHash;
+            digest.sha256 = job.sha.Finish();
+            digests_[job.key] = digest;
+        }
+        preHashes_.erase(job.key);
+        close(job.fd);
+        it = jobs_.erase(it);
+    }
+#else
+    (void)byteBudget;
+#endif
+}
+
+size_t ExecutableHasher::PendingFiles() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return jobs_.size();
+}
+
+void ExecutableHasher::Sweep(const std::vector<ProcessInfo>& processes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    for (auto it = pids_.begin(); it != pids_.end();) {
+        auto listed = std::lower_bound(processes.begin(), processes.end(), it->first,
+                                       [](const ProcessInfo& process, int pid) { return process.pid < pid; });
+        if (listed == processes.end() || listed->pid != it->first || listed->startTime != it->second.startTime) {
+            it = pids_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
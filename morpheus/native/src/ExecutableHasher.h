@@ -0,0 +1,117 @@
+#ifndef EXECUTABLE_HASHER_H
+#define EXECUTABLE_HASHER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "CommonTypes.h"
+#include "FileKey.h"
+#include "Sha256.h"
+
+struct KnownBadExecutable {
+    Sha256::Digest sha256{};
+    uint64_t preHash = 0;
+    bool hasPreHash = false; // Lets a mismatching pre-hash clear a file before its SHA-256 is done
+    std::string label;
+};
+
+struct ExecutableVerdict {
+    enum class State {
+        Unavailable, // Executable could not be opened (exited, or no access)
+        Pending,     // Queued or partially hashed
+        Clean,
+        KnownBad
+    };
+
+    State state = State::Unavailable;
+    std::string label;     // KnownBad only
+    std::string sha256;    // Hex, once complete
+    uint64_t preHash = 0;
+    bool preHashed = false;
+};
+
+// Content hashes of process executables, so a renamed binary is still
+// recognised. Each file is opened through /proc/<pid>/exe (which survives
+// deletion and renames), keyed by (device, inode, mtime, size) and hashed once
+// per boot no matter how many processes run it. Hashing happens in Advance()
+// on the analysis pool, a byte budget at a time; a file larger than the budget
+// is continued on the next call. Linux only; other platforms report
+// Unavailable.
+class ExecutableHasher {
+public:
+    static constexpr size_t kPreHashWindow = 64 * 1024; // Head and tail bytes in the pre-hash
+    static constexpr size_t kMaxPendingFiles = 64;       // Open descriptors held for queued files
+
+    ExecutableHasher();
+    ~ExecutableHasher();
+
+    void SetKnownBad(const std::vector<KnownBadExecutable>& entries);
+
+    // Verdict for the process's executable; the first lookup of a file queues it
+    ExecutableVerdict Lookup(const ProcessInfo& process);
+
+    // Hashes up to byteBudget bytes of queued files
+    void Advance(size_t byteBudget);
+
+    // Files queued or partly hashed
+    size_t PendingFiles();
+
+    // Drops per-pid entries for processes not in the list (sorted by pid); file
+    // digests are kept since another process may run the same binary later
+    void Sweep(const std::vector<ProcessInfo>& processes);
+
+    // 64-bit hash of the file size plus its first and last kPreHashWindow bytes
+    static uint64_t PreHash(const uint8_t* head, size_t headLength, const uint8_t* tail, size_t tailLength,
+                            uint64_t size);
+
+private:
+    ExecutableHasher(const ExecutableHasher&) = delete;
+    ExecutableHasher& operator=(const ExecutableHasher&) = delete;
+
+    struct Digest {
+        uint64_t preHash = 0;
+        Sha256::Digest sha256{};
+    };
+
+    struct Job {
+        FileKey key;
+        int fd = -1;
+        int ownerPid = 0;                       // mmap only while a process still runs the file
+        unsigned long long ownerStartTime = 0;
+        uint64_t offset = 0;
+        bool preHashed = false;
+        uint64_t preHash = 0;
+        bool failed = false;
+        Sha256 sha;
+    };
+
+    struct PidEntry {
+        unsigned long long startTime = 0;
+        std::string path;
+        bool opened = false; // False if /proc/<pid>/exe could not be opened
+        FileKey key;
+    };
+
+    ExecutableVerdict VerdictLocked(const PidEntry& entry) const;
+    bool HasJobLocked(const FileKey& key) const;
+    static void HashSlice(Job& job, uint64_t bytes);
+
+    std::unordered_map<FileKey, Digest, FileKeyHash> digests_;
+    std::unordered_map<FileKey, uint64_t, FileKeyHash> preHashes_; // Files still being hashed
+    std::unordered_map<int, PidEntry> pids_;
+    std::vector<std::unique_ptr<Job>> jobs_; // FIFO; Job objects stay put while Advance hashes them
+
+    std::unordered_map<std::string, std::string> knownBadBySha_; // Raw digest bytes -> label
+    std::unordered_map<uint64_t, int> knownBadPreHashes_;
+    bool knownBadAllPreHashed_;
+
+    std::mutex mutex_;        // Guards everything above
+    std::mutex advanceMutex_; // One Advance at a time; only Advance mutates or removes jobs
+};
+
+#endif // EXECUTABLE_HASHER_H
@@ -0,0 +1,245 @@
+#include "FdInventory.h"
+#include <algorithm>
+#include <cstring>
+
+#ifdef __linux__
+#include <dirent.h>
+#include <fcntl.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <linux/sock_diag.h>
+#include <linux/unix_diag.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+
+// Looks up one AF_UNIX socket by inode through NETLINK_SOCK_DIAG. Returns false
+// if the socket is gone; name is empty for unbound sockets.
+static bool QueryUnixSocket(unsigned inode, unsigned& peerInode, std::string& name) {
+    int fd = socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC, NETLINK_SOCK_DIAG);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct {
+        struct nlmsghdr header;
+        struct unix_diag_req request;
+    } message;
+    memset(&message, 0, sizeof(message));
+    message.header.nlmsg_len = sizeof(message);
+    message.header.nlmsg_type = SOCK_DIAG_BY_FAMILY;
+    message.header.nlmsg_flags = NLM_F_REQUEST;
+    message.request.sdiag_family = AF_UNIX;
+    message.request.udiag_states = ~0U;
+    message.request.udiag_ino = inode;
+    message.request.udiag_show = UDIAG_SHOW_NAME | UDIAG_SHOW_PEER;
+    message.request.udiag_cookie[0] = ~0U;
+    message.request.udiag_cookie[1] = ~0U;
+
+    struct sockaddr_nl kernel;
+    memset(&kernel, 0, sizeof(kernel));
+    kernel.nl_family = AF_NETLINK;
+
+    if (sendto(fd, &message, sizeof(message), 0, reinterpret_cast<struct sockaddr*>(&kernel), sizeof(kernel)) < 0) {
+        close(fd);
+        return false;
+    }
+
+    char buffer[8192];
+    ssize_t received;
+    do {
+        received = recv(fd, buffer, sizeof(buffer), 0);
+    } while (received < 0 && errno == EINTR);
+    close(fd);
+
+    bool found = false;
+    peerInode = 0;
+    name.clear();
+
+    int remaining = static_cast<int>(received);
+    for (struct nlmsghdr* header = reinterpret_cast<struct nlmsghdr*>(buffer);
+         received > 0 && NLMSG_OK(header, remaining); header = NLMSG_NEXT(header, remaining)) {
+        if (header->nlmsg_type != SOCK_DIAG_BY_FAMILY) break; // NLMSG_ERROR: not found
+
+        struct unix_diag_msg* diag = static_cast<struct unix_diag_msg*>(NLMSG_DATA(header));
+        int attributesLength = static_cast<int>(header->nlmsg_len - NLMSG_LENGTH(sizeof(*diag)));
+        for (struct rtattr* attribute = reinterpret_cast<struct rtattr*>(diag + 1);
+             RTA_OK(attribute, attributesLength); attribute = RTA_NEXT(attribute, attributesLength)) {
+            if (attribute->rta_type == UNIX_DIAG_PEER) {
+                memcpy(&peerInode, RTA_DATA(attribute), sizeof(peerInode));
+            } else if (attribute->rta_type == UNIX_DIAG_NAME) {
+                const char* path = static_cast<const char*>(RTA_DATA(attribute));
+                size_t length = RTA_PAYLOAD(attribute);
+                if (length > 0 && path[0] == '\0') {
+                    name.assign("@").append(path + 1, length - 1); // Abstract namespace
+                } else {
+                    name.assign(path, strnlen(path, length));
+                }
+            }
+        }
+        found = true;
+    }
+
+    return found;
+}
+
+// "socket:[1234]" -> the path the peer is bound to, e.g. /run/user/1000/pipewire-0.
+// Client sockets are unnamed; the accepting end carries the listener's address.
+static std::string ResolveUnixPeerPath(unsigned long long inode) {
+    unsigned peerInode = 0;
+    std::string name;
+    if (!QueryUnixSocket(static_cast<unsigned>(inode), peerInode, name)) {
+        return "";
+    }
+    if (!name.empty() || peerInode == 0) {
+        return name;
+    }
+
+    unsigned ignoredPeer = 0;
+    QueryUnixSocket(peerInode, ignoredPeer, name);
+    return name;
+}
+#endif
+
+const char* FdInventory::ClassName(unsigned handleClass) {
+    switch (handleClass) {
+        case kFdHandleCapture: return "capture";
+        case kFdHandleCamera: return "camera";
+        case kFdHandleInputInjection: return "input-injection";
+        default: return "none";
+    }
+}
+
+unsigned FdInventory::Classify(const std::string& target) {
+    auto startsWith = [&](const char* prefix) { return target.compare(0, strlen(prefix), prefix) == 0; };
+
+    if (startsWith("/dev/video") || startsWith("/dev/media") || startsWith("/dev/v4l/")) {
+        return kFdHandleCamera;
+    }
+    if (startsWith("/dev/dri/renderD")) {
+        return kFdHandleCapture;
+    }
+    if (target == "/dev/uinput" || target == "/dev/input/uinput") {
+        return kFdHandleInputInjection;
+    }
+
+    // Native PipeWire clients (screencast portal streams, OBS); the PulseAudio
+    // compatibility socket is pulse/native and is not matched
+    size_t slash = target.find_last_of('/');
+    std::string base = slash == std::string::npos ? target : target.substr(slash + 1);
+    if (base.compare(0, 9, "pipewire-") == 0 && base.find(".lock") == std::string::npos) {
+        return kFdHandleCapture;
+    }
+
+    return kFdHandleNone;
+}
+
+FdHandleSummary FdInventory::Scan(int pid, unsigned long long startTime) {
+    FdHandleSummary summary;
+
+#ifdef __linux__
+    // Take this process's entry out of the cache for the walk so the lock is not
+    // held across syscalls; each pid is scanned by one worker at a time
+    Entry previous;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = cache_.find(pid);
+        if (it != cache_.end()) {
+            if (it->second.startTime == startTime) {
+                previous = std::move(it->second);
+            }
+            cache_.erase(it);
+        }
+    }
+
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/%d/fd", pid);
+    DIR* fdDir = opendir(path);
+    if (!fdDir) {
+        return summary; // Exited, or no ptrace access to its fd table
+    }
+
+    Entry current;
+    current.startTime = startTime;
+    current.handles.reserve(previous.handles.size());
+
+    int dirFd = dirfd(fdDir);
+    struct dirent* dirEntry;
+    while ((dirEntry = readdir(fdDir)) != nullptr) {
+        if (dirEntry->d_name[0] < '0' || dirEntry->d_name[0] > '9') continue;
+        int fd = atoi(dirEntry->d_name);
+
+        // stat follows the link to the open file itself
+        struct stat fileStat;
+        if (fstatat(dirFd, dirEntry->d_name, &fileStat, 0) != 0) continue;
+
+        unsigned long long device = S_ISCHR(fileStat.st_mode) ? fileStat.st_rdev : fileStat.st_dev;
+        unsigned long long inode = fileStat.st_ino;
+
+        auto cached = previous.handles.find(fd);
+        if (cached != previous.handles.end() && cached->second.device == device && cached->second.inode == inode) {
+            current.handles.emplace(fd, std::move(cached->second));
+            continue;
+        }
+
+        Handle handle;
+        handle.device = device;
+        handle.inode = inode;
+
+        // Regular files, pipes and anonymous inodes never classify; skip readlink
+        if (S_ISSOCK(fileStat.st_mode)) {
+            handle.target = ResolveUnixPeerPath(inode); // Empty for non-unix sockets
+        } else if (S_ISCHR(fileStat.st_mode)) {
+            char target[512];
+            ssize_t length = readlinkat(dirFd, dirEntry->d_name, target, sizeof(target) - 1);
+            if (length > 0) {
+                handle.target.assign(target, static_cast<size_t>(length));
+            }
+        }
+        if (!handle.target.empty()) {
+            handle.handleClass = Classify(handle.target);
+        }
+
+        current.handles.emplace(fd, std::move(handle));
+    }
+    closedir(fdDir);
+
+    for (const auto& item : current.handles) {
+        const Handle& handle = item.second;
+        if (handle.handleClass == kFdHandleNone) continue;
+
+        summary.classes |= handle.handleClass;
+        std::string description = std::string(ClassName(handle.handleClass)) + ":" + handle.target;
+        if (std::find(summary.handles.begin(), summary.handles.end(), description) == summary.handles.end()) {
+            summary.handles.push_back(std::move(description));
+        }
+    }
+    std::sort(summary.handles.begin(), summary.handles.end());
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    cache_[pid] = std::move(current);
+#else
+    (void)pid;
+    (void)startTime;
+#endif
+
+    return summary;
+}
+
+void FdInventory::Sweep(const std::vector<ProcessInfo>& processes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    for (auto it = cache_.begin(); it != cache_.end();) {
+        auto listed = std::lower_bound(processes.begin(), processes.end(), it->first,
+                                       [](const ProcessInfo& process, int pid) { return process.pid < pid; });
+        if (listed == processes.end() || listed->pid != it->first || listed->startTime != it->second.startTime) {
+            it = cache_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
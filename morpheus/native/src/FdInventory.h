@@ -0,0 +1,57 @@
+#ifndef FD_INVENTORY_H
+#define FD_INVENTORY_H
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "CommonTypes.h"
+
+// Classes of open descriptors that show capture or injection capability
+enum FdHandleClass : unsigned {
+    kFdHandleNone = 0,
+    kFdHandleCapture = 1 << 0,        // PipeWire socket, DRM render node
+    kFdHandleCamera = 1 << 1,         // V4L2 video/media devices
+    kFdHandleInputInjection = 1 << 2  // uinput
+};
+
+struct FdHandleSummary {
+    unsigned classes = kFdHandleNone;
+    std::vector<std::string> handles; // "<class>:<target>", deduplicated, e.g. "camera:/dev/video0"
+};
+
+// Open descriptors of a process, read from /proc/<pid>/fd on Linux. Only the
+// processes passed in are walked; each descriptor is fstat'ed and readlink (plus
+// the socket peer lookup for sockets) only runs when its (fd, device, inode)
+// differs from the previous walk of the same (pid, start time). Other platforms
+// get an empty summary.
+class FdInventory {
+public:
+    FdHandleSummary Scan(int pid, unsigned long long startTime);
+
+    // Drops entries for processes not in the list (sorted by pid)
+    void Sweep(const std::vector<ProcessInfo>& processes);
+
+    static const char* ClassName(unsigned handleClass);
+
+private:
+    struct Handle {
+        unsigned long long device = 0;
+        unsigned long long inode = 0;
+        unsigned handleClass = kFdHandleNone;
+        std::string target;
+    };
+
+    struct Entry {
+        unsigned long long startTime = 0;
+        std::unordered_map<int, Handle> handles; // By fd number
+    };
+
+    static unsigned Classify(const std::string& target);
+
+    std::unordered_map<int, Entry> cache_;
+    std::mutex mutex_;
+};
+
+#endif // FD_INVENTORY_H
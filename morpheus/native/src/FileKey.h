@@ -0,0 +1,49 @@
+#ifndef FILE_KEY_H
+#define FILE_KEY_H
+
+#include <cstddef>
+#include <cstdint>
+
+#ifdef __linux__
+#include <sys/stat.h>
+#endif
+
+// Identity of a file's contents: the same (device, inode) with unchanged mtime
+// and size is assumed to hold the same bytes, so per-file results can be
+// cached across processes and renames
+struct FileKey {
+    unsigned long long device = 0;
+    unsigned long long inode = 0;
+    long long mtimeSec = 0;
+    long long mtimeNsec = 0;
+    unsigned long long size = 0;
+
+    bool operator==(const FileKey& other) const {
+        return device == other.device && inode == other.inode && mtimeSec == other.mtimeSec &&
+               mtimeNsec == other.mtimeNsec && size == other.size;
+    }
+
+#ifdef __linux__
+    static FileKey FromStat(const struct stat& fileStat) {
+        FileKey key;
+        key.device = fileStat.st_dev;
+        key.inode = fileStat.st_ino;
+        key.mtimeSec = fileStat.st_mtim.tv_sec;
+        key.mtimeNsec = fileStat.st_mtim.tv_nsec;
+        key.size = static_cast<unsigned long long>(fileStat.st_size);
+        return key;
+    }
+#endif
+};
+
+struct FileKeyHash {
+    size_t operator()(const FileKey& key) const {
+        uint64_t h = key.inode * 0x9E3779B97F4A7C15ULL;
+        h ^= key.device + 0x632BE59BD9B4E019ULL + (h << 6) + (h >> 2);
+        h ^= static_cast<uint64_t>(key.mtimeSec) + (h << 6) + (h >> 2);
+        h ^= key.size + (h << 6) + (h >> 2);
+        return static_cast<size_t>(h);
+    }
+};
+
+#endif // FILE_KEY_H
@@ -0,0 +1,138 @@
+#include "FlowRates.h"
+#include <algorithm>
+#include <cmath>
+
+FlowRateEstimator::FlowRateEstimator() : slots_(kTableSize), size_(0) {
+}
+
+size_t FlowRateEstimator::Home(uint64_t flowId) {
+    // Fibonacci hashing; inodes are sequential, so the low bits alone cluster
+    return static_cast<size_t>((flowId * 0x9E3779B97F4A7C15ULL) >> 32) & (kTableSize - 1);
+}
+
+FlowRates FlowRateEstimator::RatesOf(const Slot& slot) {
+    FlowRates rates;
+    rates.uploadBitsPerSecond = slot.uploadEwma;
+    rates.downloadBitsPerSecond = slot.downloadEwma;
+    rates.samples = slot.ringCount;
+    if (slot.ringCount == 0) {
+        return rates;
+    }
+
+    double sum = 0.0;
+    double minimum = slot.uploadRing[0];
+    for (size_t i = 0; i < slot.ringCount; i++) {
+        sum += slot.uploadRing[i];
+        minimum = std::min(minimum, static_cast<double>(slot.uploadRing[i]));
+    }
+    double mean = sum / slot.ringCount;
+
+    if (mean > 0.0) {
+        double variance = 0.0;
+        for (size_t i = 0; i < slot.ringCount; i++) {
+            double delta = slot.uploadRing[i] - mean;
+            variance += delta * delta;
+        }
+        rates.burstiness = std::sqrt(variance / slot.ringCount) / mean;
+    }
+    if (slot.ringCount >= kSustainedSamples) {
+        rates.sustainedUploadBitsPerSecond = minimum;
+    }
+    return rates;
+}
+
+FlowRates FlowRateEstimator::Update(uint64_t flowId, uint64_t nowMs, uint64_t sentBytes, uint64_t receivedBytes) {
+    if (flowId == 0) {
+        return FlowRates();
+    }
+
+    size_t index = Home(flowId);
+    while (slots_[index].flowId != 0 && slots_[index].flowId != flowId) {
+        index = (index + 1) & (kTableSize - 1);
+    }
+
+    Slot& slot = slots_[index];
+    if (slot.flowId == 0) {
+        if (size_ >= kCapacity) {
+            return FlowRates();
+        }
+        slot = Slot();
+        slot.flowId = flowId;
+        slot.lastSeenMs = nowMs;
+        slot.sampleMs = nowMs;
+        slot.sentBytes = sentBytes;
+        slot.receivedBytes = receivedBytes;
+        size_++;
+        return FlowRates();
+    }
+
+    slot.lastSeenMs = nowMs;
+
+    // Counters only grow; a drop means the id now names another flow
+    if (sentBytes < slot.sentBytes || receivedBytes < slot.receivedBytes) {
+        uint64_t id = slot.flowId;
+        slot = Slot();
+        slot.flowId = id;
+        slot.lastSeenMs = nowMs;
+        slot.sampleMs = nowMs;
+        slot.sentBytes = sentBytes;
+        slot.receivedBytes = receivedBytes;
+        return FlowRates();
+    }
+
+    uint64_t elapsedMs = nowMs - slot.sampleMs;
+    if (elapsedMs < kMinIntervalMs) {
+        return RatesOf(slot);
+    }
+
+    double seconds = elapsedMs / 1000.0;
+    double upload = (sentBytes - slot.sentBytes) * 8.0 / seconds;
+    double download = (receivedBytes - slot.receivedBytes) * 8.0 / seconds;
+
+    if (slot.ringCount == 0) {
+        slot.uploadEwma = upload;
+        slot.downloadEwma = download;
+    } else {
+        // Weight by elapsed time so irregular polling does not skew the average
+        double alpha = 1.0 - std::exp(-static_cast<double>(elapsedMs) / kEwmaTimeConstantMs);
+        slot.uploadEwma += alpha * (upload - slot.uploadEwma);
+        slot.downloadEwma += alpha * (download - slot.downloadEwma);
+    }
+
+    slot.uploadRing[slot.ringHead] = static_cast<float>(upload);
+    slot.ringHead = static_cast<uint8_t>((slot.ringHead + 1) % kRingSize);
+    if (slot.ringCount < kRingSize) slot.ringCount++;
+
+    slot.sampleMs = nowMs;
+    slot.sentBytes = sentBytes;
+    slot.receivedBytes = receivedBytes;
+    return RatesOf(slot);
+}
+
+void FlowRateEstimator::Erase(size_t index) {
+    // Backward-shift deletion keeps every probe chain unbroken without tombstones
+    size_t hole = index;
+    size_t next = (hole + 1) & (kTableSize - 1);
+    while (slots_[next].flowId != 0) {
+        size_t home = Home(slots_[next].flowId);
+        // Move the entry back if its home is not cyclically inside (hole, next]
+        bool movable = (next > hole) ? (home <= hole || home > next) : (home <= hole && home > next);
+        if (movable) {
+            slots_[hole] = slots_[next];
+            hole = next;
+        }
+        next = (next + 1) & (kTableSize - 1);
+    }
+    slots_[hole].flowId = 0;
+    size_--;
+}
+
+void FlowRateEstimator::Expire(uint64_t cutoffMs) {
+    for (size_t i = 0; i < kTableSize;) {
+        if (slots_[i].flowId != 0 && slots_[i].lastSeenMs < cutoffMs) {
+            Erase(i); // May shift a later entry into i; check it again
+        } else {
+            i++;
+        }
+    }
+}
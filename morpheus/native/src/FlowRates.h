@@ -0,0 +1,64 @@
+#ifndef FLOW_RATES_H
+#define FLOW_RATES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Rates of one flow, from the intervals between its counter samples
+struct FlowRates {
+    double uploadBitsPerSecond = 0.0;   // EWMA
+    double downloadBitsPerSecond = 0.0; // EWMA
+    double burstiness = 0.0;            // Coefficient of variation of the upload rates in the ring
+    double sustainedUploadBitsPerSecond = 0.0; // Lowest upload rate in the ring once it holds kSustainedSamples, else 0
+    int samples = 0;                    // Intervals in the ring
+};
+
+// Streaming rate statistics for up to kCapacity flows, fed with cumulative byte
+// counters (e.g. tcpi_bytes_acked / tcpi_bytes_received). Each flow keeps a
+// fixed ring of per-interval upload rates plus exponentially weighted upload
+// and download rates. The table is an open-addressed array allocated once, so
+// Update and Expire never allocate; flows beyond kCapacity are not tracked
+// until others expire.
+class FlowRateEstimator {
+public:
+    static constexpr size_t kTableSize = 8192;          // Power of two
+    static constexpr size_t kCapacity = kTableSize * 3 / 4;
+    static constexpr size_t kRingSize = 16;
+    static constexpr int kSustainedSamples = 5;
+    static constexpr uint64_t kMinIntervalMs = 200;     // Closer samples are folded into the next interval
+    static constexpr double kEwmaTimeConstantMs = 5000.0;
+
+    FlowRateEstimator();
+
+    // flowId must be non-zero and stable for the flow's lifetime (a socket inode)
+    FlowRates Update(uint64_t flowId, uint64_t nowMs, uint64_t sentBytes, uint64_t receivedBytes);
+
+    // Forgets flows last updated before cutoffMs
+    void Expire(uint64_t cutoffMs);
+
+    size_t Size() const { return size_; }
+
+private:
+    struct Slot {
+        uint64_t flowId = 0; // 0 = empty
+        uint64_t lastSeenMs = 0;
+        uint64_t sampleMs = 0;
+        uint64_t sentBytes = 0;
+        uint64_t receivedBytes = 0;
+        double uploadEwma = 0.0;
+        double downloadEwma = 0.0;
+        float uploadRing[kRingSize];
+        uint8_t ringHead = 0;
+        uint8_t ringCount = 0;
+    };
+
+    static size_t Home(uint64_t flowId);
+    static FlowRates RatesOf(const Slot& slot);
+    void Erase(size_t index);
+
+    std::vector<Slot> slots_;
+    size_t size_;
+};
+
+#endif // FLOW_RATES_H
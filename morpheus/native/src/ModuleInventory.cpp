@@ -0,0 +1,159 @@
+#include "ModuleInventory.h"
+#include <algorithm>
+#include <cstring>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#endif
+
+std::vector<std::string> ModuleInventory::Modules(int pid, unsigned long long startTime) {
+#ifdef __linux__
+    // /proc/<pid>/maps always reports size 0, so the total mapped size from statm
+    // stands in for "the maps file changed"
+    unsigned long long mappedPages = 0;
+    if (!ReadMappedPages(pid, mappedPages)) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        cache_.erase(pid);
+        return {};
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = cache_.find(pid);
+        if (it != cache_.end() && it->second.startTime == startTime && it->second.mappedPages == mappedPages) {
+            return it->second.modules;
+        }
+    }
+
+    Entry entry;
+    entry.startTime = startTime;
+    entry.mappedPages = mappedPages;
+    bool readOk = ReadMaps(pid, entry.modules);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!readOk) {
+        cache_.erase(pid);
+        return {};
+    }
+
+    auto& cached = cache_[pid];
+    cached = std::move(entry);
+    return cached.modules;
+#else
+    (void)pid;
+    (void)startTime;
+    return {};
+#endif
+}
+
+void ModuleInventory::Sweep(const std::vector<ProcessInfo>& processes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    for (auto it = cache_.begin(); it != cache_.end();) {
+        auto listed = std::lower_bound(processes.begin(), processes.end(), it->first,
+                                       [](const ProcessInfo& process, int pid) { return process.pid < pid; });
+        if (listed == processes.end() || listed->pid != it->first || listed->startTime != it->second.startTime) {
+            it = cache_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+#ifdef __linux__
+bool ModuleInventory::ReadMappedPages(int pid, unsigned long long& pages) {
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/%d/statm", pid);
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+
+    char statm[128];
+    ssize_t n = read(fd, statm, sizeof(statm) - 1);
+    close(fd);
+    if (n <= 0) {
+        return false;
+    }
+    statm[n] = '\0';
+
+    pages = strtoull(statm, nullptr, 10);
+    return true;
+}
+
+bool ModuleInventory::ReadMaps(int pid, std::vector<std::string>& modules) {
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/%d/maps", pid);
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+
+    // Reused across reads on this thread; grows to the largest maps file seen
+    static thread_local std::vector<char> buffer;
+    if (buffer.empty()) {
+        buffer.resize(64 * 1024);
+    }
+
+    size_t total = 0;
+    while (true) {
+        if (total == buffer.size()) {
+            buffer.resize(buffer.size() * 2);
+        }
+        ssize_t n = read(fd, buffer.data() + total, buffer.size() - total);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            close(fd);
+            return false;
+        }
+        if (n == 0) break;
+        total += static_cast<size_t>(n);
+    }
+    close(fd);
+
+    // Each line is "start-end perms offset dev inode   pathname"; the first '/'
+    // on a line starts the pathname since none of the other fields contain one
+    static const char deletedSuffix[] = " (deleted)";
+    static const size_t deletedLength = sizeof(deletedSuffix) - 1;
+
+    const char* cursor = buffer.data();
+    const char* end = cursor + total;
+    while (cursor < end) {
+        const char* lineEnd = static_cast<const char*>(memchr(cursor, '\n', end - cursor));
+        if (!lineEnd) lineEnd = end;
+
+        const char* slash = static_cast<const char*>(memchr(cursor, '/', lineEnd - cursor));
+        if (slash) {
+            size_t length = static_cast<size_t>(lineEnd - slash);
+            if (length > deletedLength && memcmp(lineEnd - deletedLength, deletedSuffix, deletedLength) == 0) {
+                length -= deletedLength;
+            }
+
+            // Consecutive mappings of one file (text, data, bss) are the common case
+            if (modules.empty() || modules.back().compare(0, std::string::npos, slash, length) != 0) {
+                modules.emplace_back(slash, length);
+            }
+        }
+
+        cursor = lineEnd + 1;
+    }
+
+    std::sort(modules.begin(), modules.end());
+    modules.erase(std::unique(modules.begin(), modules.end()), modules.end());
+    return true;
+}
+#else
+bool ModuleInventory::ReadMappedPages(int, unsigned long long&) {
+    return false;
+}
+
+bool ModuleInventory::ReadMaps(int, std::vector<std::string>&) {
+    return false;
+}
+#endif
@@ -0,0 +1,39 @@
+#ifndef MODULE_INVENTORY_H
+#define MODULE_INVENTORY_H
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "CommonTypes.h"
+
+// Files mapped into each process, read from /proc/<pid>/maps on Linux. Results
+// are cached per (pid, start time) and re-read only when the process is new or
+// its mapped size changes. Other platforms keep their own module enumeration
+// and get an empty list here.
+class ModuleInventory {
+public:
+    // Deduplicated, sorted mapped file paths
+    std::vector<std::string> Modules(int pid, unsigned long long startTime);
+
+    // Drops entries for processes not in the list (sorted by pid)
+    void Sweep(const std::vector<ProcessInfo>& processes);
+
+private:
+    struct Entry {
+        unsigned long long startTime = 0;
+        unsigned long long mappedPages = 0;
+        std::vector<std::string> modules;
+    };
+
+    bool ReadMappedPages(int pid, unsigned long long& pages);
+    bool ReadMaps(int pid, std::vector<std::string>& modules);
+
+    // Only guards the cache; maps files are read outside it (into a per-thread
+    // buffer) so parallel analysis of different processes does not serialize
+    std::unordered_map<int, Entry> cache_;
+    std::mutex mutex_;
+};
+
+#endif // MODULE_INVENTORY_H
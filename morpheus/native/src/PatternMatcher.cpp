@@ -0,0 +1,119 @@
+#include "PatternMatcher.h"
+#include <cctype>
+#include <cstring>
+#include <queue>
+
+PatternMatcher::PatternMatcher(bool caseInsensitive)
+    : caseInsensitive_(caseInsensitive), compiled_(false), classCount_(1) {
+    std::memset(byteClass_, 0, sizeof(byteClass_));
+}
+
+void PatternMatcher::Add(const std::string& pattern, int ruleId) {
+    if (pattern.empty()) {
+        return;
+    }
+
+    Pattern entry{pattern, ruleId, pattern.size()};
+    if (caseInsensitive_) {
+        for (auto& c : entry.text) {
+            c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+    }
+
+    patterns_.push_back(std::move(entry));
+    compiled_ = false;
+}
+
+void PatternMatcher::Compile() {
+    // Assign a class to every byte used by a pattern; upper and lower case share
+    // one class when matching case-insensitively
+    std::memset(byteClass_, 0, sizeof(byteClass_));
+    classCount_ = 1;
+    for (const auto& pattern : patterns_) {
+        for (unsigned char c : pattern.text) {
+            if (byteClass_[c] != 0) continue;
+            byteClass_[c] = static_cast<uint16_t>(classCount_);
+            if (caseInsensitive_ && std::isalpha(c)) {
+                byteClass_[std::toupper(c)] = static_cast<uint16_t>(classCount_);
+            }
+            classCount_++;
+        }
+    }
+
+    // Trie
+    delta_.assign(classCount_, -1);
+    std::vector<std::vector<uint32_t>> stateOutputs(1);
+    for (uint32_t p = 0; p < patterns_.size(); p++) {
+        int32_t state = 0;
+        for (unsigned char c : patterns_[p].text) {
+            size_t slot = static_cast<size_t>(state) * classCount_ + byteClass_[c];
+            if (delta_[slot] < 0) {
+                int32_t next = static_cast<int32_t>(stateOutputs.size());
+                stateOutputs.emplace_back();
+                delta_.resize(delta_.size() + classCount_, -1);
+                delta_[slot] = next;
+            }
+            state = delta_[slot];
+        }
+        stateOutputs[state].push_back(p);
+    }
+
+    // Fail links in BFS order; missing transitions are filled from the fail state
+    // so the scan loop never has to follow links
+    std::vector<int32_t> fail(stateOutputs.size(), 0);
+    std::queue<int32_t> pending;
+    for (size_t c = 0; c < classCount_; c++) {
+        int32_t next = delta_[c];
+        if (next < 0) {
+            delta_[c] = 0;
+        } else {
+            fail[next] = 0;
+            pending.push(next);
+        }
+    }
+
+    while (!pending.empty()) {
+        int32_t state = pending.front();
+        pending.pop();
+
+        const auto& inherited = stateOutputs[fail[state]];
+        stateOutputs[state].insert(stateOutputs[state].end(), inherited.begin(), inherited.end());
+
+        for (size_t c = 0; c < classCount_; c++) {
+            size_t slot = static_cast<size_t>(state) * classCount_ + c;
+            int32_t fallback = delta_[static_cast<size_t>(fail[state]) * classCount_ + c];
+            if (delta_[slot] < 0) {
+                delta_[slot] = fallback;
+            } else {
+                fail[delta_[slot]] = fallback;
+                pending.push(delta_[slot]);
+            }
+        }
+    }
+
+    outputStart_.assign(stateOutputs.size() + 1, 0);
+    outputs_.clear();
+    for (size_t s = 0; s < stateOutputs.size(); s++) {
+        outputStart_[s] = static_cast<uint32_t>(outputs_.size());
+        outputs_.insert(outputs_.end(), stateOutputs[s].begin(), stateOutputs[s].end());
+    }
+    outputStart_[stateOutputs.size()] = static_cast<uint32_t>(outputs_.size());
+
+    compiled_ = true;
+}
+
+bool PatternMatcher::Contains(const char* text, size_t length) const {
+    if (!compiled_ || patterns_.empty()) {
+        return false;
+    }
+
+    int32_t state = 0;
+    for (size_t i = 0; i < length; i++) {
+        state = delta_[static_cast<size_t>(state) * classCount_ +
+                       byteClass_[static_cast<unsigned char>(text[i])]];
+        if (outputStart_[state] != outputStart_[state + 1]) {
+            return true;
+        }
+    }
+    return false;
+}
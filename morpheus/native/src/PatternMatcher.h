@@ -0,0 +1,85 @@
+#ifndef PATTERN_MATCHER_H
+#define PATTERN_MATCHER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Aho-Corasick automaton over a set of literal patterns. Patterns are added, then
+// compiled once into a dense transition table over byte classes, so scanning a
+// string costs one table lookup per byte regardless of how many patterns exist.
+// A compiled matcher is immutable and safe to share between threads.
+class PatternMatcher {
+public:
+    explicit PatternMatcher(bool caseInsensitive = false);
+
+    // ruleId is reported back on every match of this pattern. Empty patterns are ignored.
+    void Add(const std::string& pattern, int ruleId);
+    void Compile();
+
+    // Calls onMatch(ruleId, start, end) for every occurrence, end exclusive
+    template <typename Callback>
+    void Scan(const char* text, size_t length, Callback&& onMatch) const {
+        if (!compiled_ || patterns_.empty()) return;
+
+        int32_t state = 0;
+        for (size_t i = 0; i < length; i++) {
+            state = delta_[static_cast<size_t>(state) * classCount_ +
+                           byteClass_[static_cast<unsigned char>(text[i])]];
+            for (uint32_t o = outputStart_[state]; o < outputStart_[state + 1]; o++) {
+                const Pattern& pattern = patterns_[outputs_[o]];
+                onMatch(pattern.ruleId, i + 1 - pattern.length, i + 1);
+            }
+        }
+    }
+
+    // Resumable scan of a stream delivered in pieces: pass 0 for the first
+    // piece and the returned state for each following one, so matches that
+    // straddle two pieces are still found. Calls onMatch(ruleId) per occurrence.
+    template <typename Callback>
+    int32_t ScanChunk(int32_t state, const char* text, size_t length, Callback&& onMatch) const {
+        if (!compiled_ || patterns_.empty()) return 0;
+
+        for (size_t i = 0; i < length; i++) {
+            state = delta_[static_cast<size_t>(state) * classCount_ +
+                           byteClass_[static_cast<unsigned char>(text[i])]];
+            for (uint32_t o = outputStart_[state]; o < outputStart_[state + 1]; o++) {
+                onMatch(patterns_[outputs_[o]].ruleId);
+            }
+        }
+        return state;
+    }
+
+    template <typename Callback>
+    void Scan(const std::string& text, Callback&& onMatch) const {
+        Scan(text.data(), text.size(), onMatch);
+    }
+
+    // True if any pattern occurs in text; stops at the first hit
+    bool Contains(const char* text, size_t length) const;
+    bool Contains(const std::string& text) const { return Contains(text.data(), text.size()); }
+
+    size_t PatternCount() const { return patterns_.size(); }
+    size_t StateCount() const { return outputStart_.empty() ? 0 : outputStart_.size() - 1; }
+
+private:
+    struct Pattern {
+        std::string text;
+        int ruleId;
+        size_t length;
+    };
+
+    bool caseInsensitive_;
+    bool compiled_;
+    std::vector<Pattern> patterns_;
+
+    // Bytes that appear in no pattern share class 0, which keeps the table narrow
+    uint16_t byteClass_[256];
+    size_t classCount_;
+    std::vector<int32_t> delta_;          // state * classCount_ + class -> next state
+    std::vector<uint32_t> outputStart_;   // outputs_[outputStart_[s] .. outputStart_[s + 1])
+    std::vector<uint32_t> outputs_;       // Pattern indexes, including those inherited via fail links
+};
+
+#endif // PATTERN_MATCHER_H
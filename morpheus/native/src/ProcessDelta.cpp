@@ -0,0 +1,122 @@
+#include "ProcessDelta.h"
+#include <functional>
+
+ProcessDeltaTracker::ProcessDeltaTracker(size_t historyDepth, std::chrono::milliseconds resyncInterval)
+    : historyDepth_(historyDepth > 0 ? historyDepth : 1),
+      resyncInterval_(resyncInterval.count() > 0 ? resyncInterval : std::chrono::milliseconds(1)) {
+}
+
+ProcessDeltaKey ProcessDeltaTracker::KeyFor(const ProcessInfo& process) {
+    // Start time is 0 where the platform does not report one, so name and path
+    // are part of the identity as well
+    ProcessDeltaKey key;
+    key.pid = process.pid;
+    key.startTime = process.startTime;
+    key.identityHash = std::hash<std::string>()(process.path) * 31 + std::hash<std::string>()(process.name);
+    key.category = process.category;
+    key.threatLevel = process.threatLevel;
+    key.blacklisted = process.blacklisted;
+    return key;
+}
+
+void ProcessDeltaTracker::Record(uint64_t generation, const std::vector<ProcessInfo>& processes) {
+    Entry entry;
+    entry.generation = generation;
+    entry.keys.reserve(processes.size());
+    for (const auto& process : processes) {
+        entry.keys.push_back(KeyFor(process));
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!history_.empty() && history_.back().generation >= generation) {
+        return;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    if (history_.empty()) {
+        epochStart_ = now;
+    } else if (now - epochStart_ >= resyncInterval_) {
+        epoch_++;
+        epochStart_ = now;
+    }
+    entry.epoch = epoch_;
+
+    history_.push_back(std::move(entry));
+    while (history_.size() > historyDepth_) {
+        history_.pop_front();
+    }
+}
+
+ProcessDelta ProcessDeltaTracker::Diff(uint64_t sinceGeneration, uint64_t currentGeneration,
+                                       const std::vector<ProcessInfo>& current) const {
+    ProcessDelta delta;
+    delta.fromGeneration = sinceGeneration;
+    delta.toGeneration = currentGeneration;
+
+    std::vector<ProcessDeltaKey> previous;
+    bool baselineFound = false;
+    if (sinceGeneration != 0 && sinceGeneration <= currentGeneration) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const Entry* baseline = nullptr;
+        const Entry* latest = nullptr;
+        for (const auto& entry : history_) {
+            if (entry.generation == sinceGeneration) baseline = &entry;
+            if (entry.generation == currentGeneration) latest = &entry;
+        }
+        // Both in the same resync window
+        if (baseline && latest && baseline->epoch == latest->epoch) {
+            previous = baseline->keys;
+            baselineFound = true;
+        }
+    }
+
+    if (!baselineFound) {
+        delta.fromGeneration = 0;
+        delta.fullResync = true;
+        delta.added = current;
+        return delta;
+    }
+
+    // Merge walk over both pid-sorted lists
+    size_t i = 0;
+    size_t j = 0;
+    while (i < previous.size() || j < current.size()) {
+        if (j == current.size() || (i < previous.size() && previous[i].pid < current[j].pid)) {
+            if (previous[i].threatLevel > 0) {
+                delta.cleared.push_back({previous[i], true});
+            }
+            delta.removed.push_back(previous[i++]);
+            continue;
+        }
+        if (i == previous.size() || current[j].pid < previous[i].pid) {
+            delta.added.push_back(current[j++]);
+            continue;
+        }
+
+        const ProcessDeltaKey& before = previous[i++];
+        const ProcessInfo& process = current[j++];
+        ProcessDeltaKey after = KeyFor(process);
+
+        if (before.startTime != after.startTime || before.identityHash != after.identityHash) {
+            if (before.threatLevel > 0) {
+                delta.cleared.push_back({before, true});
+            }
+            delta.removed.push_back(before);
+            delta.added.push_back(process);
+        } else if (before.category != after.category || before.threatLevel != after.threatLevel ||
+                   before.blacklisted != after.blacklisted) {
+            if (before.threatLevel > 0 && after.threatLevel == 0) {
+                delta.cleared.push_back({before, false});
+            }
+            ProcessReclassification change{process, before.category, before.threatLevel, before.blacklisted};
+            delta.reclassified.push_back(std::move(change));
+        }
+    }
+
+    return delta;
+}
+
+uint64_t ProcessDeltaTracker::LatestGeneration() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return history_.empty() ? 0 : history_.back().generation;
+}
@@ -0,0 +1,95 @@
+#ifndef PROCESS_DELTA_H
+#define PROCESS_DELTA_H
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "CommonTypes.h"
+
+// Identity and classification of one process as of a recorded generation. Two
+// keys with the same pid but different start time or name/path hash are
+// different processes (pid reuse).
+struct ProcessDeltaKey {
+    int pid = 0;
+    unsigned long long startTime = 0;
+    size_t identityHash = 0;
+    int category = 0;
+    int threatLevel = 0;
+    bool blacklisted = false;
+};
+
+struct ProcessReclassification {
+    ProcessInfo process;
+    int previousCategory = 0;
+    int previousThreatLevel = 0;
+    bool previousBlacklisted = false;
+};
+
+// A process that had a threat level at the baseline generation and has none
+// now, either because it is gone or because it was reclassified
+struct ProcessThreatCleared {
+    ProcessDeltaKey previous;
+    bool exited = false; // Gone or pid reused, rather than reclassified
+};
+
+// Changes between two recorded generations. On a full resync `added` holds every
+// current process and the receiver should drop its previous state.
+struct ProcessDelta {
+    uint64_t fromGeneration = 0;
+    uint64_t toGeneration = 0;
+    bool fullResync = false;
+    std::vector<ProcessInfo> added;
+    std::vector<ProcessDeltaKey> removed;
+    std::vector<ProcessReclassification> reclassified;
+    std::vector<ProcessThreatCleared> cleared; // Subset of removed and reclassified; empty on a full resync
+
+    bool Empty() const { return added.empty() && removed.empty() && reclassified.empty(); }
+};
+
+// Keeps the sorted identity sets of the last few recorded generations so a
+// consumer holding any of them can be brought up to date with a delta instead of
+// the full process list. Consumers whose baseline has aged out, and everyone
+// once per resyncInterval of wall-clock time, get a full resync. Time rather
+// than generation count, since exec/exit bursts publish many generations a
+// second. The history is deep enough for pollers to keep their baseline
+// through such a burst.
+class ProcessDeltaTracker {
+public:
+    static constexpr size_t kDefaultHistoryDepth = 64;
+    static constexpr std::chrono::milliseconds kDefaultResyncInterval{60000};
+
+    explicit ProcessDeltaTracker(size_t historyDepth = kDefaultHistoryDepth,
+                                 std::chrono::milliseconds resyncInterval = kDefaultResyncInterval);
+
+    // processes must be sorted by pid; generations older than the latest are ignored
+    void Record(uint64_t generation, const std::vector<ProcessInfo>& processes);
+
+    // Delta from sinceGeneration to `current`, which must be the processes
+    // recorded for currentGeneration. sinceGeneration 0 requests a full resync.
+    ProcessDelta Diff(uint64_t sinceGeneration, uint64_t currentGeneration,
+                      const std::vector<ProcessInfo>& current) const;
+
+    uint64_t LatestGeneration() const;
+
+    static ProcessDeltaKey KeyFor(const ProcessInfo& process);
+
+private:
+    struct Entry {
+        uint64_t generation = 0;
+        uint64_t epoch = 0;                // Resync window it was recorded in
+        std::vector<ProcessDeltaKey> keys; // Sorted by pid
+    };
+
+    size_t historyDepth_;
+    std::chrono::milliseconds resyncInterval_;
+    std::deque<Entry> history_;
+    uint64_t epoch_ = 0;
+    std::chrono::steady_clock::time_point epochStart_;
+    mutable std::mutex mutex_; // Guards the four above
+};
+
+#endif // PROCESS_DELTA_H
@@ -0,0 +1,178 @@
+#include "ProcessEventSource.h"
+
+#ifdef __linux__
+#include <linux/cn_proc.h>
+#include <linux/connector.h>
+#include <linux/netlink.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#endif
+
+ProcessEventSource::ProcessEventSource() : fd_(-1) {
+}
+
+ProcessEventSource::~ProcessEventSource() {
+    Close();
+}
+
+bool ProcessEventSource::IsOpen() const {
+    return fd_ >= 0;
+}
+
+int ProcessEventSource::Fd() const {
+    return fd_;
+}
+
+#ifdef __linux__
+bool ProcessEventSource::Open() {
+    if (fd_ >= 0) {
+        return true;
+    }
+
+    fd_ = socket(PF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK, NETLINK_CONNECTOR);
+    if (fd_ < 0) {
+        return false;
+    }
+
+    // Exec storms (builds, shell loops) can queue thousands of events per second
+    int receiveBuffer = 1 << 20;
+    setsockopt(fd_, SOL_SOCKET, SO_RCVBUF, &receiveBuffer, sizeof(receiveBuffer));
+
+    // Joining the proc connector group fails with EPERM without CAP_NET_ADMIN
+    struct sockaddr_nl address;
+    memset(&address, 0, sizeof(address));
+    address.nl_family = AF_NETLINK;
+    address.nl_groups = CN_IDX_PROC;
+    address.nl_pid = 0;
+
+    if (bind(fd_, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) < 0 ||
+        !SetListening(true)) {
+        close(fd_);
+        fd_ = -1;
+        return false;
+    }
+
+    return true;
+}
+
+void ProcessEventSource::Close() {
+    if (fd_ < 0) {
+        return;
+    }
+
+    SetListening(false);
+    close(fd_);
+    fd_ = -1;
+}
+
+bool ProcessEventSource::SetListening(bool listen) {
+    alignas(struct nlmsghdr) char buffer[NLMSG_SPACE(sizeof(struct cn_msg) + sizeof(enum proc_cn_mcast_op))];
+    memset(buffer, 0, sizeof(buffer));
+
+    struct nlmsghdr* header = reinterpret_cast<struct nlmsghdr*>(buffer);
+    header->nlmsg_len = NLMSG_LENGTH(sizeof(struct cn_msg) + sizeof(enum proc_cn_mcast_op));
+    header->nlmsg_type = NLMSG_DONE;
+    header->nlmsg_pid = 0;
+
+    struct cn_msg* message = reinterpret_cast<struct cn_msg*>(NLMSG_DATA(header));
+    message->id.idx = CN_IDX_PROC;
+    message->id.val = CN_VAL_PROC;
+    message->len = sizeof(enum proc_cn_mcast_op);
+
+    enum proc_cn_mcast_op op = listen ? PROC_CN_MCAST_LISTEN : PROC_CN_MCAST_IGNORE;
+    memcpy(message->data, &op, sizeof(op));
+
+    return send(fd_, header, header->nlmsg_len, 0) == static_cast<ssize_t>(header->nlmsg_len);
+}
+
+bool ProcessEventSource::Wait(int timeoutMs, Batch& batch) {
+    if (fd_ < 0) {
+        return false;
+    }
+
+    struct pollfd pfd;
+    pfd.fd = fd_;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+
+    int ready = poll(&pfd, 1, timeoutMs);
+    if (ready <= 0) {
+        return ready == 0 || errno == EINTR;
+    }
+
+    alignas(struct nlmsghdr) char buffer[8192];
+    while (true) {
+        struct sockaddr_nl sender;
+        socklen_t senderLength = sizeof(sender);
+        ssize_t length = recvfrom(fd_, buffer, sizeof(buffer), 0,
+                                  reinterpret_cast<struct sockaddr*>(&sender), &senderLength);
+        if (length < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            if (errno == ENOBUFS) {
+                batch.overrun = true;
+                continue;
+            }
+            Close();
+            return false;
+        }
+
+        // Only the kernel may speak for the proc connector
+        if (sender.nl_pid != 0) {
+            continue;
+        }
+
+        int remaining = static_cast<int>(length);
+        for (struct nlmsghdr* header = reinterpret_cast<struct nlmsghdr*>(buffer);
+             NLMSG_OK(header, remaining); header = NLMSG_NEXT(header, remaining)) {
+            if (header->nlmsg_type == NLMSG_NOOP) continue;
+            if (header->nlmsg_type == NLMSG_ERROR || header->nlmsg_type == NLMSG_OVERRUN) {
+                batch.overrun = true;
+                continue;
+            }
+
+            const struct cn_msg* message = reinterpret_cast<const struct cn_msg*>(NLMSG_DATA(header));
+            const struct proc_event* event = reinterpret_cast<const struct proc_event*>(message->data);
+            if (message->id.idx != CN_IDX_PROC || message->id.val != CN_VAL_PROC ||
+                message->len < offsetof(struct proc_event, event_data) + sizeof(event->event_data.exit)) {
+                continue;
+            }
+
+            // Thread fork/exec/exit events are reported too; only thread group
+            // leaders are processes. Forked children that never exec (zygote
+            // renderers, forked helpers) are only announced by the fork.
+            if (event->what == proc_event::PROC_EVENT_FORK &&
+                event->event_data.fork.child_pid == event->event_data.fork.child_tgid) {
+                batch.forkPids.push_back(event->event_data.fork.child_tgid);
+            } else if (event->what == proc_event::PROC_EVENT_EXEC &&
+                event->event_data.exec.process_pid == event->event_data.exec.process_tgid) {
+                batch.execPids.push_back(event->event_data.exec.process_tgid);
+            } else if (event->what == proc_event::PROC_EVENT_EXIT &&
+                       event->event_data.exit.process_pid == event->event_data.exit.process_tgid) {
+                batch.exitPids.push_back(event->event_data.exit.process_tgid);
+            }
+        }
+    }
+
+    return true;
+}
+#else
+bool ProcessEventSource::Open() {
+    return false;
+}
+
+void ProcessEventSource::Close() {
+}
+
+bool ProcessEventSource::SetListening(bool) {
+    return false;
+}
+
+bool ProcessEventSource::Wait(int, Batch&) {
+    return false;
+}
+#endif
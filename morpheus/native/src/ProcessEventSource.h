@@ -0,0 +1,40 @@
+#ifndef PROCESS_EVENT_SOURCE_H
+#define PROCESS_EVENT_SOURCE_H
+
+#include <vector>
+
+// Process fork/exec/exit notifications pushed by the kernel, so short-lived
+// processes are seen even if they start and exit between two polls. Linux only (proc
+// connector over NETLINK_CONNECTOR, needs CAP_NET_ADMIN); Open() fails on other
+// platforms or without the capability and the caller keeps polling.
+class ProcessEventSource {
+public:
+    struct Batch {
+        std::vector<int> forkPids;  // New thread group leaders (fork without CLONE_THREAD)
+        std::vector<int> execPids;  // Thread group leaders that called exec
+        std::vector<int> exitPids;  // Thread group leaders that exited
+        bool overrun = false;       // Events were dropped; rescan the full table
+    };
+
+    ProcessEventSource();
+    ~ProcessEventSource();
+
+    bool Open();
+    void Close();
+    bool IsOpen() const;
+    int Fd() const;
+
+    // Waits up to timeoutMs for events and drains everything queued. Returns false
+    // if the socket failed and the source was closed.
+    bool Wait(int timeoutMs, Batch& batch);
+
+private:
+    ProcessEventSource(const ProcessEventSource&) = delete;
+    ProcessEventSource& operator=(const ProcessEventSource&) = delete;
+
+    bool SetListening(bool listen);
+
+    int fd_;
+};
+
+#endif // PROCESS_EVENT_SOURCE_H
@@ -0,0 +1,185 @@
+#include "ProcessExitWatcher.h"
+#include "ProcessTable.h"
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdint>
+
+#ifndef SYS_pidfd_open
+#define SYS_pidfd_open 434
+#endif
+
+// Marks the AddReadable descriptor in epoll_event.data
+static const uint64_t kReadableTag = ~0ULL;
+#endif
+
+ProcessExitWatcher::ProcessExitWatcher() : epollFd_(-1), readableFd_(-1) {
+}
+
+ProcessExitWatcher::~ProcessExitWatcher() {
+    Close();
+}
+
+bool ProcessExitWatcher::IsOpen() const {
+    return epollFd_ >= 0;
+}
+
+bool ProcessExitWatcher::IsWatching(int pid) const {
+    return pidfds_.find(pid) != pidfds_.end();
+}
+
+std::vector<int> ProcessExitWatcher::WatchedPids() const {
+    std::vector<int> pids;
+    pids.reserve(pidfds_.size());
+    for (const auto& entry : pidfds_) {
+        pids.push_back(entry.first);
+    }
+    return pids;
+}
+
+#ifdef __linux__
+bool ProcessExitWatcher::Open() {
+    if (epollFd_ >= 0) {
+        return true;
+    }
+
+    epollFd_ = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd_ < 0) {
+        return false;
+    }
+
+    // Kernels before 5.3 have no pidfd_open; nothing could ever be watched
+    int probe = static_cast<int>(syscall(SYS_pidfd_open, getpid(), 0));
+    if (probe < 0) {
+        close(epollFd_);
+        epollFd_ = -1;
+        return false;
+    }
+    close(probe);
+
+    return true;
+}
+
+void ProcessExitWatcher::Close() {
+    for (const auto& entry : pidfds_) {
+        close(entry.second);
+    }
+    pidfds_.clear();
+    readableFd_ = -1;
+
+    if (epollFd_ >= 0) {
+        close(epollFd_);
+        epollFd_ = -1;
+    }
+}
+
+bool ProcessExitWatcher::Watch(int pid, unsigned long long startTime) {
+    if (epollFd_ < 0 || pid <= 0 || IsWatching(pid)) {
+        return false;
+    }
+
+    int pidfd = static_cast<int>(syscall(SYS_pidfd_open, pid, 0));
+    if (pidfd < 0) {
+        return false;
+    }
+
+    // The pidfd pins whatever process held the pid when it was opened
+    unsigned long long currentStartTime = 0;
+    if (!ProcessTable::ReadStartTime(pid, currentStartTime) || currentStartTime != startTime) {
+        close(pidfd);
+        return false;
+    }
+
+    struct epoll_event event;
+    event.events = EPOLLIN;
+    event.data.u64 = static_cast<uint64_t>(pid);
+    if (epoll_ctl(epollFd_, EPOLL_CTL_ADD, pidfd, &event) < 0) {
+        close(pidfd);
+        return false;
+    }
+
+    pidfds_[pid] = pidfd;
+    return true;
+}
+
+void ProcessExitWatcher::Unwatch(int pid) {
+    auto it = pidfds_.find(pid);
+    if (it == pidfds_.end()) {
+        return;
+    }
+
+    // Closing the last reference removes it from the epoll set
+    close(it->second);
+    pidfds_.erase(it);
+}
+
+bool ProcessExitWatcher::AddReadable(int fd) {
+    if (epollFd_ < 0 || fd < 0) {
+        return false;
+    }
+
+    struct epoll_event event;
+    event.events = EPOLLIN;
+    event.data.u64 = kReadableTag;
+    if (epoll_ctl(epollFd_, EPOLL_CTL_ADD, fd, &event) < 0) {
+        return false;
+    }
+
+    readableFd_ = fd;
+    return true;
+}
+
+bool ProcessExitWatcher::Wait(int timeoutMs, std::vector<int>& exited, bool& readableReady) {
+    if (epollFd_ < 0) {
+        return false;
+    }
+
+    struct epoll_event events[32];
+    int count = epoll_wait(epollFd_, events, 32, timeoutMs);
+    if (count < 0) {
+        if (errno == EINTR) return true;
+        Close();
+        return false;
+    }
+
+    for (int i = 0; i < count; i++) {
+        if (events[i].data.u64 == kReadableTag) {
+            readableReady = true;
+            continue;
+        }
+
+        int pid = static_cast<int>(events[i].data.u64);
+        Unwatch(pid);
+        exited.push_back(pid);
+    }
+
+    return true;
+}
+#else
+bool ProcessExitWatcher::Open() {
+    return false;
+}
+
+void ProcessExitWatcher::Close() {
+    pidfds_.clear();
+}
+
+bool ProcessExitWatcher::Watch(int, unsigned long long) {
+    return false;
+}
+
+void ProcessExitWatcher::Unwatch(int pid) {
+    pidfds_.erase(pid);
+}
+
+bool ProcessExitWatcher::AddReadable(int) {
+    return false;
+}
+
+bool ProcessExitWatcher::Wait(int, std::vector<int>&, bool&) {
+    return false;
+}
+#endif
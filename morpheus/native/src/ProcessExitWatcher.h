@@ -0,0 +1,44 @@
+#ifndef PROCESS_EXIT_WATCHER_H
+#define PROCESS_EXIT_WATCHER_H
+
+#include <unordered_map>
+#include <vector>
+
+// Holds a pidfd per watched process in one epoll set so an exit is seen the
+// moment it happens rather than at the next table walk. Linux 5.3+ only; Open()
+// fails elsewhere and callers keep relying on rescans.
+class ProcessExitWatcher {
+public:
+    ProcessExitWatcher();
+    ~ProcessExitWatcher();
+
+    bool Open();
+    void Close();
+    bool IsOpen() const;
+
+    // startTime (clock ticks since boot) is checked after the pidfd is opened so a
+    // reused pid is never watched in place of the flagged process
+    bool Watch(int pid, unsigned long long startTime);
+    void Unwatch(int pid);
+    bool IsWatching(int pid) const;
+    std::vector<int> WatchedPids() const;
+
+    // Adds an unrelated descriptor (e.g. the proc connector socket) to the same
+    // epoll set so the detector loop blocks in one place
+    bool AddReadable(int fd);
+
+    // Waits up to timeoutMs. Exited pids are appended and no longer watched;
+    // readableReady is set if the descriptor from AddReadable has data. Returns
+    // false if the epoll set failed and the watcher was closed.
+    bool Wait(int timeoutMs, std::vector<int>& exited, bool& readableReady);
+
+private:
+    ProcessExitWatcher(const ProcessExitWatcher&) = delete;
+    ProcessExitWatcher& operator=(const ProcessExitWatcher&) = delete;
+
+    int epollFd_;
+    int readableFd_;
+    std::unordered_map<int, int> pidfds_; // pid -> pidfd
+};
+
+#endif // PROCESS_EXIT_WATCHER_H
@@ -0,0 +1,152 @@
+#include "ProcessLineage.h"
+#include <algorithm>
+#include <unordered_set>
+
+void ProcessLineage::Update(const std::vector<ProcessInfo>& processes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Merge-walk the previous pid list against the new one to find exits
+    size_t previous = 0;
+    for (const ProcessInfo& process : processes) {
+        while (previous < indexedPids_.size() && indexedPids_[previous] < process.pid) {
+            int exitedPid = indexedPids_[previous++];
+            auto exited = nodes_.find(exitedPid);
+            if (exited != nodes_.end()) {
+                Unlink(exitedPid, exited->second.parentPid);
+                nodes_.erase(exited);
+            }
+        }
+        if (previous < indexedPids_.size() && indexedPids_[previous] == process.pid) {
+            previous++;
+        }
+
+        auto it = nodes_.find(process.pid);
+        if (it == nodes_.end()) {
+            Node node;
+            node.parentPid = process.parentPid;
+            node.startTime = process.startTime;
+            nodes_.emplace(process.pid, node);
+            Link(process.pid, process.parentPid);
+        } else if (it->second.parentPid != process.parentPid || it->second.startTime != process.startTime) {
+            // Reparented (parent exited) or the pid was reused
+            Unlink(process.pid, it->second.parentPid);
+            it->second.parentPid = process.parentPid;
+            it->second.startTime = process.startTime;
+            Link(process.pid, process.parentPid);
+        }
+    }
+
+    for (; previous < indexedPids_.size(); previous++) {
+        int exitedPid = indexedPids_[previous];
+        auto exited = nodes_.find(exitedPid);
+        if (exited != nodes_.end()) {
+            Unlink(exitedPid, exited->second.parentPid);
+            nodes_.erase(exited);
+        }
+    }
+
+    indexedPids_.clear();
+    indexedPids_.reserve(processes.size());
+    for (const ProcessInfo& process : processes) {
+        indexedPids_.push_back(process.pid);
+    }
+}
+
+std::vector<ProcessLineageEntry> ProcessLineage::Subtree(int pid) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::vector<ProcessLineageEntry> result;
+    auto root = nodes_.find(pid);
+    if (root == nodes_.end()) {
+        return result;
+    }
+
+    ProcessLineageEntry rootEntry;
+    rootEntry.pid = pid;
+    rootEntry.parentPid = root->second.parentPid;
+    result.push_back(rootEntry);
+
+    std::unordered_set<int> visited;
+    visited.insert(pid);
+
+    // result doubles as the BFS queue
+    for (size_t i = 0; i < result.size(); i++) {
+        ProcessLineageEntry current = result[i];
+        auto children = children_.find(current.pid);
+        if (children == children_.end()) continue;
+
+        const Node& parent = nodes_.at(current.pid);
+        for (int childPid : children->second) {
+            auto child = nodes_.find(childPid);
+            if (child == nodes_.end() || !IsParentOf(parent, child->second) || !visited.insert(childPid).second) {
+                continue;
+            }
+
+            ProcessLineageEntry entry;
+            entry.pid = childPid;
+            entry.parentPid = current.pid;
+            entry.depth = current.depth + 1;
+            result.push_back(entry);
+        }
+    }
+
+    return result;
+}
+
+std::vector<ProcessLineageEntry> ProcessLineage::Ancestry(int pid) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::vector<ProcessLineageEntry> result;
+    auto it = nodes_.find(pid);
+    int depth = 0;
+    while (it != nodes_.end()) {
+        ProcessLineageEntry entry;
+        entry.pid = it->first;
+        entry.parentPid = it->second.parentPid;
+        entry.depth = depth++;
+        result.push_back(entry);
+
+        // pid 0 and self-parented entries (Windows idle/System) end the chain
+        int parentPid = it->second.parentPid;
+        if (parentPid <= 0 || parentPid == it->first) break;
+
+        auto parent = nodes_.find(parentPid);
+        if (parent == nodes_.end() || !IsParentOf(parent->second, it->second)) break;
+
+        // Cycles can only come from a stale parent on a platform without start times
+        bool seen = std::any_of(result.begin(), result.end(),
+                                [parentPid](const ProcessLineageEntry& e) { return e.pid == parentPid; });
+        if (seen) break;
+
+        it = parent;
+    }
+
+    return result;
+}
+
+void ProcessLineage::Link(int pid, int parentPid) {
+    children_[parentPid].push_back(pid);
+}
+
+void ProcessLineage::Unlink(int pid, int parentPid) {
+    auto it = children_.find(parentPid);
+    if (it == children_.end()) return;
+
+    auto& siblings = it->second;
+    auto child = std::find(siblings.begin(), siblings.end(), pid);
+    if (child != siblings.end()) {
+        *child = siblings.back();
+        siblings.pop_back();
+    }
+    if (siblings.empty()) {
+        children_.erase(it);
+    }
+}
+
+bool ProcessLineage::IsParentOf(const Node& parent, const Node& child) const {
+    // Start times are 0 where the platform does not provide them (Windows)
+    if (parent.startTime == 0 || child.startTime == 0) {
+        return true;
+    }
+    return parent.startTime <= child.startTime;
+}
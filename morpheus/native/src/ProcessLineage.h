@@ -0,0 +1,49 @@
+#ifndef PROCESS_LINEAGE_H
+#define PROCESS_LINEAGE_H
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "CommonTypes.h"
+
+struct ProcessLineageEntry {
+    int pid = 0;
+    int parentPid = 0;
+    int depth = 0; // Distance from the queried pid
+};
+
+// Parent -> children index over the published process table. Update() applies
+// only the processes that appeared, exited or were reparented since the last
+// call, so a subtree or ancestry query is a walk of the affected branch rather
+// than a scan of every process.
+class ProcessLineage {
+public:
+    // processes must be sorted by pid (as in ProcessTableSnapshot)
+    void Update(const std::vector<ProcessInfo>& processes);
+
+    // The pid itself first, then descendants breadth-first
+    std::vector<ProcessLineageEntry> Subtree(int pid) const;
+
+    // The pid itself first, then each parent up to the root
+    std::vector<ProcessLineageEntry> Ancestry(int pid) const;
+
+private:
+    struct Node {
+        int parentPid = 0;
+        unsigned long long startTime = 0;
+    };
+
+    void Link(int pid, int parentPid);
+    void Unlink(int pid, int parentPid);
+
+    // A parent pid reused by a younger process is not the parent
+    bool IsParentOf(const Node& parent, const Node& child) const;
+
+    std::unordered_map<int, Node> nodes_;
+    std::unordered_map<int, std::vector<int>> children_; // By parent pid, which may have exited
+    std::vector<int> indexedPids_;                        // Sorted pids of the last Update
+    mutable std::mutex mutex_;
+};
+
+#endif // PROCESS_LINEAGE_H
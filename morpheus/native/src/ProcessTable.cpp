@@ -0,0 +1,631 @@
+#include "ProcessTable.h"
+#include <algorithm>
+
+#ifdef _WIN32
+#include <tlhelp32.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+
+static std::string WideStringToUtf8(const std::wstring& wstr) {
+    if (wstr.empty()) return std::string();
+    int size = WideCharToMultiByte(CP_UTF8, 0, wstr.c_str(), -1, nullptr, 0, nullptr, nullptr);
+    std::string result(size - 1, 0);
+    WideCharToMultiByte(CP_UTF8, 0, wstr.c_str(), -1, &result[0], size, nullptr, nullptr);
+    return result;
+}
+
+static std::string QueryProcessImagePath(DWORD processID) {
+    HANDLE hProcess = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, processID);
+    if (hProcess == nullptr) {
+        return "";
+    }
+
+    wchar_t path[32768];
+    DWORD size = sizeof(path) / sizeof(wchar_t);
+    std::string result;
+    if (QueryFullProcessImageNameW(hProcess, 0, path, &size)) {
+        result = WideStringToUtf8(std::wstring(path, size));
+    }
+
+    CloseHandle(hProcess);
+    return result;
+}
+
+// ProcessCommandLineInformation (Windows 8.1+) returns a UNICODE_STRING header
+// followed by the buffer; no PEB reads needed
+static std::shared_ptr<const std::string> QueryProcessCommandLine(DWORD processID) {
+    typedef LONG(WINAPI* NtQueryInformationProcessFn)(HANDLE, ULONG, PVOID, ULONG, PULONG);
+    static NtQueryInformationProcessFn queryInformation = reinterpret_cast<NtQueryInformationProcessFn>(
+        GetProcAddress(GetModuleHandleW(L"ntdll.dll"), "NtQueryInformationProcess"));
+    static const ULONG kProcessCommandLineInformation = 60;
+
+    struct CommandLineHeader {
+        USHORT Length;
+        USHORT MaximumLength;
+        PWSTR Buffer;
+    };
+
+    if (!queryInformation) {
+        return nullptr;
+    }
+
+    HANDLE hProcess = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, processID);
+    if (hProcess == nullptr) {
+        return nullptr;
+    }
+
+    std::vector<BYTE> buffer(4096);
+    ULONG needed = 0;
+    LONG status = queryInformation(hProcess, kProcessCommandLineInformation, buffer.data(),
+                                   static_cast<ULONG>(buffer.size()), &needed);
+    if (status < 0 && needed > buffer.size()) {
+        buffer.resize(needed);
+        status = queryInformation(hProcess, kProcessCommandLineInformation, buffer.data(),
+                                  static_cast<ULONG>(buffer.size()), &needed);
+    }
+    CloseHandle(hProcess);
+
+    if (status < 0) {
+        return nullptr;
+    }
+
+    const CommandLineHeader* header = reinterpret_cast<const CommandLineHeader*>(buffer.data());
+    if (!header->Buffer || header->Length == 0) {
+        return nullptr;
+    }
+    return std::make_shared<const std::string>(
+        WideStringToUtf8(std::wstring(header->Buffer, header->Length / sizeof(wchar_t))));
+}
+#elif __APPLE__
+#include <libproc.h>
+#include <sys/proc_info.h>
+#include <sys/sysctl.h>
+#include <unistd.h>
+#include <cstring>
+
+// KERN_PROCARGS2 layout: int argc, exec path, NUL padding, then argc NUL-terminated
+// arguments (followed by the environment, which is not read)
+static std::shared_ptr<const std::string> QueryProcessCommandLine(pid_t pid) {
+    static const size_t argMax = [] {
+        int mib[2] = {CTL_KERN, KERN_ARGMAX};
+        int value = 0;
+        size_t size = sizeof(value);
+        return sysctl(mib, 2, &value, &size, nullptr, 0) == 0 && value > 0 ? static_cast<size_t>(value) : 262144;
+    }();
+
+    std::vector<char> buffer(argMax);
+    int mib[3] = {CTL_KERN, KERN_PROCARGS2, pid};
+    size_t size = buffer.size();
+    if (sysctl(mib, 3, buffer.data(), &size, nullptr, 0) != 0 || size <= sizeof(int)) {
+        return nullptr;
+    }
+
+    int argc = 0;
+    memcpy(&argc, buffer.data(), sizeof(argc));
+
+    const char* cursor = buffer.data() + sizeof(int);
+    const char* end = buffer.data() + size;
+    cursor = static_cast<const char*>(memchr(cursor, '\0', end - cursor)); // Skip exec path
+    while (cursor && cursor < end && *cursor == '\0') cursor++;
+    if (!cursor) {
+        return nullptr;
+    }
+
+    std::string commandLine;
+    for (int arg = 0; arg < argc && cursor < end; arg++) {
+        size_t length = strnlen(cursor, end - cursor);
+        if (!commandLine.empty()) commandLine.push_back(' ');
+        commandLine.append(cursor, length);
+        cursor += length + 1;
+    }
+    return std::make_shared<const std::string>(std::move(commandLine));
+}
+#elif __linux__
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// PF_KTHREAD from include/linux/sched.h, exposed in field 9 of /proc/<pid>/stat
+static const unsigned long kProcfsKernelThreadFlag = 0x00200000;
+
+// Reads a procfs file into buf (NUL-terminated). Returns bytes read or -1.
+static ssize_t ReadProcfsFile(const char* path, char* buf, size_t size) {
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return -1;
+    }
+
+    ssize_t total = 0;
+    while (static_cast<size_t>(total) < size - 1) {
+        ssize_t n = read(fd, buf + total, size - 1 - total);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            close(fd);
+            return -1;
+        }
+        if (n == 0) break;
+        total += n;
+    }
+
+    close(fd);
+    buf[total] = '\0';
+    return total;
+}
+
+struct ProcfsStat {
+    const char* comm = nullptr;  // Points into the caller's buffer, not NUL-terminated
+    size_t commLength = 0;
+    int ppid = 0;
+    int session = -1;
+    unsigned long flags = 0;
+    unsigned long long startTime = 0;
+};
+
+// Parses the fields we need out of /proc/<pid>/stat. The comm field is wrapped in
+// parentheses and may itself contain spaces or ')', so fields are counted from the last ')'.
+static bool ParseProcfsStat(const char* buf, ProcfsStat& stat) {
+    const char* open = strchr(buf, '(');
+    const char* close = strrchr(buf, ')');
+    if (!open || !close || close < open || close[1] != ' ') {
+        return false;
+    }
+
+    stat.comm = open + 1;
+    stat.commLength = static_cast<size_t>(close - open - 1);
+
+    const char* cursor = close + 2;
+    const char* state = strchr(cursor, ' ');
+    if (!state) {
+        return false;
+    }
+    cursor = state + 1;
+
+    // Field 3 (state) is consumed above; walk numerically from field 4 (ppid) to 22 (starttime)
+    for (int field = 4; field <= 22; field++) {
+        char* next = nullptr;
+        unsigned long long value = strtoull(cursor, &next, 10);
+        if (next == cursor) {
+            return false;
+        }
+
+        if (field == 4) {
+            stat.ppid = static_cast<int>(value);
+        } else if (field == 6) {
+            stat.session = static_cast<int>(value);
+        } else if (field == 9) {
+            stat.flags = static_cast<unsigned long>(value);
+        } else if (field == 22) {
+            stat.startTime = value;
+            return true;
+        }
+
+        cursor = next;
+        while (*cursor == ' ') cursor++;
+    }
+
+    return false;
+}
+#endif
+
+ProcessTable& ProcessTable::Instance() {
+    static ProcessTable instance;
+    return instance;
+}
+
+ProcessTable::ProcessTable() : current_(std::make_shared<ProcessTableSnapshot>()), generation_(0) {
+}
+
+std::shared_ptr<const ProcessTableSnapshot> ProcessTable::Current() const {
+    return std::atomic_load(&current_);
+}
+
+uint64_t ProcessTable::Generation() const {
+    return generation_.load();
+}
+
+std::shared_ptr<const ProcessTableSnapshot> ProcessTable::Acquire(int maxAgeMs) {
+    auto snapshot = Current();
+    auto maxAge = std::chrono::milliseconds(maxAgeMs);
+
+    if (snapshot->generation != 0 && std::chrono::steady_clock::now() - snapshot->capturedAt < maxAge) {
+        return snapshot;
+    }
+
+    std::lock_guard<std::mutex> lock(refreshMutex_);
+
+    // Another detector may have refreshed while we waited for the lock
+    snapshot = Current();
+    if (snapshot->generation != 0 && std::chrono::steady_clock::now() - snapshot->capturedAt < maxAge) {
+        return snapshot;
+    }
+
+    return RefreshLocked();
+}
+
+std::shared_ptr<const ProcessTableSnapshot> ProcessTable::Refresh() {
+    std::lock_guard<std::mutex> lock(refreshMutex_);
+    return RefreshLocked();
+}
+
+std::shared_ptr<const ProcessTableSnapshot> ProcessTable::RefreshLocked() {
+    auto snapshot = std::make_shared<ProcessTableSnapshot>();
+    snapshot->generation = generation_.load() + 1;
+
+    Scan(snapshot->processes);
+
+    std::sort(snapshot->processes.begin(), snapshot->processes.end(),
+              [](const ProcessInfo& a, const ProcessInfo& b) { return a.pid < b.pid; });
+    snapshot->capturedAt = std::chrono::steady_clock::now();
+
+    PublishLocked(snapshot);
+    return snapshot;
+}
+
+void ProcessTable::PublishLocked(std::shared_ptr<const ProcessTableSnapshot> snapshot) {
+    // Indexed before publication so a reader of the new generation finds its pids
+    lineage_.Update(snapshot->processes);
+
+    std::atomic_store(&current_, snapshot);
+    generation_.store(snapshot->generation);
+}
+
+const ProcessLineage& ProcessTable::Lineage() const {
+    return lineage_;
+}
+
+void ProcessTable::Scan(std::vector<ProcessInfo>& processes) {
+    uint64_t generation = generation_.load() + 1;
+
+#ifdef _WIN32
+    HANDLE hSnapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
+    if (hSnapshot == INVALID_HANDLE_VALUE) {
+        return;
+    }
+
+    processes.reserve(win32Table_.size());
+
+    PROCESSENTRY32W pe32;
+    pe32.dwSize = sizeof(PROCESSENTRY32W);
+
+    if (Process32FirstW(hSnapshot, &pe32)) {
+        do {
+            std::string exeName = WideStringToUtf8(std::wstring(pe32.szExeFile));
+
+            auto it = win32Table_.find(pe32.th32ProcessID);
+            if (it == win32Table_.end() ||
+                it->second.parentPid != pe32.th32ParentProcessID ||
+                it->second.exeName != exeName) {
+                Win32Entry entry;
+                entry.parentPid = pe32.th32ParentProcessID;
+                entry.exeName = exeName;
+                entry.path = QueryProcessImagePath(pe32.th32ProcessID);
+                entry.hasSessionId = ProcessIdToSessionId(pe32.th32ProcessID, &entry.sessionId) != FALSE;
+                entry.commandLine = QueryProcessCommandLine(pe32.th32ProcessID);
+                it = win32Table_.insert_or_assign(pe32.th32ProcessID, std::move(entry)).first;
+            }
+
+            it->second.lastSeenScan = generation;
+            processes.emplace_back(static_cast<int>(pe32.th32ProcessID), it->second.exeName, it->second.path);
+            processes.back().parentPid = static_cast<int>(pe32.th32ParentProcessID);
+            processes.back().commandLine = it->second.commandLine;
+            if (it->second.hasSessionId) {
+                processes.back().sessionId = static_cast<int>(it->second.sessionId);
+            }
+        } while (Process32NextW(hSnapshot, &pe32));
+    }
+
+    CloseHandle(hSnapshot);
+
+    for (auto it = win32Table_.begin(); it != win32Table_.end();) {
+        if (it->second.lastSeenScan != generation) {
+            it = win32Table_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+#elif __APPLE__
+    int numberOfProcesses = proc_listallpids(nullptr, 0);
+    if (numberOfProcesses <= 0) {
+        return;
+    }
+
+    std::vector<pid_t> pids(numberOfProcesses);
+    numberOfProcesses = proc_listallpids(pids.data(), numberOfProcesses * sizeof(pid_t));
+    processes.reserve(numberOfProcesses);
+
+    for (int i = 0; i < numberOfProcesses; i++) {
+        pid_t pid = pids[i];
+        if (pid <= 0) continue;
+
+        struct proc_bsdshortinfo shortInfo;
+        struct proc_bsdinfo bsdInfo;
+        unsigned long long startTime = 0;
+        int parentPid = 0;
+        int uid = -1;
+        if (proc_pidinfo(pid, PROC_PIDTBSDINFO, 0, &bsdInfo, sizeof(bsdInfo)) == sizeof(bsdInfo)) {
+            startTime = static_cast<unsigned long long>(bsdInfo.pbi_start_tvsec) * 1000000ULL + bsdInfo.pbi_start_tvusec;
+            parentPid = static_cast<int>(bsdInfo.pbi_ppid);
+            uid = static_cast<int>(bsdInfo.pbi_ruid);
+        } else if (proc_pidinfo(pid, PROC_PIDT_SHORTBSDINFO, 0, &shortInfo, sizeof(shortInfo)) == sizeof(shortInfo)) {
+            parentPid = static_cast<int>(shortInfo.pbsi_ppid);
+            uid = static_cast<int>(shortInfo.pbsi_ruid);
+        } else {
+            continue; // Exited
+        }
+
+        auto it = darwinTable_.find(pid);
+        if (it == darwinTable_.end() || startTime == 0 || it->second.startTime != startTime) {
+            char pathBuffer[PROC_PIDPATHINFO_MAXSIZE];
+            if (proc_pidpath(pid, pathBuffer, sizeof(pathBuffer)) <= 0) {
+                continue;
+            }
+
+            DarwinEntry entry;
+            entry.startTime = startTime;
+            entry.sessionId = static_cast<int>(getsid(pid));
+            entry.commandLine = QueryProcessCommandLine(pid);
+            entry.path = pathBuffer;
+            size_t lastSlash = entry.path.find_last_of('/');
+            entry.name = (lastSlash != std::string::npos) ? entry.path.substr(lastSlash + 1) : entry.path;
+            it = darwinTable_.insert_or_assign(pid, std::move(entry)).first;
+        }
+
+        it->second.lastSeenScan = generation;
+        processes.emplace_back(pid, it->second.name, it->second.path);
+        processes.back().startTime = it->second.startTime;
+        processes.back().parentPid = parentPid;
+        processes.back().sessionId = it->second.sessionId;
+        processes.back().uid = uid;
+        processes.back().commandLine = it->second.commandLine;
+    }
+
+    for (auto it = darwinTable_.begin(); it != darwinTable_.end();) {
+        if (it->second.lastSeenScan != generation) {
+            it = darwinTable_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+#elif __linux__
+    DIR* procDir = opendir("/proc");
+    if (!procDir) {
+        return;
+    }
+
+    processes.reserve(procfsTable_.size());
+
+    // Steady state costs one readdir pass plus one stat read per pid; exe/comm/cmdline
+    // are only read the first time a (pid, starttime) identity is seen. The stat
+    // reads are issued as one batch so the io_uring engine can submit them together.
+    procfsScanPids_.clear();
+    procfsScanPaths_.clear();
+    struct dirent* dirEntry;
+    while ((dirEntry = readdir(procDir)) != nullptr) {
+        if (dirEntry->d_name[0] < '1' || dirEntry->d_name[0] > '9') continue;
+
+        char* end = nullptr;
+        long pid = strtol(dirEntry->d_name, &end, 10);
+        if (*end != '\0' || pid <= 0) continue;
+
+        procfsScanPids_.push_back(static_cast<int>(pid));
+        procfsScanPaths_.push_back(std::string("/proc/") + dirEntry->d_name + "/stat");
+    }
+
+    closedir(procDir);
+
+    if (!procfsReader_) {
+        procfsReader_.reset(new ProcfsBatchReader(procfsEngine_));
+    }
+    procfsReader_->ReadAll(procfsScanPaths_, procfsScanLengths_);
+
+    for (size_t i = 0; i < procfsScanPids_.size(); i++) {
+        int pid = procfsScanPids_[i];
+        ProcfsStat stat;
+        if (procfsScanLengths_[i] <= 0 || !ParseProcfsStat(procfsReader_->Data(i), stat)) {
+            continue; // Exited between readdir and read
+        }
+
+        auto it = procfsTable_.find(pid);
+        if (it == procfsTable_.end() || it->second.startTime != stat.startTime) {
+            ProcfsEntry entry;
+            entry.startTime = stat.startTime;
+            entry.kernelThread = (stat.flags & kProcfsKernelThreadFlag) != 0;
+            entry.name.assign(stat.comm, stat.commLength);
+
+            if (!entry.kernelThread) {
+                LoadProcfsIdentity(pid, entry);
+            }
+
+            it = procfsTable_.insert_or_assign(pid, std::move(entry)).first;
+        }
+
+        it->second.lastSeenScan = generation;
+        it->second.parentPid = stat.ppid;
+        it->second.sessionId = stat.session;
+
+        if (it->second.kernelThread) continue;
+
+        processes.emplace_back(pid, it->second.name, it->second.path);
+        ApplyProcfsEntry(it->second, processes.back());
+    }
+
+    for (auto it = procfsTable_.begin(); it != procfsTable_.end();) {
+        if (it->second.lastSeenScan != generation) {
+            it = procfsTable_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+#endif
+}
+
+#ifdef __linux__
+ProcfsIoEngine ProcessTable::SetProcfsIoEngine(ProcfsIoEngine engine) {
+    std::lock_guard<std::mutex> lock(refreshMutex_);
+
+    procfsEngine_ = engine;
+    procfsReader_.reset(new ProcfsBatchReader(engine));
+    return procfsReader_->ActiveEngine();
+}
+
+std::shared_ptr<const ProcessTableSnapshot> ProcessTable::ApplyEvents(const std::vector<int>& execPids,
+                                                                    const std::vector<int>& exitPids) {
+    std::lock_guard<std::mutex> lock(refreshMutex_);
+
+    auto base = Current();
+    if (base->generation == 0) {
+        return RefreshLocked();
+    }
+
+    auto snapshot = std::make_shared<ProcessTableSnapshot>();
+    snapshot->generation = generation_.load() + 1;
+    snapshot->processes = base->processes;
+
+    auto byPid = [](const ProcessInfo& process, int pid) { return process.pid < pid; };
+    auto& processes = snapshot->processes;
+
+    for (int pid : exitPids) {
+        procfsTable_.erase(pid);
+        auto it = std::lower_bound(processes.begin(), processes.end(), pid, byPid);
+        if (it != processes.end() && it->pid == pid) {
+            processes.erase(it);
+        }
+    }
+
+    for (int pid : execPids) {
+        ProcfsEntry entry;
+        if (!LoadProcfsEntry(pid, entry)) {
+            continue; // Already exited
+        }
+
+        entry.lastSeenScan = snapshot->generation;
+        auto& cached = procfsTable_[pid];
+        cached = std::move(entry);
+        if (cached.kernelThread) continue;
+
+        ProcessInfo process(pid, cached.name, cached.path);
+        ApplyProcfsEntry(cached, process);
+
+        auto it = std::lower_bound(processes.begin(), processes.end(), pid, byPid);
+        if (it != processes.end() && it->pid == pid) {
+            *it = std::move(process);
+        } else {
+            processes.insert(it, std::move(process));
+        }
+    }
+
+    snapshot->capturedAt = std::chrono::steady_clock::now();
+
+    PublishLocked(snapshot);
+    return snapshot;
+}
+
+bool ProcessTable::ReadStartTime(int pid, unsigned long long& startTime) {
+    char path[64];
+    char statBuffer[1024];
+    snprintf(path, sizeof(path), "/proc/%d/stat", pid);
+
+    ProcfsStat stat;
+    if (ReadProcfsFile(path, statBuffer, sizeof(statBuffer)) <= 0 ||
+        !ParseProcfsStat(statBuffer, stat)) {
+        return false;
+    }
+
+    startTime = stat.startTime;
+    return true;
+}
+
+bool ProcessTable::LoadProcfsEntry(int pid, ProcfsEntry& entry) {
+    char path[64];
+    char statBuffer[1024];
+    snprintf(path, sizeof(path), "/proc/%d/stat", pid);
+
+    ProcfsStat stat;
+    if (ReadProcfsFile(path, statBuffer, sizeof(statBuffer)) <= 0 ||
+        !ParseProcfsStat(statBuffer, stat)) {
+        return false;
+    }
+
+    entry.startTime = stat.startTime;
+    entry.parentPid = stat.ppid;
+    entry.sessionId = stat.session;
+    entry.kernelThread = (stat.flags & kProcfsKernelThreadFlag) != 0;
+    entry.name.assign(stat.comm, stat.commLength);
+
+    if (!entry.kernelThread) {
+        LoadProcfsIdentity(pid, entry);
+    }
+    return true;
+}
+
+void ProcessTable::ApplyProcfsEntry(const ProcfsEntry& entry, ProcessInfo& process) {
+    process.startTime = entry.startTime;
+    process.parentPid = entry.parentPid;
+    process.sessionId = entry.sessionId;
+    process.uid = entry.uid;
+    process.commandLine = entry.cmdline;
+}
+
+void ProcessTable::LoadProcfsIdentity(int pid, ProcfsEntry& entry) {
+    char path[64];
+
+    // Real uid is the first field of the "Uid:" line; cached with the identity
+    // since a uid change without exec is rare
+    snprintf(path, sizeof(path), "/proc/%d/status", pid);
+    char statusBuffer[4096];
+    if (ReadProcfsFile(path, statusBuffer, sizeof(statusBuffer)) > 0) {
+        const char* uidLine = strstr(statusBuffer, "\nUid:");
+        if (uidLine) {
+            entry.uid = static_cast<int>(strtol(uidLine + 5, nullptr, 10));
+        }
+    }
+
+    snprintf(path, sizeof(path), "/proc/%d/exe", pid);
+    char exeBuffer[4096];
+    ssize_t exeLength = readlink(path, exeBuffer, sizeof(exeBuffer) - 1);
+    if (exeLength > 0) {
+        entry.path.assign(exeBuffer, static_cast<size_t>(exeLength));
+
+        static const std::string deletedSuffix = " (deleted)";
+        if (entry.path.size() > deletedSuffix.size() &&
+            entry.path.compare(entry.path.size() - deletedSuffix.size(), deletedSuffix.size(), deletedSuffix) == 0) {
+            entry.path.resize(entry.path.size() - deletedSuffix.size());
+        }
+    }
+
+    snprintf(path, sizeof(path), "/proc/%d/cmdline", pid);
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd >= 0) {
+        std::string cmdline;
+        char chunk[4096];
+        ssize_t n;
+        while ((n = read(fd, chunk, sizeof(chunk))) > 0 && cmdline.size() < 32768) {
+            cmdline.append(chunk, static_cast<size_t>(n));
+        }
+        close(fd);
+
+        // argv is NUL-separated; keep argv[0] for the path fallback, then flatten
+        if (entry.path.empty() && !cmdline.empty() && cmdline[0] == '/') {
+            entry.path = cmdline.substr(0, cmdline.find('\0'));
+        }
+
+        while (!cmdline.empty() && cmdline.back() == '\0') {
+            cmdline.pop_back();
+        }
+        std::replace(cmdline.begin(), cmdline.end(), '\0', ' ');
+        entry.cmdline = std::make_shared<const std::string>(std::move(cmdline));
+    }
+
+    // comm is truncated to 15 characters, so prefer the executable's basename
+    if (!entry.path.empty()) {
+        size_t lastSlash = entry.path.find_last_of('/');
+        entry.name = (lastSlash != std::string::npos) ? entry.path.substr(lastSlash + 1) : entry.path;
+    }
+}
+#endif
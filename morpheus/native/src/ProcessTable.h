@@ -0,0 +1,140 @@
+#ifndef PROCESS_TABLE_H
+#define PROCESS_TABLE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
+
+#include "CommonTypes.h"
+#include "ProcessLineage.h"
+#include "ProcfsBatchReader.h"
+
+// Immutable result of one process walk. Shared between detectors, never modified
+// after publication.
+struct ProcessTableSnapshot {
+    uint64_t generation = 0;
+    std::chrono::steady_clock::time_point capturedAt;
+    std::vector<ProcessInfo> processes; // Sorted by pid
+};
+
+// Single process enumeration service shared by ProcessWatcher, ScreenWatcher and
+// VMDetector. Each detector asks for a snapshot no older than its own tick; the
+// first caller past that age performs the walk and everyone else reuses it.
+class ProcessTable {
+public:
+    static constexpr int kDefaultMaxAgeMs = 1000;
+
+    static ProcessTable& Instance();
+
+    // Returns the published snapshot, refreshing first if it is older than maxAgeMs
+    std::shared_ptr<const ProcessTableSnapshot> Acquire(int maxAgeMs = kDefaultMaxAgeMs);
+
+    // Returns the published snapshot without scanning (may be empty before first Acquire)
+    std::shared_ptr<const ProcessTableSnapshot> Current() const;
+
+    // Forces a walk and publishes a new generation
+    std::shared_ptr<const ProcessTableSnapshot> Refresh();
+
+    uint64_t Generation() const;
+
+    // Parent -> children index of the latest published snapshot
+    const ProcessLineage& Lineage() const;
+
+#ifdef __linux__
+    // Publishes the current snapshot patched with fork/exec/exit notifications
+    // instead of walking /proc. execPids takes forked children too: both load
+    // the entry, and exec always reloads the identity since the image changed
+    // under the same pid and start time.
+    std::shared_ptr<const ProcessTableSnapshot> ApplyEvents(const std::vector<int>& execPids,
+                                                            const std::vector<int>& exitPids);
+
+    // Start time field of /proc/<pid>/stat, in the units of ProcessInfo::startTime
+    static bool ReadStartTime(int pid, unsigned long long& startTime);
+
+    // Engine for the per-scan stat reads; takes effect on the next walk. Returns
+    // the engine actually in use (io_uring falls back to pread if unavailable).
+    ProcfsIoEngine SetProcfsIoEngine(ProcfsIoEngine engine);
+#endif
+
+private:
+    ProcessTable();
+    ProcessTable(const ProcessTable&) = delete;
+    ProcessTable& operator=(const ProcessTable&) = delete;
+
+    std::shared_ptr<const ProcessTableSnapshot> RefreshLocked();
+    void PublishLocked(std::shared_ptr<const ProcessTableSnapshot> snapshot);
+    void Scan(std::vector<ProcessInfo>& processes);
+
+    std::shared_ptr<const ProcessTableSnapshot> current_;
+    std::mutex refreshMutex_;
+    std::atomic<uint64_t> generation_;
+    ProcessLineage lineage_;
+
+#ifdef _WIN32
+    // Toolhelp gives no start time; (pid, parent pid, exe name) is used as the
+    // identity so the image path is only queried for new processes
+    struct Win32Entry {
+        DWORD parentPid = 0;
+        DWORD sessionId = 0;
+        bool hasSessionId = false;
+        std::string exeName;
+        std::string path;
+        std::shared_ptr<const std::string> commandLine;
+        uint64_t lastSeenScan = 0;
+    };
+    std::unordered_map<DWORD, Win32Entry> win32Table_;
+#elif __APPLE__
+    struct DarwinEntry {
+        unsigned long long startTime = 0;
+        int sessionId = -1;
+        std::string name;
+        std::string path;
+        std::shared_ptr<const std::string> commandLine;
+        uint64_t lastSeenScan = 0;
+    };
+    std::unordered_map<int, DarwinEntry> darwinTable_;
+#elif __linux__
+    // Incremental /proc table keyed by pid; an entry is reused only while the
+    // starttime from /proc/<pid>/stat still matches (guards against pid reuse)
+    struct ProcfsEntry {
+        unsigned long long startTime = 0;
+        int parentPid = 0;  // ppid and session are refreshed from stat on every scan
+        int sessionId = -1;
+        int uid = -1;
+        std::string name;
+        std::string path;
+        std::shared_ptr<const std::string> cmdline;
+        bool kernelThread = false;
+        uint64_t lastSeenScan = 0;
+    };
+    std::unordered_map<int, ProcfsEntry> procfsTable_;
+
+    // Scratch for the batched stat reads, reused across scans
+    ProcfsIoEngine procfsEngine_ = ProcfsIoEngine::Pread;
+    std::unique_ptr<ProcfsBatchReader> procfsReader_;
+    std::vector<int> procfsScanPids_;
+    std::vector<std::string> procfsScanPaths_;
+    std::vector<ssize_t> procfsScanLengths_;
+
+    void LoadProcfsIdentity(int pid, ProcfsEntry& entry);
+    bool LoadProcfsEntry(int pid, ProcfsEntry& entry);
+    static void ApplyProcfsEntry(const ProcfsEntry& entry, ProcessInfo& process);
+#endif
+};
+
+#endif // PROCESS_TABLE_H
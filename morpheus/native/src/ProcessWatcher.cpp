@@ -1,7 +1,13 @@
 #include "ProcessWatcher.h"
+#include "CommandLineFlags.h"
+#include "ProcessTable.h"
+#include "WorkStealingPool.h"
 #include <sstream>
+#include <fstream>
 #include <ctime>
+#include <cstring>
 #include <algorithm>
+#include <sys/stat.h>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -31,9 +37,10 @@ static std::string WideStringToUtf8(const std::wstring& wstr) {
 #include <dlfcn.h>
 #endif
 
-ProcessWatcher::ProcessWatcher() : running_(false), counter_(0), lastDetectionState_(false),
+ProcessWatcher::ProcessWatcher() : running_(false), counter_(0), intervalMs_(1500), lastDetectionState_(false),
                                    lastRecordingState_(false), recordingConfidenceThreshold_(0.75), overlayConfidenceThreshold_(0.6),
-                                   lastNetworkScan_(std::chrono::steady_clock::now()) {
+                                   riskCacheTableGeneration_(0), ruleGeneration_(0), lastBlacklistGeneration_(0),
+                                   lastNetworkScan_() {
 
     // Initialize comprehensive 2025 blacklists
     InitializeComprehensiveBlacklist2025();
@@ -54,6 +61,10 @@ ProcessWatcher::ProcessWatcher() : running_(false), counter_(0), lastDetectionSt
     blacklist_.insert("Google Chrome Helper (Renderer)");
     blacklist_.insert("Chromium");
     blacklist_.insert("chromium");
+
+    BuildClassifier();
+    BuildBlacklistMatcher();
+    BuildRecordingMatcher();
 }
 
 ProcessWatcher::~ProcessWatcher() {
@@ -84,6 +95,19 @@ void ProcessWatcher::Start(Napi::Function callback, int intervalMs) {
     });
 }
 
+void ProcessWatcher::StartMonitor(int intervalMs) {
+    if (running_.load()) {
+        return;
+    }
+
+    running_.store(true);
+    intervalMs_ = intervalMs;
+
+    worker_thread_ = std::thread([this]() {
+        WatcherLoop();
+    });
+}
+
 void ProcessWatcher::Stop() {
     if (!running_.load()) {
         return;
@@ -97,6 +121,7 @@ void ProcessWatcher::Stop() {
 
     if (tsfn_) {
         tsfn_.Release();
+        tsfn_ = Napi::ThreadSafeFunction();
     }
 
     callback_.Reset();
@@ -107,6 +132,7 @@ void ProcessWatcher::SetBlacklist(const std::vector<std::string>& blacklist) {
     for (const auto& item : blacklist) {
         blacklist_.insert(item);
     }
+    BuildBlacklistMatcher();
 }
 
 void ProcessWatcher::SetRecordingBlacklist(const std::vector<std::string>& recordingBlacklist) {
@@ -114,6 +140,7 @@ void ProcessWatcher::SetRecordingBlacklist(const std::vector<std::string>& recor
     for (const auto& item : recordingBlacklist) {
         recordingBlacklist_.insert(item);
     }
+    BuildRecordingMatcher();
 }
 
 bool ProcessWatcher::IsRunning() const {
@@ -122,113 +149,275 @@ bool ProcessWatcher::IsRunning() const {
 
 
 void ProcessWatcher::WatcherLoop() {
+    // Falls back to plain polling when the event source is unavailable
+    bool eventDriven = processEvents_.Open();
+
+    // Flagged processes are tracked by pidfd; the proc connector socket joins the
+    // same epoll set so the loop blocks in one place
+    bool exitWatch = flaggedExits_.Open();
+    if (exitWatch && eventDriven) {
+        flaggedExits_.AddReadable(processEvents_.Fd());
+    }
+
+    auto nextFullScan = std::chrono::steady_clock::now();
+    auto nextContentScan = nextFullScan;
+
     while (running_.load()) {
         try {
-            auto processes = GetRunningProcesses();
-            auto blacklisted = FilterBlacklistedProcesses(processes);
-
-            bool currentState = !blacklisted.empty();
+            auto now = std::chrono::steady_clock::now();
+            if (now >= nextFullScan) {
+                if (eventDriven) {
+                    // Events keep the table fresh, so Acquire alone would not rescan
+                    ProcessTable::Instance().Refresh();
+                }
+                CheckBlacklist();
+                counter_++;
+                nextFullScan = now + std::chrono::milliseconds(intervalMs_) * (eventDriven ? kEventResyncTicks : 1);
+            }
 
-            if (currentState != lastDetectionState_ ||
-                blacklisted.size() != lastBlacklistedProcesses_.size()) {
+            // Content scans run on their own tick so event bursts cannot spend
+            // the budget faster; between event-driven resyncs their results
+            // need a report of their own
+            if (now >= nextContentScan) {
+                if (AdvanceContentScans() && eventDriven) {
+                    CheckBlacklist();
+                }
+                nextContentScan = now + std::chrono::milliseconds(intervalMs_);
+            }
 
-                EmitDetectionEvent(currentState, blacklisted);
-                lastDetectionState_ = currentState;
-                lastBlacklistedProcesses_ = blacklisted;
+            auto wake = std::min(nextFullScan, nextContentScan);
+            auto untilWake = std::chrono::duration_cast<std::chrono::milliseconds>(
+                wake - std::chrono::steady_clock::now()).count();
+            int timeoutMs = static_cast<int>(std::max<long long>(0, std::min<long long>(untilWake, intervalMs_)));
+
+            bool eventsReady = eventDriven;
+            if (exitWatch) {
+                std::vector<int> exited;
+                eventsReady = false;
+                if (!flaggedExits_.Wait(timeoutMs, exited, eventsReady)) {
+                    exitWatch = false;
+                    continue;
+                }
+                if (!exited.empty()) {
+                    ClearExitedThreats(exited);
+                }
+                timeoutMs = 0; // Already waited; only drain the socket below
+            } else if (!eventDriven) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(timeoutMs));
+                continue;
             }
 
-            counter_++;
+            if (eventDriven && eventsReady) {
+                ProcessEventSource::Batch batch;
+                if (!processEvents_.Wait(timeoutMs, batch)) {
+                    eventDriven = false;
+                    nextFullScan = std::chrono::steady_clock::now();
+                    continue;
+                }
+                if (!batch.forkPids.empty() || !batch.execPids.empty() || !batch.exitPids.empty()) {
+                    // Pick up the rest of a burst (e.g. a shell pipeline) in one pass
+                    processEvents_.Wait(kEventCoalesceMs, batch);
+                }
+
+                if (batch.overrun) {
+                    nextFullScan = std::chrono::steady_clock::now();
+                    continue;
+                }
+
+                // Forks and execs are classified before exits are applied so a
+                // process that ran between two notifications is still reported once.
+                // A child that forks and then execs in one batch is loaded once.
+                std::vector<int> started = std::move(batch.forkPids);
+                started.insert(started.end(), batch.execPids.begin(), batch.execPids.end());
+                std::sort(started.begin(), started.end());
+                started.erase(std::unique(started.begin(), started.end()), started.end());
+                if (!started.empty()) {
+                    ProcessTable::Instance().ApplyEvents(started, {});
+                    CheckBlacklist();
+                }
+                if (!batch.exitPids.empty()) {
+                    ProcessTable::Instance().ApplyEvents({}, batch.exitPids);
+                    CheckBlacklist();
+                }
+            }
         } catch (const std::exception&) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(intervalMs_));
         }
-
-        std::this_thread::sleep_for(std::chrono::milliseconds(intervalMs_));
     }
+
+    flaggedExits_.Close();
+    flaggedProcesses_.clear();
+    processEvents_.Close();
 }
 
-std::vector<ProcessInfo> ProcessWatcher::GetRunningProcesses() {
-    std::vector<ProcessInfo> processes;
+void ProcessWatcher::CheckBlacklist() {
+    auto published = PublishReport();
+    TrackFlaggedProcesses(published->value);
+    auto blacklisted = FilterBlacklistedProcesses(published->value.processes);
 
-#ifdef _WIN32
-    HANDLE hSnapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
-    if (hSnapshot == INVALID_HANDLE_VALUE) {
-        return processes;
+    bool currentState = !blacklisted.empty();
+
+    // Compare identities, not counts: one blacklisted process exiting while
+    // another starts in the same tick is still a change
+    blacklistDeltas_.Record(published->generation, blacklisted);
+    ProcessDelta delta = blacklistDeltas_.Diff(lastBlacklistGeneration_, published->generation, blacklisted);
+    lastBlacklistGeneration_ = published->generation;
+
+    if (currentState != lastDetectionState_ || delta.fullResync || !delta.Empty()) {
+        EmitDetectionEvent(currentState, blacklisted, delta);
+        lastDetectionState_ = currentState;
+        lastBlacklistedProcesses_ = blacklisted;
     }
+}
 
-    PROCESSENTRY32W pe32;
-    pe32.dwSize = sizeof(PROCESSENTRY32W);
+void ProcessWatcher::TrackFlaggedProcesses(const ProcessReport& report) {
+    if (!flaggedExits_.IsOpen()) {
+        return;
+    }
 
-    if (Process32FirstW(hSnapshot, &pe32)) {
-        do {
-            std::wstring wProcessName(pe32.szExeFile);
-            std::string processName = WideStringToUtf8(wProcessName);
-            std::string processPath = GetProcessPath(pe32.th32ProcessID);
+    std::unordered_map<int, const ProcessInfo*> flagged;
+    for (size_t index : report.suspiciousIndices) {
+        flagged[report.processes[index].pid] = &report.processes[index];
+    }
+
+    // Clear processes that are no longer flagged: gone from the table (the proc
+    // connector or a rescan saw the exit first), pid reused, or reclassified
+    for (auto it = flaggedProcesses_.begin(); it != flaggedProcesses_.end();) {
+        auto current = flagged.find(it->first);
+        if (current == flagged.end() || current->second->startTime != it->second.startTime) {
+            auto listed = std::lower_bound(report.processes.begin(), report.processes.end(), it->first,
+                                           [](const ProcessInfo& process, int pid) { return process.pid < pid; });
+            bool stillRunning = listed != report.processes.end() && listed->pid == it->first &&
+                                listed->startTime == it->second.startTime;
+            EmitThreatClearedEvent(it->second, stillRunning ? "reclassified" : "exited");
+            flaggedExits_.Unwatch(it->first);
+            it = flaggedProcesses_.erase(it);
+        } else {
+            ++it;
+        }
+    }
 
-            processes.emplace_back(pe32.th32ProcessID, processName, processPath);
-        } while (Process32NextW(hSnapshot, &pe32));
+    for (const auto& entry : flagged) {
+        if (flaggedProcesses_.find(entry.first) == flaggedProcesses_.end() &&
+            flaggedExits_.Watch(entry.first, entry.second->startTime)) {
+            flaggedProcesses_.emplace(entry.first, *entry.second);
+        }
     }
+}
 
-    CloseHandle(hSnapshot);
+void ProcessWatcher::ClearExitedThreats(const std::vector<int>& exitedPids) {
+    std::vector<int> cleared;
+    for (int pid : exitedPids) {
+        auto it = flaggedProcesses_.find(pid);
+        if (it == flaggedProcesses_.end()) continue;
 
-#elif __APPLE__
-    int numberOfProcesses = proc_listallpids(nullptr, 0);
-    if (numberOfProcesses <= 0) {
-        return processes;
+        EmitThreatClearedEvent(it->second, "exited");
+        flaggedProcesses_.erase(it);
+        cleared.push_back(pid);
     }
 
-    std::vector<pid_t> pids(numberOfProcesses);
-    numberOfProcesses = proc_listallpids(pids.data(), numberOfProcesses * sizeof(pid_t));
+#ifdef __linux__
+    // Patch the shared table rather than walking /proc again
+    if (!cleared.empty()) {
+        ProcessTable::Instance().ApplyEvents({}, cleared);
+        CheckBlacklist();
+    }
+#endif
+}
 
-    for (int i = 0; i < numberOfProcesses; i++) {
-        pid_t pid = pids[i];
-        if (pid <= 0) continue;
+void ProcessWatcher::EmitThreatClearedEvent(const ProcessInfo& process, const char* reason) {
+    std::time_t now = std::time(nullptr);
 
-        char pathBuffer[PROC_PIDPATHINFO_MAXSIZE];
-        int ret = proc_pidpath(pid, pathBuffer, sizeof(pathBuffer));
+    std::ostringstream json;
+    json << "{"
+         << "\"module\": \"process-watch\","
+         << "\"eventType\": \"threat-cleared\","
+         << "\"reason\": \"" << reason << "\","
+         << "\"pid\": " << process.pid << ","
+         << "\"name\": \"" << EscapeJson(process.name) << "\","
+         << "\"path\": \"" << EscapeJson(process.path) << "\","
+         << "\"category\": " << process.category << ","
+         << "\"threatLevel\": " << process.threatLevel << ","
+         << "\"ts\": " << (now * 1000) << ","
+         << "\"count\": " << counter_.load() << ","
+         << "\"source\": \"native\""
+         << "}";
 
-        if (ret > 0) {
-            std::string fullPath(pathBuffer);
-            std::string processName = ExtractProcessName(fullPath);
+    std::string json_str = json.str();
 
-            processes.emplace_back(pid, processName, fullPath);
-        }
+    if (tsfn_) {
+        tsfn_.NonBlockingCall([json_str](Napi::Env env, Napi::Function callback) {
+            callback.Call({Napi::String::New(env, json_str)});
+        });
     }
-#endif
+}
 
-    return processes;
+std::vector<ProcessInfo> ProcessWatcher::GetRunningProcesses() {
+    // Shared with ScreenWatcher/VMDetector; only walks the process list if the
+    // published snapshot is older than one tick
+    auto snapshot = ProcessTable::Instance().Acquire();
+    return snapshot->processes;
 }
 
 std::vector<ProcessInfo> ProcessWatcher::FilterBlacklistedProcesses(const std::vector<ProcessInfo>& processes) {
     std::vector<ProcessInfo> blacklisted;
+    auto matcher = std::atomic_load(&blacklistMatcher_);
 
     for (const auto& proc : processes) {
-        for (const auto& blacklistItem : blacklist_) {
-            if (proc.name.find(blacklistItem) != std::string::npos ||
-                proc.path.find(blacklistItem) != std::string::npos) {
-                blacklisted.push_back(proc);
-                break;
-            }
+        if (matcher->Contains(proc.name) || matcher->Contains(proc.path)) {
+            blacklisted.push_back(proc);
         }
     }
 
     return blacklisted;
 }
 
-void ProcessWatcher::EmitDetectionEvent(bool detected, const std::vector<ProcessInfo>& blacklistedProcesses) {
+void ProcessWatcher::EmitDetectionEvent(bool detected, const std::vector<ProcessInfo>& blacklistedProcesses,
+                                        const ProcessDelta& delta) {
     std::time_t now = std::time(nullptr);
 
+    auto writeProcess = [this](std::ostringstream& out, const ProcessInfo& process) {
+        out << "{"
+            << "\"pid\": " << process.pid << ","
+            << "\"name\": \"" << EscapeJson(process.name) << "\","
+            << "\"path\": \"" << EscapeJson(process.path) << "\","
+            << "\"category\": " << process.category << ","
+            << "\"threatLevel\": " << process.threatLevel
+            << "}";
+    };
+
     std::ostringstream json;
     json << "{"
          << "\"module\": \"process-watch\","
+         << "\"eventType\": \"" << (delta.fullResync ? "resync" : "delta") << "\","
+         << "\"fromGeneration\": " << delta.fromGeneration << ","
+         << "\"generation\": " << delta.toGeneration << ","
          << "\"blacklisted_found\": " << (detected ? "true" : "false") << ","
          << "\"matches\": [";
 
+    // Full match list is kept for existing consumers; it is small compared with
+    // the process table
     for (size_t i = 0; i < blacklistedProcesses.size(); i++) {
         if (i > 0) json << ",";
-        json << "{"
-             << "\"pid\": " << blacklistedProcesses[i].pid << ","
-             << "\"name\": \"" << EscapeJson(blacklistedProcesses[i].name) << "\","
-             << "\"path\": \"" << EscapeJson(blacklistedProcesses[i].path) << "\""
-             << "}";
+        writeProcess(json, blacklistedProcesses[i]);
+    }
+
+    json << "],\"added\": [";
+    for (size_t i = 0; i < delta.added.size(); i++) {
+        if (i > 0) json << ",";
+        writeProcess(json, delta.added[i]);
+    }
+
+    json << "],\"removed\": [";
+    for (size_t i = 0; i < delta.removed.size(); i++) {
+        if (i > 0) json << ",";
+        json << "{\"pid\": " << delta.removed[i].pid << "}";
+    }
+
+    json << "],\"reclassified\": [";
+    for (size_t i = 0; i < delta.reclassified.size(); i++) {
+        if (i > 0) json << ",";
+        writeProcess(json, delta.reclassified[i].process);
     }
 
     json << "],"
@@ -613,6 +802,110 @@ void ProcessWatcher::InitializeVPNPatterns() {
     vpnPatterns_.insert("zenmate");
 }
 
+// Substring keywords per category, in the order categories have always been
+// checked; when several categories match a name the first one listed wins
+struct CategoryKeywords {
+    ProcessCategory category;
+    const char* tag;
+    std::vector<const char*> keywords;
+};
+
+static const std::vector<CategoryKeywords>& CategoryKeywordTable() {
+    static const std::vector<CategoryKeywords> table = {
+        {ProcessCategory::AI_TOOL, "ai-tool", {"chatgpt", "claude", "gemini", "copilot"}},
+        {ProcessCategory::BROWSER, "browser", {"chrome", "firefox", "safari", "edge"}},
+        {ProcessCategory::SCREEN_SHARING, "screen-sharing", {"zoom", "teams", "meet", "webex"}},
+        {ProcessCategory::REMOTE_ACCESS, "remote-access", {"teamviewer", "anydesk", "rdp", "vnc"}},
+        {ProcessCategory::VPN_TOOL, "vpn", {"vpn", "nordvpn", "expressvpn"}},
+        {ProcessCategory::DEVELOPMENT, "development", {"code", "studio", "terminal", "cmd", "powershell"}},
+        {ProcessCategory::VIRTUAL_MACHINE, "virtual-machine", {"vmware", "virtualbox", "parallels"}},
+        {ProcessCategory::RECORDING, "recording", {"obs", "camtasia", "bandicam", "fraps"}},
+    };
+    return table;
+}
+
+static const char* CategoryTag(ProcessCategory category) {
+    for (const auto& entry : CategoryKeywordTable()) {
+        if (entry.category == category) return entry.tag;
+    }
+    switch (category) {
+        case ProcessCategory::COMMUNICATION: return "communication";
+        case ProcessCategory::OVERLAY_TOOL: return "overlay";
+        default: return "safe";
+    }
+}
+
+void ProcessWatcher::BuildClassifier() {
+    auto classifier = std::make_shared<CompiledClassifier>();
+
+    // A name listed in several tables keeps its first (highest priority) rule
+    std::set<std::string> ruleIds;
+    auto addRule = [&classifier, &ruleIds](const std::string& pattern, ClassifierRule rule) {
+        if (!ruleIds.insert(rule.id).second) return;
+        classifier->matcher.Add(pattern, static_cast<int>(classifier->rules.size()));
+        classifier->rules.push_back(std::move(rule));
+    };
+
+    // Exact entries from the comprehensive blacklist take precedence over keywords
+    for (const auto& entry : comprehensiveBlacklist_) {
+        addRule(entry.first, {std::string(CategoryTag(entry.second)) + ":=" + entry.first,
+                              true, 0, true, entry.second, false, ThreatLevel::NONE});
+    }
+
+    for (const auto& entry : threatDatabase_) {
+        addRule(entry.first, {"threat:=" + entry.first,
+                              true, 0, false, ProcessCategory::SAFE, true, entry.second});
+    }
+
+    const std::map<ProcessCategory, const std::set<std::string>*> exactSets = {
+        {ProcessCategory::AI_TOOL, &aiToolPatterns_},
+        {ProcessCategory::BROWSER, &browserExtensionPatterns_},
+        {ProcessCategory::SCREEN_SHARING, &screenSharingPatterns_},
+        {ProcessCategory::REMOTE_ACCESS, &remoteAccessPatterns_},
+        {ProcessCategory::VPN_TOOL, &vpnPatterns_},
+    };
+
+    int priority = 1;
+    for (const auto& entry : CategoryKeywordTable()) {
+        auto set = exactSets.find(entry.category);
+        if (set != exactSets.end()) {
+            for (const auto& pattern : *set->second) {
+                addRule(pattern, {std::string(entry.tag) + ":=" + pattern,
+                                  true, priority, true, entry.category, false, ThreatLevel::NONE});
+            }
+        }
+        for (const char* keyword : entry.keywords) {
+            addRule(keyword, {std::string(entry.tag) + ":" + keyword,
+                              false, priority, true, entry.category, false, ThreatLevel::NONE});
+        }
+        priority++;
+    }
+
+    classifier->matcher.Compile();
+    std::atomic_store(&classifier_, std::shared_ptr<const CompiledClassifier>(classifier));
+    ruleGeneration_++;
+}
+
+void ProcessWatcher::BuildBlacklistMatcher() {
+    auto matcher = std::make_shared<PatternMatcher>();
+    int ruleId = 0;
+    for (const auto& item : blacklist_) {
+        matcher->Add(item, ruleId++);
+    }
+    matcher->Compile();
+    std::atomic_store(&blacklistMatcher_, std::shared_ptr<const PatternMatcher>(matcher));
+}
+
+void ProcessWatcher::BuildRecordingMatcher() {
+    auto matcher = std::make_shared<PatternMatcher>();
+    int ruleId = 0;
+    for (const auto& item : recordingBlacklist_) {
+        matcher->Add(item, ruleId++);
+    }
+    matcher->Compile();
+    std::atomic_store(&recordingMatcher_, std::shared_ptr<const PatternMatcher>(matcher));
+}
+
 RecordingDetectionResult ProcessWatcher::DetectRecordingAndOverlays() {
     RecordingDetectionResult result;
     result.isRecording = false;
@@ -620,9 +913,17 @@ RecordingDetectionResult ProcessWatcher::DetectRecordingAndOverlays() {
     result.overlayConfidence = 0.0;
 
     try {
-        auto processes = GetRunningProcesses();
+        auto snapshot = ProcessTable::Instance().Acquire();
 
-        result.recordingSources = DetectRecordingProcesses(processes);
+        // Queued import analysis is otherwise only advanced by report getters
+        if (!running_.load()) {
+            AdvanceContentScans();
+        }
+        result.recordingSources = DetectRecordingProcesses(snapshot->processes);
+        moduleInventory_.Sweep(snapshot->processes);
+        resourceSampler_.Sweep(snapshot->processes);
+        fdInventory_.Sweep(snapshot->processes);
+        elfImports_.Sweep(snapshot->processes);
 
         result.virtualCameras = GetVirtualCameras();
 
@@ -657,7 +958,8 @@ std::vector<OverlayWindow> ProcessWatcher::DetectOverlayWindows() {
 #ifdef _WIN32
     // Process-centric overlay detection focuses on windows created by suspicious processes
     // This complements ScreenWatcher's window-centric overlay detection
-    std::vector<ProcessInfo> currentProcesses = GetRunningProcesses();
+    auto snapshot = ProcessTable::Instance().Acquire();
+    const std::vector<ProcessInfo>& currentProcesses = snapshot->processes;
 
     // First, identify suspicious processes that might create overlays
     std::vector<ProcessInfo> suspiciousProcesses;
@@ -817,19 +1119,21 @@ std::vector<OverlayWindow> ProcessWatcher::DetectOverlayWindows() {
 
 std::vector<ProcessInfo> ProcessWatcher::DetectRecordingProcesses(const std::vector<ProcessInfo>& processes) {
     std::vector<ProcessInfo> recordingProcesses;
+    auto matcher = std::atomic_load(&recordingMatcher_);
+
+    // Module enumeration dominates; fan it out per process and keep results in
+    // snapshot order
+    std::vector<ProcessInfo> analyzed(processes);
+    std::vector<char> keep(processes.size(), 0);
 
-    for (auto& process : processes) {
-        ProcessInfo recordingProcess = process;
+    WorkStealingPool::Instance().ParallelFor(processes.size(), [&](size_t index) {
+        const ProcessInfo& process = processes[index];
+        ProcessInfo& recordingProcess = analyzed[index];
         recordingProcess.evidence.clear();
 
-        bool isBlacklisted = false;
-        for (const auto& blacklistItem : recordingBlacklist_) {
-            if (process.name.find(blacklistItem) != std::string::npos ||
-                process.path.find(blacklistItem) != std::string::npos) {
-                recordingProcess.evidence.push_back("blacklist");
-                isBlacklisted = true;
-                break;
-            }
+        bool isBlacklisted = matcher->Contains(process.name) || matcher->Contains(process.path);
+        if (isBlacklisted) {
+            recordingProcess.evidence.push_back("blacklist");
         }
 
         try {
@@ -837,12 +1141,39 @@ std::vector<ProcessInfo> ProcessWatcher::DetectRecordingProcesses(const std::vec
             recordingProcess.loadedModules = GetProcessModules(process.pid);
 #elif __APPLE__
             recordingProcess.loadedModules = GetProcessLibraries(process.pid);
+#elif __linux__
+            recordingProcess.loadedModules = moduleInventory_.Modules(process.pid, process.startTime);
 #endif
 
+#ifdef __linux__
+            // X11/XShm is mapped by every X client, so it only counts next to an encoder
+            bool hasX11Capture = false;
+            bool hasEncoder = false;
+            bool hasV4l = false;
+#endif
             for (const auto& module : recordingProcess.loadedModules) {
                 std::string lowerModule = module;
                 std::transform(lowerModule.begin(), lowerModule.end(), lowerModule.begin(), ::tolower);
 
+#ifdef __linux__
+                size_t lastSlash = lowerModule.find_last_of('/');
+                if (lastSlash != std::string::npos) {
+                    lowerModule.erase(0, lastSlash + 1);
+                }
+
+                if (lowerModule.compare(0, 6, "libobs") == 0) {
+                    recordingProcess.evidence.push_back("module-obs");
+                } else if (lowerModule.compare(0, 12, "libpipewire-") == 0) {
+                    recordingProcess.evidence.push_back("module-pipewire");
+                } else if (lowerModule.compare(0, 10, "libavcodec") == 0) {
+                    recordingProcess.evidence.push_back("module-avcodec");
+                    hasEncoder = true;
+                } else if (lowerModule.compare(0, 7, "libx11.") == 0 || lowerModule.compare(0, 8, "libxext.") == 0) {
+                    hasX11Capture = true;
+                } else if (lowerModule.compare(0, 6, "libv4l") == 0) {
+                    hasV4l = true;
+                }
+#else
                 if (lowerModule.find("dxgi") != std::string::npos) {
                     recordingProcess.evidence.push_back("module-dxgi");
                 } else if (lowerModule.find("d3d11") != std::string::npos || lowerModule.find("d3d9") != std::string::npos) {
@@ -854,12 +1185,49 @@ std::vector<ProcessInfo> ProcessWatcher::DetectRecordingProcesses(const std::vec
                 } else if (lowerModule.find("screencapturekit") != std::string::npos) {
                     recordingProcess.evidence.push_back("module-screencapturekit");
                 }
+#endif
             }
+
+#ifdef __linux__
+            if (hasX11Capture && hasEncoder) {
+                recordingProcess.evidence.push_back("module-xshm");
+            }
+
+            // Separates an idle capture-capable app from one that is encoding;
+            // only candidates with capture modules are sampled
+            bool hasCaptureModule = recordingProcess.evidence.size() > (isBlacklisted ? 1u : 0u);
+            if (hasCaptureModule) {
+                ResourceRates rates = resourceSampler_.Sample(process.pid, process.startTime);
+                if (rates.busySamples >= 2) {
+                    recordingProcess.evidence.push_back("cpu-sustained");
+                }
+                if (rates.ioActiveSamples >= 2) {
+                    recordingProcess.evidence.push_back("io-sustained");
+                }
+            }
+
+            // Who actually holds capture, camera or uinput handles; the fd walk is
+            // limited to candidates and cached per (fd, inode). Static imports
+            // catch tools that dlopen their capture libraries only when recording.
+            recordingProcess.capabilities = elfImports_.Lookup(process);
+            bool capableBinary = (recordingProcess.capabilities &
+                                  (kCapabilityScreenCapture | kCapabilityCamera | kCapabilityInputInjection)) != 0;
+            if (!recordingProcess.evidence.empty() || hasV4l || capableBinary) {
+                FdHandleSummary handles = fdInventory_.Scan(process.pid, process.startTime);
+                for (const auto& handle : handles.handles) {
+                    recordingProcess.evidence.push_back("fd-" + handle);
+                }
+            }
+#endif
         } catch (...) {
         }
 
-        if (isBlacklisted || !recordingProcess.evidence.empty()) {
-            recordingProcesses.push_back(recordingProcess);
+        keep[index] = isBlacklisted || !recordingProcess.evidence.empty();
+    });
+
+    for (size_t i = 0; i < analyzed.size(); i++) {
+        if (keep[i]) {
+            recordingProcesses.push_back(std::move(analyzed[i]));
         }
     }
 
@@ -870,15 +1238,41 @@ double ProcessWatcher::CalculateRecordingConfidence(const std::vector<ProcessInf
     double confidence = 0.0;
 
     for (const auto& process : recordingProcesses) {
+        // Browsers and media players map PipeWire and libavcodec too; on Linux
+        // those tags only count for a process that is also busy or holds a
+        // capture or camera handle
+        bool active = false;
+        for (const auto& evidence : process.evidence) {
+            if (evidence == "cpu-sustained" || evidence.compare(0, 11, "fd-capture:") == 0 ||
+                evidence.compare(0, 10, "fd-camera:") == 0) {
+                active = true;
+                break;
+            }
+        }
+
         for (const auto& evidence : process.evidence) {
             if (evidence == "blacklist") {
                 confidence += 0.6;
-            } else if (evidence == "module-dxgi" || evidence == "module-screencapturekit") {
+            } else if (evidence == "module-dxgi" || evidence == "module-screencapturekit" ||
+                       evidence == "module-obs") {
                 confidence += 0.8;
             } else if (evidence == "module-d3d" || evidence == "module-avfoundation") {
                 confidence += 0.25;
             } else if (evidence == "module-mediafoundation") {
                 confidence += 0.25;
+            } else if (evidence == "module-pipewire" || evidence == "module-avcodec" ||
+                       evidence == "module-xshm") {
+                if (active) {
+                    confidence += 0.25;
+                }
+            } else if (evidence == "cpu-sustained") {
+                confidence += 0.3;
+            } else if (evidence == "io-sustained") {
+                confidence += 0.15;
+            } else if (evidence.compare(0, 10, "fd-camera:") == 0) {
+                confidence += 0.3;
+            } else if (evidence.compare(0, 11, "fd-capture:") == 0) {
+                confidence += 0.1;
             }
         }
     }
@@ -1249,8 +1643,8 @@ std::vector<std::string> ProcessWatcher::EnumerateVirtualCameras() {
         "Reincubate Camo"
     };
 
-    auto processes = GetRunningProcesses();
-    for (const auto& process : processes) {
+    auto snapshot = ProcessTable::Instance().Acquire();
+    for (const auto& process : snapshot->processes) {
         for (const auto& vcamProcess : vcamProcesses) {
             if (process.name.find(vcamProcess) != std::string::npos ||
                 process.path.find(vcamProcess) != std::string::npos) {
@@ -1264,6 +1658,16 @@ std::vector<std::string> ProcessWatcher::EnumerateVirtualCameras() {
     return virtualCameras;
 }
 
+#elif __linux__
+
+std::vector<OverlayWindow> ProcessWatcher::EnumerateWindowsForOverlays() {
+    return std::vector<OverlayWindow>();
+}
+
+std::vector<std::string> ProcessWatcher::EnumerateVirtualCameras() {
+    return std::vector<std::string>();
+}
+
 #endif
 
 std::vector<std::string> ProcessWatcher::GetVirtualCameras() {
@@ -1344,96 +1748,114 @@ std::string ProcessWatcher::CreateRecordingOverlayEventJson(const RecordingDetec
     return json.str();
 }
 
-ProcessCategory ProcessWatcher::CategorizeProcess(const ProcessInfo& process) {
-    std::string lowerName = process.name;
-    std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(), ::tolower);
-
-    std::string lowerPath = process.path;
-    std::transform(lowerPath.begin(), lowerPath.end(), lowerPath.begin(), ::tolower);
+ProcessClassification ProcessWatcher::MatchClassifier(const ProcessInfo& process) {
+    ProcessClassification result;
+    auto classifier = std::atomic_load(&classifier_);
 
-    // Check comprehensive blacklist first
-    auto it = comprehensiveBlacklist_.find(lowerName);
-    if (it != comprehensiveBlacklist_.end()) {
-        return it->second;
-    }
+    int bestPriority = -1;
+    bool hasThreatLevel = false;
+    std::vector<bool> seen(classifier->rules.size(), false);
+    const size_t nameLength = process.name.size();
 
-    // Pattern-based detection for unlisted processes
-    if (aiToolPatterns_.count(lowerName) ||
-        lowerName.find("chatgpt") != std::string::npos ||
-        lowerName.find("claude") != std::string::npos ||
-        lowerName.find("gemini") != std::string::npos ||
-        lowerName.find("copilot") != std::string::npos) {
-        return ProcessCategory::AI_TOOL;
-    }
+    classifier->matcher.Scan(process.name, [&](int ruleId, size_t start, size_t end) {
+        const ClassifierRule& rule = classifier->rules[ruleId];
+        if (seen[ruleId] || (rule.exact && (start != 0 || end != nameLength))) {
+            return;
+        }
+        seen[ruleId] = true;
+        result.ruleIds.push_back(rule.id);
 
-    if (browserExtensionPatterns_.count(lowerName) ||
-        lowerName.find("chrome") != std::string::npos ||
-        lowerName.find("firefox") != std::string::npos ||
-        lowerName.find("safari") != std::string::npos ||
-        lowerName.find("edge") != std::string::npos) {
-        return ProcessCategory::BROWSER;
-    }
+        if (rule.hasCategory && (bestPriority < 0 || rule.priority < bestPriority)) {
+            bestPriority = rule.priority;
+            result.category = rule.category;
+        }
+        if (rule.hasThreatLevel) {
+            hasThreatLevel = true;
+            result.threatLevel = rule.threatLevel;
+        }
+    });
 
-    if (screenSharingPatterns_.count(lowerName) ||
-        lowerName.find("zoom") != std::string::npos ||
-        lowerName.find("teams") != std::string::npos ||
-        lowerName.find("meet") != std::string::npos ||
-        lowerName.find("webex") != std::string::npos) {
-        return ProcessCategory::SCREEN_SHARING;
+    if (!hasThreatLevel) {
+        result.threatLevel = ThreatLevelForCategory(result.category);
     }
 
-    if (remoteAccessPatterns_.count(lowerName) ||
-        lowerName.find("teamviewer") != std::string::npos ||
-        lowerName.find("anydesk") != std::string::npos ||
-        lowerName.find("rdp") != std::string::npos ||
-        lowerName.find("vnc") != std::string::npos) {
-        return ProcessCategory::REMOTE_ACCESS;
-    }
+    return result;
+}
 
-    if (vpnPatterns_.count(lowerName) ||
-        lowerName.find("vpn") != std::string::npos ||
-        lowerName.find("nordvpn") != std::string::npos ||
-        lowerName.find("expressvpn") != std::string::npos) {
-        return ProcessCategory::VPN_TOOL;
+void ProcessWatcher::SweepRiskCache(const ProcessTableSnapshot& snapshot) {
+    // Only needed once per table generation; drops entries for exited pids
+    if (snapshot.generation == riskCacheTableGeneration_) {
+        return;
     }
-
-    // Development tools
-    if (lowerName.find("code") != std::string::npos ||
-        lowerName.find("studio") != std::string::npos ||
-        lowerName.find("terminal") != std::string::npos ||
-        lowerName.find("cmd") != std::string::npos ||
-        lowerName.find("powershell") != std::string::npos) {
-        return ProcessCategory::DEVELOPMENT;
+    riskCacheTableGeneration_ = snapshot.generation;
+
+    for (auto it = processRiskCache_.begin(); it != processRiskCache_.end();) {
+        auto found = std::lower_bound(snapshot.processes.begin(), snapshot.processes.end(), it->first,
+            [](const ProcessInfo& process, int pid) {
+                return process.pid < pid;
+            });
+        bool alive = found != snapshot.processes.end() && found->pid == it->first;
+        if (alive) {
+            ++it;
+        } else {
+            it = processRiskCache_.erase(it);
+        }
     }
+}
 
-    // Virtual machines
-    if (lowerName.find("vmware") != std::string::npos ||
-        lowerName.find("virtualbox") != std::string::npos ||
-        lowerName.find("parallels") != std::string::npos) {
-        return ProcessCategory::VIRTUAL_MACHINE;
+const ProcessWatcher::RiskCacheEntry& ProcessWatcher::LookupRiskCache(const ProcessInfo& process) {
+    RiskCacheEntry& entry = processRiskCache_[process.pid];
+    uint64_t rules = ruleGeneration_.load();
+
+    if (entry.ruleGeneration != rules || entry.startTime != process.startTime ||
+        entry.path != process.path || entry.name != process.name || entry.commandLine != process.commandLine) {
+        entry.startTime = process.startTime;
+        entry.path = process.path;
+        entry.name = process.name;
+        entry.commandLine = process.commandLine;
+        entry.ruleGeneration = rules;
+        entry.classification = MatchClassifier(process);
+
+        // Capture, remote-debugging and automation switches make any process at
+        // least suspicious, whatever its name says
+        if (process.commandLine) {
+            std::vector<std::string> flags = CommandLineFlagMatcher::Instance().Scan(*process.commandLine);
+            if (!flags.empty()) {
+                auto& ruleIds = entry.classification.ruleIds;
+                ruleIds.insert(ruleIds.end(), flags.begin(), flags.end());
+                entry.classification.threatLevel = std::max(entry.classification.threatLevel, ThreatLevel::MEDIUM);
+            }
+        }
+        entry.riskReason = GenerateRiskReason(process, entry.classification.category,
+                                              entry.classification.threatLevel);
     }
 
-    // Recording tools
-    if (lowerName.find("obs") != std::string::npos ||
-        lowerName.find("camtasia") != std::string::npos ||
-        lowerName.find("bandicam") != std::string::npos ||
-        lowerName.find("fraps") != std::string::npos) {
-        return ProcessCategory::RECORDING;
-    }
+    return entry;
+}
 
-    return ProcessCategory::SAFE;
+ProcessCategory ProcessWatcher::CategorizeProcess(const ProcessInfo& process) {
+    return MatchClassifier(process).category;
 }
 
-ThreatLevel ProcessWatcher::CalculateThreatLevel(const ProcessInfo& process, ProcessCategory category) {
+ThreatLevel ProcessWatcher::CalculateThreatLevel(const ProcessInfo& process, ProcessCategory category,
+                                                 ProcessCategory endpointCategory) {
     std::string lowerName = process.name;
     std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(), ::tolower);
 
     // Check threat database first
+    ThreatLevel level;
     auto it = threatDatabase_.find(lowerName);
     if (it != threatDatabase_.end()) {
-        return it->second;
+        level = it->second;
+    } else {
+        level = ThreatLevelForCategory(category);
     }
 
+    // Talking to a known AI or remote-access range raises any name
+    return std::max(level, ThreatLevelForCategory(endpointCategory));
+}
+
+ThreatLevel ProcessWatcher::ThreatLevelForCategory(ProcessCategory category) {
     // Category-based threat levels
     switch (category) {
         case ProcessCategory::AI_TOOL:
@@ -1463,6 +1885,10 @@ ThreatLevel ProcessWatcher::CalculateThreatLevel(const ProcessInfo& process, Pro
 }
 
 bool ProcessWatcher::HasScreenCaptureCapability(const ProcessInfo& process) {
+    if (process.capabilities & kCapabilityScreenCapture) {
+        return true;
+    }
+
     std::string lowerName = process.name;
     std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(), ::tolower);
 
@@ -1484,6 +1910,11 @@ bool ProcessWatcher::HasScreenCaptureCapability(const ProcessInfo& process) {
             lowerModule.find("avfoundation") != std::string::npos) {
             return true;
         }
+#elif __linux__
+        if (lowerModule.find("libpipewire-") != std::string::npos ||
+            lowerModule.find("libobs") != std::string::npos) {
+            return true;
+        }
 #endif
     }
 
@@ -1495,6 +1926,10 @@ bool ProcessWatcher::HasScreenCaptureCapability(const ProcessInfo& process) {
 }
 
 bool ProcessWatcher::HasRemoteAccessCapability(const ProcessInfo& process) {
+    if (process.capabilities & (kCapabilityRemoteAccess | kCapabilityInputInjection)) {
+        return true;
+    }
+
     std::string lowerName = process.name;
     std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(), ::tolower);
 
@@ -1576,53 +2011,543 @@ std::string ProcessWatcher::GenerateRiskReason(const ProcessInfo& process, Proce
     return reason;
 }
 
+std::vector<NetworkPattern> ProcessWatcher::DetectNetworkPatterns() {
+    std::lock_guard<std::mutex> lock(networkMutex_);
+
+    auto now = std::chrono::steady_clock::now();
+    if (now - lastNetworkScan_ < std::chrono::milliseconds(kNetworkScanMinIntervalMs)) {
+        return networkPatterns_;
+    }
+
+    networkPatterns_ = ScanNetworkConnections();
+    lastNetworkScan_ = now;
+    return networkPatterns_;
+}
+
+int ProcessWatcher::EndpointCategoryFromName(const std::string& name) {
+    std::string lower = name;
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+    if (lower == "ai_tool") return static_cast<int>(ProcessCategory::AI_TOOL);
+    if (lower == "screen_sharing") return static_cast<int>(ProcessCategory::SCREEN_SHARING);
+    if (lower == "remote_access") return static_cast<int>(ProcessCategory::REMOTE_ACCESS);
+    if (lower == "vpn_tool") return static_cast<int>(ProcessCategory::VPN_TOOL);
+    return -1;
+}
+
+bool ProcessWatcher::ReadEndpointRanges(const std::string& path, size_t& ranges, size_t& rejected) {
+    struct stat info;
+    std::ifstream file(path, std::ios::binary);
+    if (!file || stat(path.c_str(), &info) != 0) {
+        return false;
+    }
+    std::stringstream text;
+    text << file.rdbuf();
+
+    auto trie = CidrTrie::Parse(text.str(), EndpointCategoryFromName, rejected);
+    ranges = trie->RangeCount();
+    std::atomic_store(&endpointRanges_, trie);
+    endpointRangesPath_ = path;
+    endpointRangesMtime_ = static_cast<long long>(info.st_mtime);
+    endpointRangesSize_ = static_cast<long long>(info.st_size);
+    return true;
+}
+
+bool ProcessWatcher::LoadEndpointRanges(const std::string& path, size_t& ranges, size_t& rejected) {
+    std::lock_guard<std::mutex> lock(endpointRangesMutex_);
+    ranges = 0;
+    rejected = 0;
+    return ReadEndpointRanges(path, ranges, rejected);
+}
+
+void ProcessWatcher::ReloadEndpointRangesIfChanged() {
+    std::lock_guard<std::mutex> lock(endpointRangesMutex_);
+    if (endpointRangesPath_.empty()) {
+        return;
+    }
+
+    // A file that vanished or fails to read keeps the ranges already loaded
+    struct stat info;
+    if (stat(endpointRangesPath_.c_str(), &info) != 0 ||
+        (static_cast<long long>(info.st_mtime) == endpointRangesMtime_ &&
+         static_cast<long long>(info.st_size) == endpointRangesSize_)) {
+        return;
+    }
+    size_t ranges = 0, rejected = 0;
+    ReadEndpointRanges(endpointRangesPath_, ranges, rejected);
+}
+
+bool ProcessWatcher::StartDomainObserver() {
+    return domainObserver_.Start();
+}
+
+void ProcessWatcher::StopDomainObserver() {
+    domainObserver_.Stop();
+    std::lock_guard<std::mutex> lock(networkMutex_);
+    domainMatches_.clear();
+}
+
+void ProcessWatcher::SetDomainRules(const std::vector<DomainRule>& rules) {
+    domainObserver_.SetRules(rules);
+}
+
+DomainObserverStats ProcessWatcher::GetDomainObserverStats() {
+    return domainObserver_.Stats();
+}
+
+// Loopback traffic never leaves the machine
+static bool IsLoopbackAddress(const std::string& address) {
+    return address.compare(0, 4, "127.") == 0 || address == "::1" || address.compare(0, 11, "::ffff:127.") == 0;
+}
+
+std::vector<NetworkPattern> ProcessWatcher::ScanNetworkConnections() {
+    std::vector<NetworkPattern> patterns;
+
+    ReloadEndpointRangesIfChanged();
+    auto endpoints = std::atomic_load(&endpointRanges_);
+
+    // The shared inventory, so ScreenWatcher's remote-session view costs no second dump
+    auto snapshot = ProcessTable::Instance().Acquire(kNetworkScanMinIntervalMs);
+    auto socketSnapshot = SocketInventory::Instance().Acquire(kNetworkScanMinIntervalMs);
+    std::vector<SocketEntry> sockets = socketSnapshot->sockets;
+
+    // Names seen on the wire since the last scan, tied to the socket that sent
+    // them. A DNS socket closed before this scan cannot be attributed.
+    std::vector<DomainHit> hits;
+    domainObserver_.Drain(hits);
+    for (const auto& hit : hits) {
+        // SNI is only read from TCP and DNS only from UDP
+        SocketEntry::Protocol protocol =
+            hit.source == DomainHit::Source::Sni ? SocketEntry::Protocol::Tcp : SocketEntry::Protocol::Udp;
+        for (const auto& socket : sockets) {
+            if (socket.protocol != protocol || socket.localPort != hit.localPort || socket.inode == 0) continue;
+            bool sameRemote = socket.remotePort == hit.remotePort && memcmp(socket.remoteBytes, hit.remoteBytes, 16) == 0;
+            if (!sameRemote && (socket.IsConnected() || protocol == SocketEntry::Protocol::Tcp)) continue;
+
+            NetworkEndpointMatch match;
+            match.source = hit.source == DomainHit::Source::Sni ? "sni" : "dns";
+            match.remoteAddress = socket.remoteAddress;
+            match.category = static_cast<ProcessCategory>(hit.category);
+            match.label = hit.label;
+            match.domain = hit.name;
+            domainMatches_[socket.inode] = std::move(match);
+            break;
+        }
+    }
+    if (!domainMatches_.empty()) {
+        std::set<unsigned long long> live;
+        for (const auto& socket : sockets) live.insert(socket.inode);
+        for (auto it = domainMatches_.begin(); it != domainMatches_.end();) {
+            it = live.count(it->first) ? std::next(it) : domainMatches_.erase(it);
+        }
+    }
+
+    // Rates are per interval between the counter samples, not between scans
+    uint64_t nowMs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        socketSnapshot->capturedAt.time_since_epoch()).count());
+
+    // One pattern per owning process, in pid order
+    std::stable_sort(sockets.begin(), sockets.end(),
+                     [](const SocketEntry& a, const SocketEntry& b) { return a.pid < b.pid; });
+
+    for (size_t i = 0; i < sockets.size();) {
+        int pid = sockets[i].pid;
+        size_t end = i;
+        while (end < sockets.size() && sockets[end].pid == pid) end++;
+        if (pid == 0) {
+            i = end;
+            continue;
+        }
+
+        auto process = std::lower_bound(snapshot->processes.begin(), snapshot->processes.end(), pid,
+                                        [](const ProcessInfo& p, int value) { return p.pid < value; });
+        NetworkPattern pattern;
+        pattern.pid = pid;
+        if (process != snapshot->processes.end() && process->pid == pid) {
+            pattern.processName = process->name;
+        }
+
+        std::set<std::string> remotes;
+        for (size_t j = i; j < end; j++) {
+            SocketEntry& socket = sockets[j];
+            pattern.bytesTransferred += socket.bytesSent + socket.bytesReceived;
+
+            // sock_diag has byte counters for TCP only (tcp_info); UDP sockets carry none
+            if (socket.protocol == SocketEntry::Protocol::Tcp && socket.inode != 0 && socket.IsConnected()) {
+                FlowRates rates = flowRates_.Update(socket.inode, nowMs, socket.bytesSent, socket.bytesReceived);
+                pattern.uploadBitsPerSecond += rates.uploadBitsPerSecond;
+                pattern.downloadBitsPerSecond += rates.downloadBitsPerSecond;
+                if (rates.sustainedUploadBitsPerSecond > pattern.sustainedUploadBitsPerSecond) {
+                    pattern.sustainedUploadBitsPerSecond = rates.sustainedUploadBitsPerSecond;
+                    pattern.burstiness = rates.burstiness;
+                }
+            }
+            if (socket.IsConnected() && !IsLoopbackAddress(socket.remoteAddress)) {
+                bool v6 = socket.remoteAddress.find(':') != std::string::npos;
+                bool added = remotes.insert((v6 ? "[" + socket.remoteAddress + "]" : socket.remoteAddress) + ":" +
+                                            std::to_string(socket.remotePort)).second;
+                const CidrTrie::Range* range = (added && endpoints) ? endpoints->Lookup(socket.remoteBytes) : nullptr;
+                if (range) {
+                    NetworkEndpointMatch match;
+                    match.source = "range";
+                    match.remoteAddress = socket.remoteAddress;
+                    match.category = static_cast<ProcessCategory>(range->tag);
+                    match.label = range->label;
+                    match.cidr = range->cidr;
+                    pattern.endpointMatches.push_back(std::move(match));
+                }
+            }
+            auto named = socket.inode != 0 ? domainMatches_.find(socket.inode) : domainMatches_.end();
+            if (named != domainMatches_.end() &&
+                std::none_of(pattern.endpointMatches.begin(), pattern.endpointMatches.end(),
+                             [&](const NetworkEndpointMatch& m) { return m.domain == named->second.domain; })) {
+                pattern.endpointMatches.push_back(named->second);
+            }
+            pattern.sockets.push_back(std::move(socket));
+        }
+        pattern.remoteAddresses.assign(remotes.begin(), remotes.end());
+
+        pattern.isWebRTC = IsWebRTCConnection(pattern);
+        pattern.isVPN = IsVPNConnection(pattern);
+        pattern.isVideoStream = IsVideoStreamTraffic(pattern);
+        patterns.push_back(std::move(pattern));
+        i = end;
+    }
+
+    flowRates_.Expire(nowMs - kFlowExpiryMs);
+    return patterns;
+}
+
+bool ProcessWatcher::IsVideoStreamTraffic(const NetworkPattern& pattern) {
+    // RTMP/RTMPS ingest and RTSP are only used to push or pull live video
+    static const uint16_t kStreamingPorts[] = {1935, 1936, 554, 8554};
+    for (const auto& socket : pattern.sockets) {
+        if (!socket.IsConnected() || IsLoopbackAddress(socket.remoteAddress)) continue;
+        if (socket.protocol == SocketEntry::Protocol::Tcp &&
+            std::find(std::begin(kStreamingPorts), std::end(kStreamingPorts), socket.remotePort) != std::end(kStreamingPorts)) {
+            return true;
+        }
+    }
+
+    // Screen sharing pushes a steady 1-5 Mbit/s: one flow that never dropped
+    // below the floor across its sample ring, without the on/off shape of
+    // uploads and sync clients
+    const double kStreamFloorBps = 500.0 * 1000;
+    const double kStreamCeilingBps = 25.0 * 1000 * 1000;
+    const double kMaxStreamBurstiness = 1.0;
+    return pattern.sustainedUploadBitsPerSecond >= kStreamFloorBps &&
+           pattern.uploadBitsPerSecond <= kStreamCeilingBps && pattern.burstiness <= kMaxStreamBurstiness;
+}
+
+bool ProcessWatcher::IsWebRTCConnection(const NetworkPattern& pattern) {
+    for (const auto& socket : pattern.sockets) {
+        // STUN/TURN servers, including Google's public STUN range
+        uint16_t port = socket.remotePort;
+        if (socket.IsConnected() && (port == 3478 || port == 3479 || port == 5349 || (port >= 19302 && port <= 19309))) {
+            return true;
+        }
+
+        // ICE host candidates: UDP bound to one interface address on an ephemeral
+        // port; ordinary UDP clients bind the wildcard address
+        if (socket.protocol == SocketEntry::Protocol::Udp && !socket.IsConnected() && socket.localPort >= 32768 &&
+            socket.localAddress != "0.0.0.0" && socket.localAddress != "::" &&
+            !IsLoopbackAddress(socket.localAddress) && socket.localAddress.compare(0, 5, "fe80:") != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ProcessWatcher::IsVPNConnection(const NetworkPattern& pattern) {
+    std::string lowerName = pattern.processName;
+    std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(), ::tolower);
+    if (vpnPatterns_.count(lowerName) > 0) {
+        return true;
+    }
+    for (const auto& match : pattern.endpointMatches) {
+        if (match.category == ProcessCategory::VPN_TOOL) return true;
+    }
+
+    // OpenVPN, WireGuard, IKE/IPsec NAT-T, L2TP and PPTP
+    for (const auto& socket : pattern.sockets) {
+        if (!socket.IsConnected() || IsLoopbackAddress(socket.remoteAddress)) continue;
+        uint16_t port = socket.remotePort;
+        if (port == 1194 || port == 51820 || port == 500 || port == 4500 || port == 1701 ||
+            (port == 1723 && socket.protocol == SocketEntry::Protocol::Tcp)) {
+            return true;
+        }
+    }
+    return false;
+}
+
 ThreatLevel ProcessWatcher::ClassifyProcess(const ProcessInfo& process) {
-    ProcessCategory category = CategorizeProcess(process);
-    return CalculateThreatLevel(process, category);
+    return MatchClassifier(process).threatLevel;
 }
 
 std::vector<ProcessInfo> ProcessWatcher::DetectSuspiciousBehavior() {
     std::vector<ProcessInfo> suspiciousProcesses;
-    std::vector<ProcessInfo> currentProcesses = GetRunningProcesses();
+    auto published = AcquireReport();
+    const ProcessReport& report = published->value;
+
+    for (size_t index : report.suspiciousIndices) {
+        // Confidence as set by BuildReport (hash, signature and lineage matches raise it)
+        ProcessInfo process = report.processes[index];
+        process.suspicious = true;
+        suspiciousProcesses.push_back(process);
+    }
 
-    for (auto& process : currentProcesses) {
-        ProcessCategory category = CategorizeProcess(process);
-        ThreatLevel threat = CalculateThreatLevel(process, category);
+    return suspiciousProcesses;
+}
 
-        if (threat > ThreatLevel::NONE) {
-            // Update the process with classification data
-            process.threatLevel = static_cast<int>(threat);
-            process.category = static_cast<int>(category);
-            process.confidence = 0.85; // System-based detection confidence
-            process.riskReason = GenerateRiskReason(process, category, threat);
-            process.flagged = true;
-            process.suspicious = true;
-            process.blacklisted = (threat >= ThreatLevel::HIGH);
+std::vector<ProcessInfo> ProcessWatcher::GetProcessSnapshot() {
+    auto published = AcquireReport();
+    return published->value.processes;
+}
+
+ProcessReport ProcessWatcher::GetProcessReport() {
+    return AcquireReport()->value;
+}
 
-            suspiciousProcesses.push_back(process);
+std::shared_ptr<const PublishedSnapshot<ProcessReport>> ProcessWatcher::AcquireReport() {
+    if (running_.load()) {
+        auto published = reportPublisher_.Load();
+        if (published) {
+            return published;
         }
     }
+    AdvanceContentScans();
+    return PublishReport();
+}
 
-    return suspiciousProcesses;
+bool ProcessWatcher::AdvanceContentScans() {
+    {
+        std::lock_guard<std::mutex> lock(contentScanMutex_);
+        auto now = std::chrono::steady_clock::now();
+        if (now - lastContentScan_ < std::chrono::milliseconds(intervalMs_)) {
+            return false;
+        }
+        lastContentScan_ = now;
+    }
+
+    // A large binary is continued on the next tick
+    bool queued = executableHasher_.PendingFiles() > 0 || signatureScanner_.PendingFiles() > 0 ||
+                  elfImports_.PendingFiles() > 0;
+    executableHasher_.Advance(kHashBytesPerTick);
+    signatureScanner_.Advance(kSignatureBytesPerTick);
+    elfImports_.Advance(kElfFilesPerTick);
+    return queued;
 }
 
-std::vector<ProcessInfo> ProcessWatcher::GetProcessSnapshot() {
-    std::vector<ProcessInfo> currentProcesses = GetRunningProcesses();
+std::shared_ptr<const PublishedSnapshot<ProcessReport>> ProcessWatcher::PublishReport() {
+    auto published = reportPublisher_.Publish(BuildReport());
+    reportDeltas_.Record(published->generation, published->value.processes);
+    return published;
+}
+
+ProcessDelta ProcessWatcher::GetProcessDelta(uint64_t sinceGeneration) {
+    auto published = AcquireReport();
+    return reportDeltas_.Diff(sinceGeneration, published->generation, published->value.processes);
+}
+
+std::vector<ProcessLineageNode> ProcessWatcher::GetProcessLineage(int pid, bool ancestry) {
+    auto published = AcquireReport();
+    const std::vector<ProcessInfo>& processes = published->value.processes;
+
+    const ProcessLineage& lineage = ProcessTable::Instance().Lineage();
+    std::vector<ProcessLineageEntry> entries = ancestry ? lineage.Ancestry(pid) : lineage.Subtree(pid);
+
+    std::vector<ProcessLineageNode> nodes;
+    nodes.reserve(entries.size());
+    for (const ProcessLineageEntry& entry : entries) {
+        // The index may already be a generation ahead of the report
+        auto it = std::lower_bound(processes.begin(), processes.end(), entry.pid,
+                                   [](const ProcessInfo& process, int p) { return process.pid < p; });
+        if (it != processes.end() && it->pid == entry.pid) {
+            nodes.emplace_back(entry.depth, *it);
+        }
+    }
+    return nodes;
+}
+
+void ProcessWatcher::PropagateLineageThreats(ProcessReport& report) {
+    auto byPid = [](const ProcessInfo& process, int pid) { return process.pid < pid; };
+    const ProcessLineage& lineage = ProcessTable::Instance().Lineage();
+    bool changed = false;
+
+    for (size_t index : report.suspiciousIndices) {
+        const ProcessInfo& root = report.processes[index];
+        if (root.category != static_cast<int>(ProcessCategory::AI_TOOL) ||
+            root.threatLevel < static_cast<int>(ThreatLevel::HIGH)) {
+            continue;
+        }
 
-    // Classify all processes
-    for (auto& process : currentProcesses) {
-        ProcessCategory category = CategorizeProcess(process);
-        ThreatLevel threat = CalculateThreatLevel(process, category);
+        std::string rootEvidence = "lineage:" + std::to_string(root.pid) + ":" + root.name;
+        for (const ProcessLineageEntry& entry : lineage.Subtree(root.pid)) {
+            if (entry.depth == 0) continue;
+
+            auto it = std::lower_bound(report.processes.begin(), report.processes.end(), entry.pid, byPid);
+            if (it == report.processes.end() || it->pid != entry.pid || it->threatLevel >= root.threatLevel) {
+                continue;
+            }
+
+            ProcessInfo& child = *it;
+            if (child.category == static_cast<int>(ProcessCategory::SAFE) ||
+                child.category == static_cast<int>(ProcessCategory::BROWSER)) {
+                child.category = root.category;
+            }
+            child.threatLevel = root.threatLevel;
+            child.confidence = 0.75;
+            child.riskReason = "Spawned by " + root.name;
+            child.evidence.push_back(rootEvidence);
+            child.flagged = true;
+            child.suspicious = true;
+            child.blacklisted = true;
+            changed = true;
+        }
+    }
+
+    if (!changed) return;
+
+    report.suspiciousIndices.clear();
+    for (size_t i = 0; i < report.processes.size(); i++) {
+        if (report.processes[i].threatLevel > static_cast<int>(ThreatLevel::NONE)) {
+            report.suspiciousIndices.push_back(i);
+        }
+    }
+}
+
+void ProcessWatcher::SetKnownBadExecutables(const std::vector<KnownBadExecutable>& entries) {
+    executableHasher_.SetKnownBad(entries);
+}
+
+ExecutableVerdict ProcessWatcher::GetExecutableVerdict(int pid) {
+    auto snapshot = ProcessTable::Instance().Acquire();
+    auto it = std::lower_bound(snapshot->processes.begin(), snapshot->processes.end(), pid,
+                               [](const ProcessInfo& process, int p) { return process.pid < p; });
+    if (it == snapshot->processes.end() || it->pid != pid) {
+        return ExecutableVerdict();
+    }
+    return executableHasher_.Lookup(*it);
+}
+
+void ProcessWatcher::SetSignatureRules(const std::vector<SignatureRule>& rules) {
+    signatureScanner_.SetRules(rules);
+}
+
+SignatureVerdict ProcessWatcher::GetSignatureVerdict(int pid) {
+    auto snapshot = ProcessTable::Instance().Acquire();
+    auto it = std::lower_bound(snapshot->processes.begin(), snapshot->processes.end(), pid,
+                               [](const ProcessInfo& process, int p) { return process.pid < p; });
+    if (it == snapshot->processes.end() || it->pid != pid) {
+        return SignatureVerdict();
+    }
+    return signatureScanner_.Lookup(*it);
+}
+
+ProcessReport ProcessWatcher::BuildReport() {
+    ProcessReport report;
+    auto snapshot = ProcessTable::Instance().Acquire();
+    report.tableGeneration = snapshot->generation;
+    report.processes = snapshot->processes;
+
+    // Queued files are hashed, scanned and analyzed by AdvanceContentScans;
+    // results show up here
+    executableHasher_.Sweep(snapshot->processes);
+    elfImports_.Sweep(snapshot->processes);
+    signatureScanner_.Sweep(snapshot->processes);
+
+    // Connections into known endpoint ranges, by pid; the scan is rate-limited
+    std::vector<NetworkPattern> networkPatterns;
+    std::unordered_map<int, const NetworkPattern*> endpointPatterns;
+    if (std::atomic_load(&endpointRanges_) || domainObserver_.IsRunning()) {
+        networkPatterns = DetectNetworkPatterns();
+        for (const auto& pattern : networkPatterns) {
+            if (!pattern.endpointMatches.empty()) endpointPatterns[pattern.pid] = &pattern;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(riskCacheMutex_);
+    SweepRiskCache(*snapshot);
+
+    for (size_t i = 0; i < report.processes.size(); i++) {
+        ProcessInfo& process = report.processes[i];
+        process.capabilities = elfImports_.Lookup(process);
+        const RiskCacheEntry& risk = LookupRiskCache(process);
+        ThreatLevel threat = risk.classification.threatLevel;
 
-        // Update the process with classification data
         process.threatLevel = static_cast<int>(threat);
-        process.category = static_cast<int>(category);
-        process.confidence = 0.80;
-        process.riskReason = GenerateRiskReason(process, category, threat);
+        process.category = static_cast<int>(risk.classification.category);
+        process.confidence = (threat > ThreatLevel::NONE) ? 0.85 : 0.80;
+        process.riskReason = risk.riskReason;
+        process.evidence = risk.classification.ruleIds;
         process.flagged = (threat > ThreatLevel::NONE);
         process.suspicious = (threat >= ThreatLevel::MEDIUM);
         process.blacklisted = (threat >= ThreatLevel::HIGH);
+
+        // Content match beats any name: a renamed binary keeps its hash
+        ExecutableVerdict verdict = executableHasher_.Lookup(process);
+        if (verdict.state == ExecutableVerdict::State::KnownBad) {
+            threat = ThreatLevel::CRITICAL;
+            process.threatLevel = static_cast<int>(threat);
+            process.confidence = 0.95;
+            process.riskReason = "Executable matches known-bad hash: " + verdict.label;
+            process.evidence.push_back("exe-sha256:" + verdict.label);
+            process.flagged = true;
+            process.suspicious = true;
+            process.blacklisted = true;
+        }
+
+        // Embedded strings survive repacking; each matching rule is evidence
+        SignatureVerdict signatures = signatureScanner_.Lookup(process);
+        for (const auto& match : signatures.matches) {
+            process.evidence.push_back("sig:" + match.ruleId + ":" + match.file);
+            if (match.threatLevel > static_cast<int>(threat)) {
+                threat = static_cast<ThreatLevel>(std::min(match.threatLevel, static_cast<int>(ThreatLevel::CRITICAL)));
+                process.threatLevel = static_cast<int>(threat);
+                process.confidence = 0.9;
+                process.riskReason = "Executable content matches signature: " + match.ruleId;
+                process.flagged = true;
+                process.suspicious = (threat >= ThreatLevel::MEDIUM);
+                process.blacklisted = (threat >= ThreatLevel::HIGH);
+            }
+        }
+
+        // Remote endpoints identify the service whatever the client is called
+        auto endpoints = endpointPatterns.find(process.pid);
+        if (endpoints != endpointPatterns.end() && endpoints->second->sockets.front().startTime == process.startTime) {
+            const NetworkEndpointMatch* strongest = nullptr;
+            for (const auto& match : endpoints->second->endpointMatches) {
+                if (match.source == "range") {
+                    process.evidence.push_back("endpoint:" + (match.label.empty() ? match.cidr : match.label));
+                } else {
+                    process.evidence.push_back(match.source + ":" + match.domain);
+                }
+                if (!strongest || ThreatLevelForCategory(match.category) > ThreatLevelForCategory(strongest->category)) {
+                    strongest = &match;
+                }
+            }
+            ThreatLevel endpointThreat = CalculateThreatLevel(process, risk.classification.category, strongest->category);
+            if (endpointThreat > threat) {
+                threat = endpointThreat;
+                process.threatLevel = static_cast<int>(threat);
+                process.category = static_cast<int>(strongest->category);
+                process.confidence = 0.85;
+                if (strongest->source == "range") {
+                    process.riskReason = "Connected to known endpoint " + strongest->remoteAddress +
+                                         (strongest->label.empty() ? "" : " (" + strongest->label + ")");
+                } else {
+                    process.riskReason = "Contacted " + strongest->domain + " (" + strongest->source + ")";
+                }
+                process.flagged = true;
+                process.suspicious = (threat >= ThreatLevel::MEDIUM);
+                process.blacklisted = (threat >= ThreatLevel::HIGH);
+            }
+        }
+
+        if (threat > ThreatLevel::NONE) {
+            report.suspiciousIndices.push_back(i);
+        }
     }
 
-    return currentProcesses;
-}
\ No newline at end of file
+    PropagateLineageThreats(report);
+    return report;
+}
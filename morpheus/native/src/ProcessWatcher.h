@@ -10,7 +10,9 @@
 #include <set>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <regex>
+#include <unordered_map>
 
 #ifdef _WIN32
 #ifndef WIN32_LEAN_AND_MEAN
@@ -31,6 +33,21 @@
 #endif
 
 #include "CommonTypes.h"
+#include "ExecutableHasher.h"
+#include "SignatureScanner.h"
+#include "ElfImports.h"
+#include "SocketInventory.h"
+#include "FlowRates.h"
+#include "CidrTrie.h"
+#include "DomainObserver.h"
+#include "FdInventory.h"
+#include "ModuleInventory.h"
+#include "PatternMatcher.h"
+#include "ProcessDelta.h"
+#include "ProcessEventSource.h"
+#include "ProcessExitWatcher.h"
+#include "ResourceSampler.h"
+#include "SnapshotPublisher.h"
 
 // System-based threat levels for 2025
 enum class ThreatLevel {
@@ -56,15 +73,58 @@ enum class ProcessCategory {
     OVERLAY_TOOL = 10
 };
 
+// Result of one pass of the compiled classifier over a process name
+struct ProcessClassification {
+    ProcessCategory category = ProcessCategory::SAFE;
+    ThreatLevel threatLevel = ThreatLevel::NONE;
+    std::vector<std::string> ruleIds; // e.g. "ai-tool:claude", "threat:=zoom"
+};
+
+struct ProcessTableSnapshot;
+
+// Full classified snapshot plus the entries DetectSuspiciousBehavior would
+// return, produced from one enumeration and one classification pass
+struct ProcessReport {
+    uint64_t tableGeneration = 0; // Process table walk it was built from, not the published report generation
+    std::vector<ProcessInfo> processes;
+    std::vector<size_t> suspiciousIndices; // Into processes, threat level above NONE
+};
+
+// One process of a lineage query, classified as in the report it came from
+struct ProcessLineageNode {
+    int depth; // Distance from the queried pid
+    ProcessInfo process;
+
+    ProcessLineageNode(int d, const ProcessInfo& p) : depth(d), process(p) {}
+};
+
+// A connection to a known endpoint: its remote address falls in a range of the
+// endpoint file, or the name it was opened for (TLS SNI, DNS query) matches a
+// domain rule
+struct NetworkEndpointMatch {
+    std::string source;        // "range", "sni" or "dns"
+    std::string remoteAddress; // Empty for a DNS query sent on an unconnected socket
+    ProcessCategory category = ProcessCategory::SAFE;
+    std::string label;         // Vendor or service named in the range file or domain rule
+    std::string cidr;          // Range matches only
+    std::string domain;        // Name matches only
+};
 
 // Network traffic pattern detection
 struct NetworkPattern {
+    int pid = 0;
     std::string processName;
-    std::vector<std::string> remoteAddresses;
-    uint64_t bytesTransferred;
-    bool isVideoStream;
-    bool isWebRTC;
-    bool isVPN;
+    std::vector<std::string> remoteAddresses; // Unique "address:port" of connected sockets
+    std::vector<SocketEntry> sockets;
+    uint64_t bytesTransferred = 0;            // TCP bytes sent plus received over the sockets' lifetime
+    double uploadBitsPerSecond = 0.0;         // Sum of the TCP flows' EWMA rates
+    double downloadBitsPerSecond = 0.0;
+    double sustainedUploadBitsPerSecond = 0.0; // Best flow's lowest rate over its sample ring
+    double burstiness = 0.0;                  // Of that flow's upload rates (stddev / mean)
+    bool isVideoStream = false;
+    bool isWebRTC = false;
+    bool isVPN = false;
+    std::vector<NetworkEndpointMatch> endpointMatches; // One per unique remote address in a known range
 };
 
 class ProcessWatcher {
@@ -74,6 +134,9 @@ public:
 
     // Core functionality
     void Start(Napi::Function callback, int intervalMs = 1500);
+    // Runs the same loop without a JS callback: reports are published in the
+    // background and the getters return them instead of rescanning
+    void StartMonitor(int intervalMs = 1500);
     void Stop();
     void SetBlacklist(const std::vector<std::string>& blacklist);
     void SetRecordingBlacklist(const std::vector<std::string>& recordingBlacklist);
@@ -88,7 +151,41 @@ public:
     // New system-based detection methods
     ThreatLevel ClassifyProcess(const ProcessInfo& process);
     std::vector<ProcessInfo> DetectSuspiciousBehavior();
+    ProcessReport GetProcessReport();
+
+    // Report published by WatcherLoop while it runs; otherwise built on demand
+    std::shared_ptr<const PublishedSnapshot<ProcessReport>> AcquireReport();
+
+    // Changes since a report generation previously returned to the caller
+    // (0 or an expired generation yields a full resync)
+    ProcessDelta GetProcessDelta(uint64_t sinceGeneration);
+
+    // Executables whose content hash marks them regardless of name
+    void SetKnownBadExecutables(const std::vector<KnownBadExecutable>& entries);
+    ExecutableVerdict GetExecutableVerdict(int pid);
+
+    // String signatures over executables and app.asar archives
+    void SetSignatureRules(const std::vector<SignatureRule>& rules);
+    SignatureVerdict GetSignatureVerdict(int pid);
+
+    // The pid and its descendants (ancestry=false) or its parents up to the root
+    std::vector<ProcessLineageNode> GetProcessLineage(int pid, bool ancestry);
     std::vector<NetworkPattern> DetectNetworkPatterns();
+
+    // Loads the range file of known AI, conferencing, remote-access and VPN
+    // endpoints and watches it: a changed file is reloaded on the next network
+    // scan. Returns false, keeping the current ranges, if the file cannot be read.
+    bool LoadEndpointRanges(const std::string& path, size_t& ranges, size_t& rejected);
+
+    // Passive SNI/DNS observer (Linux, CAP_NET_RAW); its names are attributed to
+    // sockets on each network scan. Start returns false where unavailable.
+    bool StartDomainObserver();
+    void StopDomainObserver();
+    void SetDomainRules(const std::vector<DomainRule>& rules);
+    DomainObserverStats GetDomainObserverStats();
+
+    // "ai_tool", "screen_sharing", "remote_access" or "vpn_tool" -> ProcessCategory value, else -1
+    static int EndpointCategoryFromName(const std::string& name);
     std::vector<std::string> ScanBrowserExtensions();
     bool DetectProcessInjection();
 
@@ -114,6 +211,25 @@ private:
     std::set<std::string> blacklist_;
     std::set<std::string> recordingBlacklist_;
 
+    // Compiled matchers, rebuilt whenever their source lists change and swapped
+    // in atomically so the watcher thread never sees a half-built automaton
+    struct ClassifierRule {
+        std::string id;
+        bool exact;                 // Whole-name match only
+        int priority;               // Lower wins when several categories match
+        bool hasCategory;
+        ProcessCategory category;
+        bool hasThreatLevel;
+        ThreatLevel threatLevel;
+    };
+    struct CompiledClassifier {
+        PatternMatcher matcher{true};
+        std::vector<ClassifierRule> rules;
+    };
+    std::shared_ptr<const CompiledClassifier> classifier_;
+    std::shared_ptr<const PatternMatcher> blacklistMatcher_;
+    std::shared_ptr<const PatternMatcher> recordingMatcher_;
+
     // Detection state
     bool lastDetectionState_;
     std::vector<ProcessInfo> lastBlacklistedProcesses_;
@@ -122,20 +238,100 @@ private:
     // Recording/Overlay detection state
     bool lastRecordingState_;
     std::vector<OverlayWindow> lastOverlayWindows_;
+    ModuleInventory moduleInventory_; // Linux module lists for DetectRecordingProcesses
+    ResourceSampler resourceSampler_; // CPU/IO rates of recording candidates between ticks
+    FdInventory fdInventory_;         // Capture/camera/uinput descriptors of recording candidates
+
+    // Executable content hashes; advanced by this many bytes per content-scan tick
+    static constexpr size_t kHashBytesPerTick = 32 * 1024 * 1024;
+    ExecutableHasher executableHasher_;
+
+    // Signature scans, advanced by this many bytes per content-scan tick
+    static constexpr size_t kSignatureBytesPerTick = 16 * 1024 * 1024;
+    SignatureScanner signatureScanner_;
+
+    // Static import analysis of executables, this many files per content-scan tick
+    static constexpr size_t kElfFilesPerTick = 16;
+    ElfImportAnalyzer elfImports_;
+    std::chrono::steady_clock::time_point lastContentScan_;
+    std::mutex contentScanMutex_; // Guards lastContentScan_
     double recordingConfidenceThreshold_;
     double overlayConfidenceThreshold_;
 
-    // System classification state
-    std::map<std::string, ThreatLevel> processRiskCache_;
+    // System classification state. Cached per pid and reused only while the
+    // process identity and the classifier rule set are unchanged.
+    struct RiskCacheEntry {
+        unsigned long long startTime = 0;
+        std::string path;
+        std::string name;
+        std::shared_ptr<const std::string> commandLine; // Compared by identity; set once per process lifetime
+        uint64_t ruleGeneration = 0;
+        ProcessClassification classification;
+        std::string riskReason;
+    };
+    std::unordered_map<int, RiskCacheEntry> processRiskCache_;
+    uint64_t riskCacheTableGeneration_;
+    std::atomic<uint64_t> ruleGeneration_;
+    std::mutex riskCacheMutex_;
+    SnapshotPublisher<ProcessReport> reportPublisher_;
+    ProcessDeltaTracker reportDeltas_;
+    ProcessDeltaTracker blacklistDeltas_;
+    uint64_t lastBlacklistGeneration_;
+
+    // Exec/exit notifications (Linux with CAP_NET_ADMIN). While open, the loop
+    // reacts to events and only walks the whole table every few ticks.
+    ProcessEventSource processEvents_;
+    static constexpr int kEventResyncTicks = 20;
+    static constexpr int kEventCoalesceMs = 10;
+
+    // pidfds of processes flagged in the last report, so their exit clears the
+    // threat immediately. Only touched by the watcher thread.
+    ProcessExitWatcher flaggedExits_;
+    std::unordered_map<int, ProcessInfo> flaggedProcesses_;
+    // Last DetectNetworkPatterns result, reused for calls within kNetworkScanMinIntervalMs
+    static constexpr int kNetworkScanMinIntervalMs = 1000;
+    // Flows idle this long are dropped from the rate estimator
+    static constexpr int kFlowExpiryMs = 30000;
+    FlowRateEstimator flowRates_;
     std::vector<NetworkPattern> networkPatterns_;
     std::chrono::steady_clock::time_point lastNetworkScan_;
+    std::mutex networkMutex_; // Guards the three above
+
+    // Endpoint ranges; the trie is swapped atomically so scans never wait on a reload
+    std::shared_ptr<const CidrTrie> endpointRanges_;
+    std::string endpointRangesPath_;
+    long long endpointRangesMtime_ = 0; // Of the file as last loaded
+    long long endpointRangesSize_ = -1;
+    std::mutex endpointRangesMutex_;    // Guards the path, mtime and size above
+
+    // Names seen by the observer, by the inode of the socket that sent them;
+    // kept while the socket lives and guarded by networkMutex_
+    DomainObserver domainObserver_;
+    std::unordered_map<unsigned long long, NetworkEndpointMatch> domainMatches_;
 
     // Core loop and detection
     void WatcherLoop();
+    void CheckBlacklist();
+    void TrackFlaggedProcesses(const ProcessReport& report);
+    void ClearExitedThreats(const std::vector<int>& exitedPids);
+    void EmitThreatClearedEvent(const ProcessInfo& process, const char* reason);
+    ProcessReport BuildReport();
+
+    // Raises the descendants of a high-threat AI tool to its threat level, so
+    // helpers and browser renderers it spawns are reported with it
+    void PropagateLineageThreats(ProcessReport& report);
+    std::shared_ptr<const PublishedSnapshot<ProcessReport>> PublishReport();
+
+    // Spends the content-scan budgets on files queued by earlier reports, at
+    // most once per intervalMs_ of wall-clock time however many reports are
+    // built. Driven by WatcherLoop while it runs, otherwise by the getters.
+    // Returns whether any work was queued.
+    bool AdvanceContentScans();
     std::vector<ProcessInfo> GetRunningProcesses();
     std::vector<ProcessInfo> FilterBlacklistedProcesses(const std::vector<ProcessInfo>& processes);
     std::vector<ProcessInfo> ClassifyProcesses(const std::vector<ProcessInfo>& processes);
-    void EmitDetectionEvent(bool detected, const std::vector<ProcessInfo>& blacklistedProcesses);
+    void EmitDetectionEvent(bool detected, const std::vector<ProcessInfo>& blacklistedProcesses,
+                            const ProcessDelta& delta);
     void EmitClassifiedDetectionEvent(const std::vector<ProcessInfo>& classifiedProcesses);
 
     // Recording/Overlay detection
@@ -153,10 +349,18 @@ private:
     void InitializeScreenSharingPatterns();
     void InitializeVPNPatterns();
     void InitializeRecordingBlacklist(); // Legacy
+    void BuildClassifier();
+    void BuildBlacklistMatcher();
+    void BuildRecordingMatcher();
 
     // System-based analysis methods
+    ProcessClassification MatchClassifier(const ProcessInfo& process);
+    void SweepRiskCache(const ProcessTableSnapshot& snapshot);
+    const RiskCacheEntry& LookupRiskCache(const ProcessInfo& process);
     ProcessCategory CategorizeProcess(const ProcessInfo& process);
-    ThreatLevel CalculateThreatLevel(const ProcessInfo& process, ProcessCategory category);
+    ThreatLevel CalculateThreatLevel(const ProcessInfo& process, ProcessCategory category,
+                                     ProcessCategory endpointCategory = ProcessCategory::SAFE);
+    ThreatLevel ThreatLevelForCategory(ProcessCategory category);
     bool HasScreenCaptureCapability(const ProcessInfo& process);
     bool HasRemoteAccessCapability(const ProcessInfo& process);
     std::string GenerateRiskReason(const ProcessInfo& process, ProcessCategory category, ThreatLevel level);
@@ -166,6 +370,8 @@ private:
     bool IsVideoStreamTraffic(const NetworkPattern& pattern);
     bool IsWebRTCConnection(const NetworkPattern& pattern);
     bool IsVPNConnection(const NetworkPattern& pattern);
+    bool ReadEndpointRanges(const std::string& path, size_t& ranges, size_t& rejected); // Caller holds endpointRangesMutex_
+    void ReloadEndpointRangesIfChanged();
 
     // Browser extension detection
     std::vector<std::string> ScanChromeExtensions();
@@ -183,6 +389,9 @@ private:
     std::vector<std::string> GetProcessLibraries(int pid);
     std::vector<OverlayWindow> EnumerateWindowsForOverlays();
     std::vector<std::string> EnumerateVirtualCameras();
+#elif __linux__
+    std::vector<OverlayWindow> EnumerateWindowsForOverlays();
+    std::vector<std::string> EnumerateVirtualCameras();
 #endif
 
     std::string EscapeJson(const std::string& str);
@@ -0,0 +1,402 @@
+#include "ProcfsBatchReader.h"
+
+#ifdef __linux__
+#include <dirent.h>
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+static const unsigned kRingEntries = 256;
+
+static int IoUringSetup(unsigned entries, struct io_uring_params* params) {
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+static int IoUringEnter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags) {
+    return static_cast<int>(syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, nullptr, 0));
+}
+
+static int IoUringRegister(int fd, unsigned opcode, void* arg, unsigned count) {
+    return static_cast<int>(syscall(__NR_io_uring_register, fd, opcode, arg, count));
+}
+
+ProcfsBatchReader::ProcfsBatchReader(ProcfsIoEngine engine, size_t slotSize)
+    : engine_(engine), slotSize_(slotSize), arenaRegistered_(false),
+      ringFd_(-1), ringEntries_(0),
+      sqRing_(nullptr), sqRingSize_(0), cqRing_(nullptr), cqRingSize_(0), sqes_(nullptr), sqesSize_(0),
+      sqHead_(nullptr), sqTail_(nullptr), sqMask_(nullptr), sqArray_(nullptr),
+      cqHead_(nullptr), cqTail_(nullptr), cqMask_(nullptr), cqes_(nullptr) {
+    if (engine_ == ProcfsIoEngine::IoUring && !SetupRing()) {
+        engine_ = ProcfsIoEngine::Pread;
+    }
+}
+
+ProcfsBatchReader::~ProcfsBatchReader() {
+    TeardownRing();
+}
+
+ProcfsIoEngine ProcfsBatchReader::ActiveEngine() const {
+    return engine_;
+}
+
+const char* ProcfsBatchReader::Data(size_t index) const {
+    return arena_.data() + index * slotSize_;
+}
+
+bool ProcfsBatchReader::SetupRing() {
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+
+    // Fails with ENOSYS on old kernels and EPERM where io_uring is disabled
+    ringFd_ = IoUringSetup(kRingEntries, &params);
+    if (ringFd_ < 0) {
+        ringFd_ = -1;
+        return false;
+    }
+    ringEntries_ = params.sq_entries;
+
+    sqRingSize_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cqRingSize_ = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    bool singleMmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (singleMmap) {
+        sqRingSize_ = cqRingSize_ = std::max(sqRingSize_, cqRingSize_);
+    }
+
+    sqRing_ = mmap(nullptr, sqRingSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd_, IORING_OFF_SQ_RING);
+    if (sqRing_ == MAP_FAILED) {
+        sqRing_ = nullptr;
+        TeardownRing();
+        return false;
+    }
+
+    if (singleMmap) {
+        cqRing_ = sqRing_;
+    } else {
+        cqRing_ = mmap(nullptr, cqRingSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd_, IORING_OFF_CQ_RING);
+        if (cqRing_ == MAP_FAILED) {
+            cqRing_ = nullptr;
+            TeardownRing();
+            return false;
+        }
+    }
+
+    sqesSize_ = params.sq_entries * sizeof(struct io_uring_sqe);
+    sqes_ = mmap(nullptr, sqesSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd_, IORING_OFF_SQES);
+    if (sqes_ == MAP_FAILED) {
+        sqes_ = nullptr;
+        TeardownRing();
+        return false;
+    }
+
+    char* sq = static_cast<char*>(sqRing_);
+    sqHead_ = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+    sqTail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    sqMask_ = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    sqArray_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+
+    char* cq = static_cast<char*>(cqRing_);
+    cqHead_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    cqTail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    cqMask_ = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    cqes_ = cq + params.cq_off.cqes;
+
+    // OPENAT/CLOSE arrived in 5.6 together with the probe interface; a kernel
+    // without the probe cannot run the batch
+    const unsigned probeOps = 256;
+    std::vector<char> probeBuffer(sizeof(struct io_uring_probe) + probeOps * sizeof(struct io_uring_probe_op), 0);
+    struct io_uring_probe* probe = reinterpret_cast<struct io_uring_probe*>(probeBuffer.data());
+    if (IoUringRegister(ringFd_, IORING_REGISTER_PROBE, probe, probeOps) < 0) {
+        TeardownRing();
+        return false;
+    }
+
+    const unsigned required[] = {IORING_OP_OPENAT, IORING_OP_READ, IORING_OP_READ_FIXED, IORING_OP_CLOSE};
+    for (unsigned op : required) {
+        if (op > probe->last_op || !(probe->ops[op].flags & IO_URING_OP_SUPPORTED)) {
+            TeardownRing();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void ProcfsBatchReader::TeardownRing() {
+    if (arenaRegistered_ && ringFd_ >= 0) {
+        IoUringRegister(ringFd_, IORING_UNREGISTER_BUFFERS, nullptr, 0);
+    }
+    arenaRegistered_ = false;
+
+    if (sqes_) munmap(sqes_, sqesSize_);
+    if (cqRing_ && cqRing_ != sqRing_) munmap(cqRing_, cqRingSize_);
+    if (sqRing_) munmap(sqRing_, sqRingSize_);
+    sqes_ = nullptr;
+    cqRing_ = nullptr;
+    sqRing_ = nullptr;
+
+    if (ringFd_ >= 0) {
+        close(ringFd_);
+        ringFd_ = -1;
+    }
+}
+
+bool ProcfsBatchReader::EnsureArena(size_t slots) {
+    size_t needed = std::max<size_t>(1, slots) * slotSize_;
+    if (arena_.size() >= needed) {
+        return arenaRegistered_;
+    }
+
+    if (arenaRegistered_) {
+        IoUringRegister(ringFd_, IORING_UNREGISTER_BUFFERS, nullptr, 0);
+        arenaRegistered_ = false;
+    }
+
+    // Headroom so a few new processes do not force a re-registration every scan
+    arena_.resize(needed + needed / 4);
+
+    if (ringFd_ >= 0) {
+        // Counts against RLIMIT_MEMLOCK on older kernels; plain READ is used if refused
+        struct iovec iov;
+        iov.iov_base = arena_.data();
+        iov.iov_len = arena_.size();
+        arenaRegistered_ = IoUringRegister(ringFd_, IORING_REGISTER_BUFFERS, &iov, 1) == 0;
+    }
+    return arenaRegistered_;
+}
+
+void ProcfsBatchReader::ReadAll(const std::vector<std::string>& paths, std::vector<ssize_t>& lengths) {
+    EnsureArena(paths.size());
+    lengths.assign(paths.size(), -1);
+
+    if (engine_ == ProcfsIoEngine::IoUring) {
+        if (ReadAllRing(paths, lengths)) {
+            return;
+        }
+
+        // The ring failed mid-batch; stay on pread from now on
+        TeardownRing();
+        engine_ = ProcfsIoEngine::Pread;
+        lengths.assign(paths.size(), -1);
+    }
+
+    ReadAllPread(paths, lengths);
+}
+
+void ProcfsBatchReader::ReadAllPread(const std::vector<std::string>& paths, std::vector<ssize_t>& lengths) {
+    for (size_t i = 0; i < paths.size(); i++) {
+        char* slot = arena_.data() + i * slotSize_;
+        slot[0] = '\0';
+
+        int fd = open(paths[i].c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) continue;
+
+        ssize_t n;
+        do {
+            n = pread(fd, slot, slotSize_ - 1, 0);
+        } while (n < 0 && errno == EINTR);
+        close(fd);
+
+        if (n >= 0) {
+            slot[n] = '\0';
+            lengths[i] = n;
+        }
+    }
+}
+
+bool ProcfsBatchReader::SubmitAndWait(unsigned count, std::vector<int64_t>& results) {
+    results.assign(count, -1);
+    if (count == 0) {
+        return true;
+    }
+
+    unsigned toSubmit = count;
+    unsigned reaped = 0;
+    while (reaped < count) {
+        int submitted = IoUringEnter(ringFd_, toSubmit, count - reaped, IORING_ENTER_GETEVENTS);
+        if (submitted < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        toSubmit -= std::min<unsigned>(toSubmit, static_cast<unsigned>(submitted));
+
+        unsigned head = *cqHead_;
+        unsigned tail = __atomic_load_n(cqTail_, __ATOMIC_ACQUIRE);
+        const struct io_uring_cqe* cqes = static_cast<const struct io_uring_cqe*>(cqes_);
+        while (head != tail) {
+            const struct io_uring_cqe& cqe = cqes[head & *cqMask_];
+            if (cqe.user_data < count) {
+                results[cqe.user_data] = cqe.res;
+            }
+            head++;
+            reaped++;
+        }
+        __atomic_store_n(cqHead_, head, __ATOMIC_RELEASE);
+    }
+
+    return true;
+}
+
+bool ProcfsBatchReader::ReadAllRing(const std::vector<std::string>& paths, std::vector<ssize_t>& lengths) {
+    std::vector<int64_t> results;
+    std::vector<int> fds;
+    std::vector<size_t> opened;
+
+    for (size_t chunkStart = 0; chunkStart < paths.size(); chunkStart += ringEntries_) {
+        unsigned chunk = static_cast<unsigned>(std::min<size_t>(ringEntries_, paths.size() - chunkStart));
+        struct io_uring_sqe* sqes = static_cast<struct io_uring_sqe*>(sqes_);
+
+        // Phase 1: open every file in the chunk
+        unsigned tail = *sqTail_;
+        for (unsigned k = 0; k < chunk; k++) {
+            unsigned index = (tail + k) & *sqMask_;
+            struct io_uring_sqe& sqe = sqes[index];
+            memset(&sqe, 0, sizeof(sqe));
+            sqe.opcode = IORING_OP_OPENAT;
+            sqe.fd = AT_FDCWD;
+            sqe.addr = reinterpret_cast<uint64_t>(paths[chunkStart + k].c_str());
+            sqe.open_flags = O_RDONLY | O_CLOEXEC;
+            sqe.user_data = k;
+            sqArray_[index] = index;
+        }
+        __atomic_store_n(sqTail_, tail + chunk, __ATOMIC_RELEASE);
+        if (!SubmitAndWait(chunk, results)) {
+            return false;
+        }
+
+        fds.assign(chunk, -1);
+        opened.clear();
+        for (unsigned k = 0; k < chunk; k++) {
+            if (results[k] >= 0) {
+                fds[k] = static_cast<int>(results[k]);
+                opened.push_back(k);
+            }
+        }
+
+        // Phase 2: read each opened file into its slot of the registered arena
+        tail = *sqTail_;
+        for (unsigned n = 0; n < opened.size(); n++) {
+            size_t k = opened[n];
+            unsigned index = (tail + n) & *sqMask_;
+            struct io_uring_sqe& sqe = sqes[index];
+            memset(&sqe, 0, sizeof(sqe));
+            sqe.opcode = arenaRegistered_ ? IORING_OP_READ_FIXED : IORING_OP_READ;
+            sqe.fd = fds[k];
+            sqe.addr = reinterpret_cast<uint64_t>(arena_.data() + (chunkStart + k) * slotSize_);
+            sqe.len = static_cast<uint32_t>(slotSize_ - 1);
+            sqe.off = 0;
+            sqe.buf_index = 0;
+            sqe.user_data = n;
+            sqArray_[index] = index;
+        }
+        __atomic_store_n(sqTail_, tail + static_cast<unsigned>(opened.size()), __ATOMIC_RELEASE);
+        bool readOk = SubmitAndWait(static_cast<unsigned>(opened.size()), results);
+
+        if (readOk) {
+            for (unsigned n = 0; n < opened.size(); n++) {
+                size_t i = chunkStart + opened[n];
+                char* slot = arena_.data() + i * slotSize_;
+                if (results[n] >= 0) {
+                    slot[results[n]] = '\0';
+                    lengths[i] = static_cast<ssize_t>(results[n]);
+                } else {
+                    slot[0] = '\0';
+                }
+            }
+        }
+
+        // Phase 3: close; falls back to close(2) if the ring failed underneath us
+        tail = *sqTail_;
+        for (unsigned n = 0; readOk && n < opened.size(); n++) {
+            unsigned index = (tail + n) & *sqMask_;
+            struct io_uring_sqe& sqe = sqes[index];
+            memset(&sqe, 0, sizeof(sqe));
+            sqe.opcode = IORING_OP_CLOSE;
+            sqe.fd = fds[opened[n]];
+            sqe.user_data = n;
+            sqArray_[index] = index;
+        }
+        if (readOk) {
+            __atomic_store_n(sqTail_, tail + static_cast<unsigned>(opened.size()), __ATOMIC_RELEASE);
+        }
+        if (!readOk || !SubmitAndWait(static_cast<unsigned>(opened.size()), results)) {
+            for (size_t k : opened) {
+                close(fds[k]);
+            }
+            return false;
+        }
+    }
+
+    return true;
+}
+
+ProcfsBenchmarkResult ProcfsBatchReader::Benchmark(int iterations) {
+    ProcfsBenchmarkResult result;
+    result.iterations = std::max(1, iterations);
+
+    std::vector<std::string> paths;
+    DIR* procDir = opendir("/proc");
+    if (!procDir) {
+        return result;
+    }
+    struct dirent* dirEntry;
+    while ((dirEntry = readdir(procDir)) != nullptr) {
+        if (dirEntry->d_name[0] < '1' || dirEntry->d_name[0] > '9') continue;
+        paths.push_back(std::string("/proc/") + dirEntry->d_name + "/stat");
+    }
+    closedir(procDir);
+    result.fileCount = paths.size();
+
+    using Clock = std::chrono::steady_clock;
+    auto averageUs = [&](Clock::time_point start) {
+        return std::chrono::duration<double, std::micro>(Clock::now() - start).count() / result.iterations;
+    };
+
+    // Synchronous walk: open, read until EOF, close (what ProcessTable::Scan did)
+    char buffer[1024];
+    auto start = Clock::now();
+    for (int it = 0; it < result.iterations; it++) {
+        for (const auto& path : paths) {
+            int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) continue;
+            ssize_t total = 0;
+            ssize_t n;
+            while (total < static_cast<ssize_t>(sizeof(buffer)) - 1 &&
+                   (n = read(fd, buffer + total, sizeof(buffer) - 1 - total)) > 0) {
+                total += n;
+            }
+            close(fd);
+        }
+    }
+    result.synchronousUs = averageUs(start);
+
+    std::vector<ssize_t> lengths;
+    ProcfsBatchReader preadReader(ProcfsIoEngine::Pread);
+    start = Clock::now();
+    for (int it = 0; it < result.iterations; it++) {
+        preadReader.ReadAll(paths, lengths);
+    }
+    result.preadUs = averageUs(start);
+
+    ProcfsBatchReader ringReader(ProcfsIoEngine::IoUring);
+    if (ringReader.ActiveEngine() == ProcfsIoEngine::IoUring) {
+        ringReader.ReadAll(paths, lengths); // Arena registration is not part of the steady state
+        start = Clock::now();
+        for (int it = 0; it < result.iterations; it++) {
+            ringReader.ReadAll(paths, lengths);
+        }
+        result.ioUringUs = averageUs(start);
+        result.ioUringAvailable = ringReader.ActiveEngine() == ProcfsIoEngine::IoUring;
+    }
+
+    return result;
+}
+#endif
@@ -0,0 +1,154 @@
+#include "RemoteSessions.h"
+#include <algorithm>
+#include <cctype>
+#include <unordered_set>
+
+namespace {
+
+constexpr int kTcpEstablished = 1;
+constexpr uint16_t kRustDeskRelayPort = 21117;
+
+struct ServiceName {
+    const char* process; // Lowercased executable name
+    const char* service;
+};
+
+// Servers that accept a connection and then show or drive the local desktop.
+// Helpers such as xrdp-sesman only talk to their own daemon and are left out.
+const ServiceName kServiceNames[] = {
+    {"x11vnc", "vnc"},
+    {"xvnc", "vnc"},
+    {"xtigervnc", "vnc"},
+    {"x0vncserver", "vnc"},
+    {"x0tigervncserver", "vnc"},
+    {"xtightvnc", "vnc"},
+    {"vncserver-x11-core", "vnc"},
+    {"vino-server", "vnc"},
+    {"krfb", "vnc"},
+    {"wayvnc", "vnc"},
+    {"xrdp", "rdp"},
+    {"gnome-remote-desktop-daemon", "rdp"},
+    {"krdpserver", "rdp"},
+    {"nxd", "nomachine"},
+    {"nxserver.bin", "nomachine"},
+    {"nxnode.bin", "nomachine"},
+    {"rustdesk", "rustdesk"},
+};
+
+const ProcessInfo* FindProcess(const std::vector<ProcessInfo>& processes, int pid) {
+    auto it = std::lower_bound(processes.begin(), processes.end(), pid,
+                               [](const ProcessInfo& process, int value) { return process.pid < value; });
+    return it != processes.end() && it->pid == pid ? &*it : nullptr;
+}
+
+bool IsLoopback(const uint8_t bytes[16]) {
+    static const uint8_t kMappedPrefix[12] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xff, 0xff};
+    static const uint8_t kLoopback6[16] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1};
+    if (std::equal(kMappedPrefix, kMappedPrefix + 12, bytes)) {
+        return bytes[12] == 127;
+    }
+    return std::equal(kLoopback6, kLoopback6 + 16, bytes);
+}
+
+} // namespace
+
+std::string RemoteSessionTracker::ServiceForProcess(const std::string& name) {
+    std::string lower = name;
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+    for (const auto& entry : kServiceNames) {
+        if (lower == entry.process) {
+            return entry.service;
+        }
+    }
+    return "";
+}
+
+std::string RemoteSessionTracker::ServiceForPort(uint16_t port) {
+    if (port >= 5900 && port <= 5999) {
+        return "vnc";
+    }
+    if (port == 3389) {
+        return "rdp";
+    }
+    return "";
+}
+
+std::vector<RemoteSession> RemoteSessionTracker::Update(const SocketInventorySnapshot& snapshot,
+                                                        const std::vector<ProcessInfo>& processes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (snapshot.generation != 0 && snapshot.generation == generation_) {
+        return sessions_;
+    }
+    generation_ = snapshot.generation;
+
+    auto nameOf = [&](int pid) -> std::string {
+        const ProcessInfo* process = pid > 0 ? FindProcess(processes, pid) : nullptr;
+        return process ? process->name : std::string();
+    };
+
+    listeners_.clear();
+    for (const auto& socket : snapshot.sockets) {
+        if (!socket.IsListening()) continue;
+
+        Listener listener;
+        listener.pid = socket.pid;
+        listener.processName = nameOf(socket.pid);
+        listener.service = ServiceForProcess(listener.processName);
+        if (listener.service.empty() && socket.pid == 0) {
+            listener.service = ServiceForPort(socket.localPort);
+        }
+        if (!listener.service.empty()) {
+            listeners_[socket.localPort] = listener;
+        }
+    }
+
+    sessions_.clear();
+    std::unordered_set<unsigned long long> live;
+    auto now = snapshot.capturedAt;
+    for (const auto& socket : snapshot.sockets) {
+        if (socket.protocol != SocketEntry::Protocol::Tcp || socket.state != kTcpEstablished || !socket.IsConnected()) {
+            continue;
+        }
+
+        RemoteSession session;
+        auto listener = listeners_.find(socket.localPort);
+        if (listener != listeners_.end()) {
+            session.service = listener->second.service;
+            session.pid = socket.pid != 0 ? socket.pid : listener->second.pid;
+            session.processName = socket.pid != 0 ? nameOf(socket.pid) : listener->second.processName;
+        } else if (socket.remotePort == kRustDeskRelayPort && socket.pid != 0) {
+            // Relay connections only exist while a session is up; the
+            // rendezvous connection the client always keeps uses another port
+            session.processName = nameOf(socket.pid);
+            if (ServiceForProcess(session.processName) != "rustdesk") continue;
+            session.service = "rustdesk";
+            session.pid = socket.pid;
+            session.relayed = true;
+        } else {
+            continue;
+        }
+
+        session.localPort = socket.localPort;
+        session.peerAddress = socket.remoteAddress;
+        session.peerPort = socket.remotePort;
+        session.loopbackPeer = IsLoopback(socket.remoteBytes);
+
+        if (socket.inode != 0) {
+            auto seen = firstSeen_.emplace(socket.inode, now).first;
+            session.durationMs = static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::milliseconds>(now - seen->second).count());
+            live.insert(socket.inode);
+        }
+        sessions_.push_back(session);
+    }
+
+    for (auto it = firstSeen_.begin(); it != firstSeen_.end();) {
+        if (live.count(it->first)) {
+            ++it;
+        } else {
+            it = firstSeen_.erase(it);
+        }
+    }
+
+    return sessions_;
+}
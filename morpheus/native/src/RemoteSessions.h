@@ -0,0 +1,63 @@
+#ifndef REMOTE_SESSIONS_H
+#define REMOTE_SESSIONS_H
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "CommonTypes.h"
+#include "SocketInventory.h"
+
+// An established connection that lets someone else see or drive this desktop
+struct RemoteSession {
+    std::string service;        // "vnc", "rdp", "nomachine", "rustdesk", ...
+    int pid = 0;                // Owner of the session socket, else of the listener; 0 if unknown
+    std::string processName;
+    uint16_t localPort = 0;
+    std::string peerAddress;
+    uint16_t peerPort = 0;
+    bool relayed = false;       // Through the vendor's relay instead of an inbound connection
+    bool loopbackPeer = false;  // Peer on this machine, usually the end of an SSH tunnel
+    uint64_t durationMs = 0;    // Since the tracker first saw the connection
+};
+
+// Incremental view of the listening and established sockets of remote-desktop
+// services (VNC servers, xrdp and GNOME Remote Desktop, NoMachine, RustDesk),
+// built from shared socket inventory snapshots rather than a dump of its own.
+// A listener is attributed to a service by its owner's name, or for the VNC and
+// RDP port ranges also when the owner is hidden (a root daemon seen without
+// privileges). An established TCP socket whose local port is such a listening
+// port is an inbound session; RustDesk sessions through its relay are outbound
+// connections to the relay port. Sessions are keyed by socket inode so their
+// age survives between snapshots.
+class RemoteSessionTracker {
+public:
+    // processes must be sorted by pid. A snapshot already seen returns the
+    // previous result.
+    std::vector<RemoteSession> Update(const SocketInventorySnapshot& snapshot,
+                                      const std::vector<ProcessInfo>& processes);
+
+    // Service of a remote-desktop server process name, or empty
+    static std::string ServiceForProcess(const std::string& name);
+
+    // Service conventionally listening on a port, or empty
+    static std::string ServiceForPort(uint16_t port);
+
+private:
+    struct Listener {
+        std::string service;
+        int pid = 0;
+        std::string processName;
+    };
+
+    uint64_t generation_ = 0;
+    std::unordered_map<uint16_t, Listener> listeners_;                                    // By TCP port
+    std::unordered_map<unsigned long long, std::chrono::steady_clock::time_point> firstSeen_; // By socket inode
+    std::vector<RemoteSession> sessions_;
+    std::mutex mutex_; // Guards everything above
+};
+
+#endif // REMOTE_SESSIONS_H
@@ -0,0 +1,162 @@
+#include "ResourceSampler.h"
+#include <algorithm>
+#include <cstring>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+
+// Samples closer together than this return the previous rates; tick-granular
+// CPU counters are too coarse over shorter windows
+static const std::chrono::milliseconds kMinSampleInterval(250);
+
+static ssize_t ReadSmallProcfsFile(const char* path, char* buf, size_t size) {
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return -1;
+    }
+
+    ssize_t n;
+    do {
+        n = read(fd, buf, size - 1);
+    } while (n < 0 && errno == EINTR);
+    close(fd);
+
+    if (n < 0) {
+        return -1;
+    }
+    buf[n] = '\0';
+    return n;
+}
+
+// utime (14), stime (15) and starttime (22), counted from the last ')' since
+// comm may contain spaces
+static bool ParseCpuTicks(const char* stat, unsigned long long& cpuTicks, unsigned long long& startTime) {
+    const char* cursor = strrchr(stat, ')');
+    if (!cursor || cursor[1] != ' ') {
+        return false;
+    }
+    cursor += 2;
+
+    unsigned long long utime = 0;
+    for (int field = 3; field <= 22; field++) {
+        while (*cursor == ' ') cursor++;
+        if (*cursor == '\0') {
+            return false;
+        }
+
+        if (field == 14) {
+            utime = strtoull(cursor, nullptr, 10);
+        } else if (field == 15) {
+            cpuTicks = utime + strtoull(cursor, nullptr, 10);
+        } else if (field == 22) {
+            startTime = strtoull(cursor, nullptr, 10);
+            return true;
+        }
+
+        while (*cursor != ' ' && *cursor != '\0') cursor++;
+    }
+    return false;
+}
+
+static unsigned long long ParseIoField(const char* io, const char* key) {
+    const char* line = strstr(io, key);
+    return line ? strtoull(line + strlen(key), nullptr, 10) : 0;
+}
+#endif
+
+ResourceRates ResourceSampler::Sample(int pid, unsigned long long startTime) {
+#ifdef __linux__
+    static const double ticksPerSecond = static_cast<double>(sysconf(_SC_CLK_TCK));
+    auto now = std::chrono::steady_clock::now();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = cache_.find(pid);
+        if (it != cache_.end() && it->second.startTime == startTime && now - it->second.sampledAt < kMinSampleInterval) {
+            return it->second.rates;
+        }
+    }
+
+    char path[64];
+    char buffer[1024];
+
+    snprintf(path, sizeof(path), "/proc/%d/stat", pid);
+    unsigned long long cpuTicks = 0;
+    unsigned long long statStartTime = 0;
+    if (ReadSmallProcfsFile(path, buffer, sizeof(buffer)) <= 0 ||
+        !ParseCpuTicks(buffer, cpuTicks, statStartTime) || statStartTime != startTime) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        cache_.erase(pid);
+        return ResourceRates();
+    }
+
+    snprintf(path, sizeof(path), "/proc/%d/io", pid);
+    bool ioAvailable = ReadSmallProcfsFile(path, buffer, sizeof(buffer)) > 0;
+    unsigned long long readBytes = ioAvailable ? ParseIoField(buffer, "rchar:") : 0;
+    unsigned long long writeBytes = ioAvailable ? ParseIoField(buffer, "wchar:") : 0;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = cache_.find(pid);
+    if (it == cache_.end() || it->second.startTime != startTime) {
+        // First sample of this identity; rates need a second one
+        Entry& entry = cache_[pid];
+        entry = Entry();
+        entry.startTime = startTime;
+        entry.cpuTicks = cpuTicks;
+        entry.readBytes = readBytes;
+        entry.writeBytes = writeBytes;
+        entry.sampledAt = now;
+        entry.rates.ioAvailable = ioAvailable;
+        return entry.rates;
+    }
+
+    Entry& entry = it->second;
+    double seconds = std::chrono::duration<double>(now - entry.sampledAt).count();
+    ResourceRates& rates = entry.rates;
+
+    rates.valid = true;
+    rates.cpuPercent = (cpuTicks - std::min(cpuTicks, entry.cpuTicks)) / ticksPerSecond / seconds * 100.0;
+    rates.busySamples = rates.cpuPercent >= kBusyCpuPercent ? rates.busySamples + 1 : 0;
+
+    // Access to io can change (setuid); only diff counters read on both ends
+    if (ioAvailable && rates.ioAvailable) {
+        rates.readBytesPerSec = (readBytes - std::min(readBytes, entry.readBytes)) / seconds;
+        rates.writeBytesPerSec = (writeBytes - std::min(writeBytes, entry.writeBytes)) / seconds;
+        bool ioActive = std::max(rates.readBytesPerSec, rates.writeBytesPerSec) >= kActiveIoBytesPerSec;
+        rates.ioActiveSamples = ioActive ? rates.ioActiveSamples + 1 : 0;
+    } else {
+        rates.readBytesPerSec = 0.0;
+        rates.writeBytesPerSec = 0.0;
+        rates.ioActiveSamples = 0;
+    }
+    rates.ioAvailable = ioAvailable;
+
+    entry.cpuTicks = cpuTicks;
+    entry.readBytes = readBytes;
+    entry.writeBytes = writeBytes;
+    entry.sampledAt = now;
+    return rates;
+#else
+    (void)pid;
+    (void)startTime;
+    return ResourceRates();
+#endif
+}
+
+void ResourceSampler::Sweep(const std::vector<ProcessInfo>& processes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    for (auto it = cache_.begin(); it != cache_.end();) {
+        auto listed = std::lower_bound(processes.begin(), processes.end(), it->first,
+                                       [](const ProcessInfo& process, int pid) { return process.pid < pid; });
+        if (listed == processes.end() || listed->pid != it->first || listed->startTime != it->second.startTime) {
+            it = cache_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
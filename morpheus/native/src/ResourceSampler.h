@@ -0,0 +1,51 @@
+#ifndef RESOURCE_SAMPLER_H
+#define RESOURCE_SAMPLER_H
+
+#include <chrono>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "CommonTypes.h"
+
+// CPU and I/O rates of one process between its last two samples
+struct ResourceRates {
+    bool valid = false;          // False until two samples of the same identity exist
+    bool ioAvailable = false;    // /proc/<pid>/io needs ptrace access to the process
+    double cpuPercent = 0.0;     // utime+stime per wall second; 100 = one full core
+    double readBytesPerSec = 0.0;
+    double writeBytesPerSec = 0.0;
+    int busySamples = 0;         // Consecutive samples at or above kBusyCpuPercent
+    int ioActiveSamples = 0;     // Consecutive samples at or above kActiveIoBytesPerSec
+};
+
+// Per-process utime/stime and /proc/<pid>/io counters (rchar/wchar) kept per
+// (pid, start time), turned into rates between detection ticks. Only the
+// processes passed in are sampled, so callers sample their candidates rather
+// than the whole table. Steady state reuses cache entries and stack buffers and
+// allocates nothing. Other platforms get invalid rates.
+class ResourceSampler {
+public:
+    static constexpr double kBusyCpuPercent = 30.0;
+    static constexpr double kActiveIoBytesPerSec = 256.0 * 1024.0;
+
+    ResourceRates Sample(int pid, unsigned long long startTime);
+
+    // Drops entries for processes not in the list (sorted by pid)
+    void Sweep(const std::vector<ProcessInfo>& processes);
+
+private:
+    struct Entry {
+        unsigned long long startTime = 0;
+        unsigned long long cpuTicks = 0;
+        unsigned long long readBytes = 0;
+        unsigned long long writeBytes = 0;
+        std::chrono::steady_clock::time_point sampledAt;
+        ResourceRates rates;
+    };
+
+    std::unordered_map<int, Entry> cache_;
+    std::mutex mutex_;
+};
+
+#endif // RESOURCE_SAMPLER_H
@@ -11,6 +11,7 @@
 #include <map>
 #include <chrono>
 #include "CommonTypes.h"
+#include "SnapshotPublisher.h"
 
 #ifdef _WIN32
 #ifndef WIN32_LEAN_AND_MEAN
@@ -45,6 +46,8 @@
 @class AVCaptureDevice;
 @class SCShareableContent;
 #endif
+#elif __linux__
+#include "RemoteSessions.h"
 #endif
 
 // Enhanced screen sharing detection for 2025
@@ -108,6 +111,8 @@ public:
     bool startWatching(std::function<void(const std::string&)> callback, int intervalMs = 3000);
     void stopWatching();
     ScreenStatus getCurrentStatus();
+    // Status published by watcherLoop while it runs; otherwise detected on demand
+    std::shared_ptr<const PublishedSnapshot<ScreenStatus>> acquireStatus();
     RecordingDetectionResult detectRecordingAndOverlays();
     void setRecordingBlacklist(const std::vector<std::string>& recordingBlacklist);
     std::vector<std::string> getVirtualCameras();
@@ -146,6 +151,7 @@ private:
     double screenSharingConfidenceThreshold_;
     std::chrono::steady_clock::time_point lastDetectionTime_;
     std::map<int, ScreenSharingMethod> processMethodCache_;
+    SnapshotPublisher<ScreenStatus> statusPublisher_;
 
     ScreenStatus detectScreenStatus();
 
@@ -173,6 +179,11 @@ private:
     bool isScreenCaptureKitActive();
     std::vector<ScreenSharingSession> scanMacOSBrowserScreenSharing();
 
+#elif __linux__
+    // Linux remote-desktop detection, from the shared socket inventory
+    std::vector<ScreenSharingSession> detectLinuxRemoteDesktopSessions();
+    RemoteSessionTracker remoteSessions_;
+
 #endif
 
     std::vector<ProcessInfo> detectRecordingProcesses();
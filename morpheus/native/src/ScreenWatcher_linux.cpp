@@ -0,0 +1,317 @@
+#include "ScreenWatcher.h"
+#include "ProcessTable.h"
+#include "SocketInventory.h"
+#include <sstream>
+#include <chrono>
+#include <algorithm>
+
+// Linux has no capture API to ask, so screen sharing here means a remote-desktop
+// server (VNC, RDP, NoMachine, RustDesk) with a connected peer, read from the
+// socket inventory ProcessWatcher also uses, and recording means a known
+// recorder process.
+
+namespace {
+
+// How old a shared socket snapshot may be; the watcher polls every few seconds
+constexpr int kSocketSnapshotMaxAgeMs = 1000;
+
+} // namespace
+
+ScreenWatcher::ScreenWatcher() : isRunning(false), checkIntervalMs(3000),
+                                 lastRecordingState_(false), recordingConfidenceThreshold_(0.75), overlayConfidenceThreshold_(0.6),
+                                 checkCount_(0), lastScreenSharingState_(false), screenSharingConfidenceThreshold_(0.75) {
+    initializeRecordingBlacklist();
+}
+
+ScreenWatcher::~ScreenWatcher() {
+    if (isRunning) {
+        stopWatching();
+    }
+}
+
+bool ScreenWatcher::startWatching(std::function<void(const std::string&)> callback, int intervalMs) {
+    if (isRunning) {
+        return false;
+    }
+
+    eventCallback = callback;
+    checkIntervalMs = intervalMs;
+    isRunning = true;
+
+    watcherThread = std::thread(&ScreenWatcher::watcherLoop, this);
+
+    return true;
+}
+
+void ScreenWatcher::stopWatching() {
+    if (!isRunning) return;
+
+    isRunning = false;
+
+    if (watcherThread.joinable()) {
+        watcherThread.join();
+    }
+}
+
+ScreenStatus ScreenWatcher::getCurrentStatus() {
+    return acquireStatus()->value;
+}
+
+std::shared_ptr<const PublishedSnapshot<ScreenStatus>> ScreenWatcher::acquireStatus() {
+    if (isRunning) {
+        auto published = statusPublisher_.Load();
+        if (published) {
+            return published;
+        }
+    }
+    return statusPublisher_.Publish(detectScreenStatus());
+}
+
+bool ScreenWatcher::isPlatformSupported() {
+    return true;
+}
+
+ScreenStatus ScreenWatcher::detectScreenStatus() {
+    ScreenStatus status;
+    status.mirroring = false;
+    status.splitScreen = false;
+
+    status.activeSharingSessions = detectScreenSharingSessions();
+    status.screenSharing = !status.activeSharingSessions.empty();
+    status.hasActiveCaptureSession = status.screenSharing;
+    status.recordingResult = detectRecordingAndOverlays();
+    status.overallThreatLevel = 0.0;
+    for (const auto& session : status.activeSharingSessions) {
+        status.overallThreatLevel = std::max(status.overallThreatLevel, session.confidence);
+    }
+
+    lastScreenSharingState_ = status.screenSharing;
+    lastSharingSessions_ = status.activeSharingSessions;
+    lastDetectionTime_ = std::chrono::steady_clock::now();
+
+    return status;
+}
+
+void ScreenWatcher::watcherLoop() {
+    while (isRunning) {
+        try {
+            auto published = statusPublisher_.Publish(detectScreenStatus());
+            std::string json = statusToJson(published->value);
+
+            if (eventCallback) {
+                eventCallback(json);
+            }
+        } catch (const std::exception&) {
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(checkIntervalMs));
+    }
+}
+
+std::string ScreenWatcher::statusToJson(const ScreenStatus& status) {
+    std::stringstream ss;
+    auto timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()
+    ).count();
+
+    ss << "{";
+    ss << "\"mirroring\":" << (status.mirroring ? "true" : "false") << ",";
+    ss << "\"splitScreen\":" << (status.splitScreen ? "true" : "false") << ",";
+    ss << "\"screenSharing\":" << (status.screenSharing ? "true" : "false") << ",";
+    ss << "\"displays\":[],";
+    ss << "\"externalDisplays\":[],";
+    ss << "\"externalKeyboards\":[],";
+    ss << "\"externalDevices\":[],";
+
+    ss << "\"sharingSessions\":[";
+    for (size_t i = 0; i < status.activeSharingSessions.size(); i++) {
+        const auto& session = status.activeSharingSessions[i];
+        if (i > 0) ss << ",";
+        ss << "{\"processName\":\"" << escapeJson(session.processName) << "\",";
+        ss << "\"pid\":" << session.pid << ",";
+        ss << "\"target\":\"" << escapeJson(session.targetUrl) << "\",";
+        ss << "\"description\":\"" << escapeJson(session.description) << "\",";
+        ss << "\"confidence\":" << session.confidence << "}";
+    }
+    ss << "],";
+
+    ss << "\"timestamp\":" << timestamp << ",";
+    ss << "\"module\":\"screen-watch\",";
+    ss << "\"source\":\"native\",";
+    ss << "\"count\":" << (++checkCount_);
+    ss << "}";
+
+    return ss.str();
+}
+
+std::string ScreenWatcher::escapeJson(const std::string& str) {
+    std::string escaped;
+    escaped.reserve(str.length());
+
+    for (char c : str) {
+        switch (c) {
+            case '"': escaped += "\\\""; break;
+            case '\\': escaped += "\\\\"; break;
+            case '\b': escaped += "\\b"; break;
+            case '\f': escaped += "\\f"; break;
+            case '\n': escaped += "\\n"; break;
+            case '\r': escaped += "\\r"; break;
+            case '\t': escaped += "\\t"; break;
+            default: escaped += c; break;
+        }
+    }
+
+    return escaped;
+}
+
+RecordingDetectionResult ScreenWatcher::detectRecordingAndOverlays() {
+    RecordingDetectionResult result;
+    result.isRecording = false;
+    result.recordingConfidence = 0.0;
+    result.overlayConfidence = 0.0;
+    result.eventType = "heartbeat";
+
+    result.recordingSources = detectRecordingProcesses();
+    result.recordingConfidence = calculateRecordingConfidence(result.recordingSources, result.virtualCameras);
+    result.isRecording = (result.recordingConfidence > recordingConfidenceThreshold_) || !result.recordingSources.empty();
+
+    if (result.isRecording && !lastRecordingState_) {
+        result.eventType = "recording-detected";
+    } else if (!result.isRecording && lastRecordingState_) {
+        result.eventType = "recording-stopped";
+    }
+
+    lastRecordingState_ = result.isRecording;
+
+    return result;
+}
+
+void ScreenWatcher::setRecordingBlacklist(const std::vector<std::string>& recordingBlacklist) {
+    recordingBlacklist_.clear();
+    for (const auto& item : recordingBlacklist) {
+        recordingBlacklist_.insert(item);
+    }
+}
+
+std::vector<std::string> ScreenWatcher::getVirtualCameras() {
+    return {};
+}
+
+std::vector<OverlayWindow> ScreenWatcher::getOverlayWindows() {
+    return {};
+}
+
+std::vector<ProcessInfo> ScreenWatcher::detectRecordingProcesses() {
+    std::vector<ProcessInfo> recordingProcesses;
+    auto snapshot = ProcessTable::Instance().Acquire();
+
+    for (const auto& process : snapshot->processes) {
+        std::string processName = process.name;
+        std::transform(processName.begin(), processName.end(), processName.begin(), ::tolower);
+
+        if (recordingBlacklist_.find(processName) != recordingBlacklist_.end() ||
+            recordingBlacklist_.find(process.name) != recordingBlacklist_.end()) {
+
+            ProcessInfo procInfo(process.pid, process.name, process.path);
+            procInfo.evidence.push_back("blacklist");
+
+            recordingProcesses.push_back(procInfo);
+        }
+    }
+    return recordingProcesses;
+}
+
+double ScreenWatcher::calculateRecordingConfidence(const std::vector<ProcessInfo>& recordingProcesses, const std::vector<std::string>& virtualCameras) {
+    if (recordingProcesses.empty() && virtualCameras.empty()) return 0.0;
+
+    double confidence = 0.0;
+    confidence += recordingProcesses.size() * 0.4;
+    confidence += virtualCameras.size() * 0.3;
+
+    return std::min(confidence, 1.0);
+}
+
+void ScreenWatcher::initializeRecordingBlacklist() {
+    recordingBlacklist_.insert("obs");
+    recordingBlacklist_.insert("simplescreenrecorder");
+    recordingBlacklist_.insert("kazam");
+    recordingBlacklist_.insert("vokoscreenng");
+    recordingBlacklist_.insert("gpu-screen-recorder");
+    recordingBlacklist_.insert("wf-recorder");
+    recordingBlacklist_.insert("kooha");
+    recordingBlacklist_.insert("peek");
+    recordingBlacklist_.insert("recordmydesktop");
+}
+
+std::vector<ScreenSharingSession> ScreenWatcher::detectLinuxRemoteDesktopSessions() {
+    std::vector<ScreenSharingSession> sessions;
+
+    auto sockets = SocketInventory::Instance().Acquire(kSocketSnapshotMaxAgeMs);
+    auto processes = ProcessTable::Instance().Acquire(kSocketSnapshotMaxAgeMs);
+
+    for (const auto& remote : remoteSessions_.Update(*sockets, processes->processes)) {
+        ScreenSharingSession session;
+        session.method = ScreenSharingMethod::REMOTE_DESKTOP;
+        session.processName = remote.processName.empty() ? remote.service : remote.processName;
+        session.pid = remote.pid;
+        session.targetUrl = remote.peerAddress + ":" + std::to_string(remote.peerPort);
+        session.isActive = true;
+
+        std::stringstream description;
+        if (remote.relayed) {
+            description << remote.service << " session through relay " << session.targetUrl;
+            session.confidence = 0.85;
+        } else if (remote.loopbackPeer) {
+            // A tunnelled viewer (ssh -L) is still remote, but a local client
+            // is possible too
+            description << remote.service << " session on port " << remote.localPort << " from a local peer (tunnel)";
+            session.confidence = 0.75;
+        } else {
+            description << "Inbound " << remote.service << " session on port " << remote.localPort
+                        << " from " << session.targetUrl;
+            session.confidence = 0.95;
+        }
+        description << ", " << remote.durationMs / 1000 << "s";
+        session.description = description.str();
+
+        sessions.push_back(session);
+    }
+
+    return sessions;
+}
+
+std::vector<ScreenSharingSession> ScreenWatcher::detectScreenSharingSessions() {
+    return detectLinuxRemoteDesktopSessions();
+}
+
+bool ScreenWatcher::isScreenBeingCaptured() {
+    auto sessions = detectScreenSharingSessions();
+    return !sessions.empty();
+}
+
+double ScreenWatcher::calculateScreenSharingThreatLevel() {
+    auto sessions = detectScreenSharingSessions();
+
+    if (sessions.empty()) {
+        return 0.0;
+    }
+
+    double maxThreat = 0.0;
+    for (const auto& session : sessions) {
+        switch (session.method) {
+            case ScreenSharingMethod::REMOTE_DESKTOP:
+                // Scaled down for sessions only likely to be remote
+                maxThreat = std::max(maxThreat, std::min(1.0, session.confidence / 0.95));
+                break;
+            default:
+                maxThreat = std::max(maxThreat, 0.7);
+                break;
+        }
+    }
+
+    return maxThreat;
+}
+
+std::vector<ProcessInfo> ScreenWatcher::getRunningProcesses() {
+    return ProcessTable::Instance().Acquire()->processes;
+}
@@ -1,4 +1,7 @@
 #include "ScreenWatcher.h"
+#include "CommandLineFlags.h"
+#include "ProcessTable.h"
+#include "WorkStealingPool.h"
 #include <sstream>
 #include <iostream>
 #include <chrono>
@@ -85,8 +88,8 @@ void ScreenWatcher::stopWatching() {
 void ScreenWatcher::watcherLoop() {
     while (isRunning) {
         try {
-            ScreenStatus status = detectScreenStatus();
-            std::string jsonData = statusToJson(status);
+            auto published = statusPublisher_.Publish(detectScreenStatus());
+            std::string jsonData = statusToJson(published->value);
             
             if (eventCallback) {
                 eventCallback(jsonData);
@@ -102,7 +105,17 @@ void ScreenWatcher::watcherLoop() {
 }
 
 ScreenStatus ScreenWatcher::getCurrentStatus() {
-    return detectScreenStatus();
+    return acquireStatus()->value;
+}
+
+std::shared_ptr<const PublishedSnapshot<ScreenStatus>> ScreenWatcher::acquireStatus() {
+    if (isRunning) {
+        auto published = statusPublisher_.Load();
+        if (published) {
+            return published;
+        }
+    }
+    return statusPublisher_.Publish(detectScreenStatus());
 }
 
 ScreenStatus ScreenWatcher::detectScreenStatus() {
@@ -630,10 +643,17 @@ std::vector<OverlayWindow> ScreenWatcher::getOverlayWindows() {
 
 std::vector<ProcessInfo> ScreenWatcher::detectRecordingProcesses() {
     std::vector<ProcessInfo> recordingProcesses;
-    auto processes = getRunningProcesses();
-    
-    for (auto& process : processes) {
-        ProcessInfo recordingProcess = process;
+    auto snapshot = ProcessTable::Instance().Acquire();
+    const auto& processes = snapshot->processes;
+
+    // Library enumeration per process runs on the shared pool; results keep
+    // snapshot order
+    std::vector<ProcessInfo> analyzed(processes);
+    std::vector<char> keep(processes.size(), 0);
+
+    WorkStealingPool::Instance().ParallelFor(processes.size(), [&](size_t index) {
+        const ProcessInfo& process = processes[index];
+        ProcessInfo& recordingProcess = analyzed[index];
         recordingProcess.evidence.clear();
         
         // Check against recording blacklist
@@ -675,8 +695,12 @@ std::vector<ProcessInfo> ScreenWatcher::detectRecordingProcesses() {
             // Module enumeration may fail for some processes - continue
         }
         
-        if (isBlacklisted || !recordingProcess.evidence.empty()) {
-            recordingProcesses.push_back(recordingProcess);
+        keep[index] = isBlacklisted || !recordingProcess.evidence.empty();
+    });
+
+    for (size_t i = 0; i < analyzed.size(); i++) {
+        if (keep[i]) {
+            recordingProcesses.push_back(std::move(analyzed[i]));
         }
     }
     
@@ -742,75 +766,7 @@ double ScreenWatcher::calculateOverlayConfidence(const std::vector<OverlayWindow
 }
 
 std::vector<ProcessInfo> ScreenWatcher::getRunningProcesses() {
-    std::vector<ProcessInfo> processes;
-    
-#ifdef _WIN32
-    // Windows implementation
-    HANDLE hSnapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
-    if (hSnapshot == INVALID_HANDLE_VALUE) {
-        return processes;
-    }
-    
-    PROCESSENTRY32 pe32;
-    pe32.dwSize = sizeof(PROCESSENTRY32);
-    
-    if (Process32First(hSnapshot, &pe32)) {
-        do {
-            std::string processName(pe32.szExeFile);
-            std::string processPath;
-            
-            // Get process path
-            HANDLE hProcess = OpenProcess(PROCESS_QUERY_INFORMATION | PROCESS_VM_READ, FALSE, pe32.th32ProcessID);
-            if (hProcess != nullptr) {
-                char path[MAX_PATH];
-                DWORD size = sizeof(path);
-                if (GetModuleFileNameEx(hProcess, nullptr, path, size)) {
-                    processPath = std::string(path);
-                }
-                CloseHandle(hProcess);
-            }
-            
-            processes.emplace_back(pe32.th32ProcessID, processName, processPath);
-        } while (Process32Next(hSnapshot, &pe32));
-    }
-    
-    CloseHandle(hSnapshot);
-    
-#elif __APPLE__
-    // macOS implementation
-    int numberOfProcesses = proc_listallpids(nullptr, 0);
-    if (numberOfProcesses <= 0) {
-        return processes;
-    }
-    
-    std::vector<pid_t> pids(numberOfProcesses);
-    numberOfProcesses = proc_listallpids(pids.data(), numberOfProcesses * sizeof(pid_t));
-    
-    for (int i = 0; i < numberOfProcesses; i++) {
-        pid_t pid = pids[i];
-        if (pid <= 0) continue;
-        
-        char pathBuffer[PROC_PIDPATHINFO_MAXSIZE];
-        int ret = proc_pidpath(pid, pathBuffer, sizeof(pathBuffer));
-        
-        if (ret > 0) {
-            std::string fullPath(pathBuffer);
-            std::string processName;
-            
-            // Extract process name
-            size_t lastSlash = fullPath.find_last_of('/');
-            if (lastSlash != std::string::npos) {
-                processName = fullPath.substr(lastSlash + 1);
-            } else {
-                processName = fullPath;
-            }
-            
-            processes.emplace_back(pid, processName, fullPath);
-        }
-    }
-#endif
-    
-    return processes;
+    return ProcessTable::Instance().Acquire()->processes;
 }
 
 // Helper function to get process name for PID on macOS
@@ -1287,8 +1243,8 @@ std::vector<std::string> ScreenWatcher::enumerateVirtualCameras() {
         "Reincubate Camo"
     };
     
-    auto processes = getRunningProcesses();
-    for (const auto& process : processes) {
+    auto snapshot = ProcessTable::Instance().Acquire();
+    for (const auto& process : snapshot->processes) {
         for (const auto& vcamProcess : vcamProcesses) {
             if (process.name.find(vcamProcess) != std::string::npos ||
                 process.path.find(vcamProcess) != std::string::npos) {
@@ -1310,9 +1266,9 @@ std::vector<ScreenSharingSession> ScreenWatcher::detectMacOSScreenCaptureKit() {
         // Check if ScreenCaptureKit is available (macOS 12.3+)
         if (@available(macOS 12.3, *)) {
             // Check for active ScreenCaptureKit sessions by examining processes with screen capture capabilities
-            std::vector<ProcessInfo> processes = getRunningProcesses();
+            auto snapshot = ProcessTable::Instance().Acquire();
 
-            for (const auto& process : processes) {
+            for (const auto& process : snapshot->processes) {
                 bool hasScreenCaptureKit = false;
 
                 // Filter out system and legitimate processes first
@@ -1454,9 +1410,9 @@ std::vector<ScreenSharingSession> ScreenWatcher::detectMacOSCoreGraphicsCapture(
 
     @autoreleasepool {
         // Check for processes using CGDisplayCreateImage or similar APIs
-        std::vector<ProcessInfo> processes = getRunningProcesses();
+        auto snapshot = ProcessTable::Instance().Acquire();
 
-        for (const auto& process : processes) {
+        for (const auto& process : snapshot->processes) {
             std::vector<std::string> libraries = getProcessLibraries(process.pid);
             bool hasCoreGraphics = false;
 
@@ -1519,14 +1475,31 @@ bool ScreenWatcher::isScreenCaptureKitActive() {
 
 std::vector<ScreenSharingSession> ScreenWatcher::scanMacOSBrowserScreenSharing() {
     std::vector<ScreenSharingSession> sessions;
-    std::vector<ProcessInfo> processes = getRunningProcesses();
+    auto snapshot = ProcessTable::Instance().Acquire();
 
     // Browser processes to check
     std::vector<std::string> browserPatterns = {
         "chrome", "firefox", "safari", "edge", "opera", "brave", "vivaldi"
     };
 
-    for (const auto& process : processes) {
+    for (const auto& process : snapshot->processes) {
+        // Switches that skip the capture picker or expose DevTools show intent
+        // regardless of the process name (Electron apps included)
+        if (isBrowserProcessScreenSharing(process)) {
+            ScreenSharingSession session;
+            session.method = ScreenSharingMethod::BROWSER_WEBRTC;
+            session.processName = process.name;
+            session.pid = process.pid;
+            session.description = "Launched with auto-capture or remote-debugging switches";
+            session.confidence = 0.9;
+            session.isActive = true;
+
+            if (session.confidence >= screenSharingConfidenceThreshold_) {
+                sessions.push_back(session);
+                continue;
+            }
+        }
+
         std::string lowerName = process.name;
         std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(), ::tolower);
 
@@ -1576,6 +1549,19 @@ std::vector<ScreenSharingSession> ScreenWatcher::scanMacOSBrowserScreenSharing()
     return sessions;
 }
 
+bool ScreenWatcher::isBrowserProcessScreenSharing(const ProcessInfo& process) {
+    if (!process.commandLine) {
+        return false;
+    }
+
+    for (const auto& flag : CommandLineFlagMatcher::Instance().Scan(*process.commandLine)) {
+        if (flag.compare(0, 16, "cmdline:capture:") == 0 || flag.compare(0, 25, "cmdline:remote-debugging:") == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
 std::vector<ScreenSharingSession> ScreenWatcher::detectScreenSharingSessions() {
     std::vector<ScreenSharingSession> allSessions;
 
@@ -1,4 +1,7 @@
 #include "ScreenWatcher.h"
+#include "CommandLineFlags.h"
+#include "ProcessTable.h"
+#include "WorkStealingPool.h"
 #include <sstream>
 #include <iostream>
 #include <chrono>
@@ -64,7 +67,17 @@ void ScreenWatcher::stopWatching() {
 }
 
 ScreenStatus ScreenWatcher::getCurrentStatus() {
-    return detectScreenStatus();
+    return acquireStatus()->value;
+}
+
+std::shared_ptr<const PublishedSnapshot<ScreenStatus>> ScreenWatcher::acquireStatus() {
+    if (isRunning) {
+        auto published = statusPublisher_.Load();
+        if (published) {
+            return published;
+        }
+    }
+    return statusPublisher_.Publish(detectScreenStatus());
 }
 
 bool ScreenWatcher::isPlatformSupported() {
@@ -294,8 +307,8 @@ ScreenStatus ScreenWatcher::detectScreenStatus() {
 void ScreenWatcher::watcherLoop() {
     while (isRunning) {
         try {
-            ScreenStatus status = getCurrentStatus();
-            std::string json = statusToJson(status);
+            auto published = statusPublisher_.Publish(detectScreenStatus());
+            std::string json = statusToJson(published->value);
 
             if (eventCallback) {
                 eventCallback(json);
@@ -651,44 +664,21 @@ std::vector<OverlayWindow> ScreenWatcher::getOverlayWindows() {
 std::vector<ProcessInfo> ScreenWatcher::detectRecordingProcesses() {
     std::vector<ProcessInfo> recordingProcesses;
 #ifdef _WIN32
-    HANDLE hSnapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
-    if (hSnapshot == INVALID_HANDLE_VALUE) {
-        return recordingProcesses;
-    }
+    auto snapshot = ProcessTable::Instance().Acquire();
 
-    PROCESSENTRY32 pe;
-    pe.dwSize = sizeof(pe);
+    for (const auto& process : snapshot->processes) {
+        std::string processName = process.name;
+        std::transform(processName.begin(), processName.end(), processName.begin(), ::tolower);
 
-    if (Process32First(hSnapshot, &pe)) {
-        do {
-            std::string processName(pe.szExeFile);
-            std::transform(processName.begin(), processName.end(), processName.begin(), ::tolower);
-
-            if (recordingBlacklist_.find(processName) != recordingBlacklist_.end() ||
-                recordingBlacklist_.find(pe.szExeFile) != recordingBlacklist_.end()) {
+        if (recordingBlacklist_.find(processName) != recordingBlacklist_.end() ||
+            recordingBlacklist_.find(process.name) != recordingBlacklist_.end()) {
 
-                ProcessInfo procInfo(pe.th32ProcessID, pe.szExeFile);
+            ProcessInfo procInfo(process.pid, process.name, process.path);
+            procInfo.evidence.push_back("blacklist");
 
-                HANDLE hProcess = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pe.th32ProcessID);
-                if (hProcess) {
-                    WCHAR processPath[MAX_PATH];
-                    DWORD pathSize = MAX_PATH;
-                    if (QueryFullProcessImageNameW(hProcess, 0, processPath, &pathSize)) {
-                        std::wstring wPath(processPath);
-                        procInfo.path = std::string(wPath.begin(), wPath.end());
-                    }
-                    CloseHandle(hProcess);
-                }
-
-                procInfo.evidence.push_back("blacklist");
-
-                recordingProcesses.push_back(procInfo);
-            }
-
-        } while (Process32Next(hSnapshot, &pe));
+            recordingProcesses.push_back(procInfo);
+        }
     }
-
-    CloseHandle(hSnapshot);
 #endif
     return recordingProcesses;
 }
@@ -939,13 +929,14 @@ std::vector<ScreenSharingSession> ScreenWatcher::detectWindowsGraphicsCapture()
 
     // Check for Windows Graphics Capture API usage
     // This is typically used by modern screen sharing applications
-    std::vector<ProcessInfo> processes = getRunningProcesses();
-
-    for (const auto& process : processes) {
-        bool hasGraphicsCapture = false;
+    auto snapshot = ProcessTable::Instance().Acquire();
+    const auto& processes = snapshot->processes;
 
+    // EnumProcessModules per process is the slow part; run it on the shared pool
+    std::vector<char> graphicsCapture(processes.size(), 0);
+    WorkStealingPool::Instance().ParallelFor(processes.size(), [&](size_t index) {
         // Check loaded modules for Graphics Capture API
-        std::vector<std::string> modules = getProcessModules(process.pid);
+        std::vector<std::string> modules = getProcessModules(processes[index].pid);
         for (const auto& module : modules) {
             std::string lowerModule = module;
             std::transform(lowerModule.begin(), lowerModule.end(), lowerModule.begin(), ::tolower);
@@ -953,12 +944,16 @@ std::vector<ScreenSharingSession> ScreenWatcher::detectWindowsGraphicsCapture()
             if (lowerModule.find("windows.graphics.capture") != std::string::npos ||
                 lowerModule.find("winrt") != std::string::npos ||
                 lowerModule.find("screencapture") != std::string::npos) {
-                hasGraphicsCapture = true;
+                graphicsCapture[index] = 1;
                 break;
             }
         }
+    });
+
+    for (size_t i = 0; i < processes.size(); i++) {
+        const ProcessInfo& process = processes[i];
 
-        if (hasGraphicsCapture) {
+        if (graphicsCapture[i]) {
             ScreenSharingSession session;
             session.method = ScreenSharingMethod::APPLICATION_SHARING;
             session.processName = process.name;
@@ -984,14 +979,31 @@ bool ScreenWatcher::isDesktopDuplicationActive() {
 
 std::vector<ScreenSharingSession> ScreenWatcher::scanWindowsBrowserScreenSharing() {
     std::vector<ScreenSharingSession> sessions;
-    std::vector<ProcessInfo> processes = getRunningProcesses();
+    auto snapshot = ProcessTable::Instance().Acquire();
 
     // Browser processes to check
     std::vector<std::string> browserPatterns = {
         "chrome", "firefox", "msedge", "edge", "opera", "brave", "vivaldi"
     };
 
-    for (const auto& process : processes) {
+    for (const auto& process : snapshot->processes) {
+        // Switches that skip the capture picker or expose DevTools show intent
+        // regardless of the process name (Electron apps included)
+        if (isBrowserProcessScreenSharing(process)) {
+            ScreenSharingSession session;
+            session.method = ScreenSharingMethod::BROWSER_WEBRTC;
+            session.processName = process.name;
+            session.pid = process.pid;
+            session.description = "Launched with auto-capture or remote-debugging switches";
+            session.confidence = 0.9;
+            session.isActive = true;
+
+            if (session.confidence >= screenSharingConfidenceThreshold_) {
+                sessions.push_back(session);
+                continue;
+            }
+        }
+
         std::string lowerName = process.name;
         std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(), ::tolower);
 
@@ -1040,6 +1052,19 @@ std::vector<ScreenSharingSession> ScreenWatcher::scanWindowsBrowserScreenSharing
     return sessions;
 }
 
+bool ScreenWatcher::isBrowserProcessScreenSharing(const ProcessInfo& process) {
+    if (!process.commandLine) {
+        return false;
+    }
+
+    for (const auto& flag : CommandLineFlagMatcher::Instance().Scan(*process.commandLine)) {
+        if (flag.compare(0, 16, "cmdline:capture:") == 0 || flag.compare(0, 25, "cmdline:remote-debugging:") == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
 std::vector<ScreenSharingSession> ScreenWatcher::detectScreenSharingSessions() {
     std::vector<ScreenSharingSession> allSessions;
 
@@ -1093,39 +1118,7 @@ double ScreenWatcher::calculateScreenSharingThreatLevel() {
 
 // Missing method implementations for Windows compilation
 std::vector<ProcessInfo> ScreenWatcher::getRunningProcesses() {
-    std::vector<ProcessInfo> processes;
-
-    HANDLE hSnapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
-    if (hSnapshot == INVALID_HANDLE_VALUE) {
-        return processes;
-    }
-
-    PROCESSENTRY32 pe32;
-    pe32.dwSize = sizeof(PROCESSENTRY32);
-
-    if (Process32First(hSnapshot, &pe32)) {
-        do {
-            ProcessInfo info(pe32.th32ProcessID,
-                           std::string(pe32.szExeFile),
-                           "");
-
-            // Get process path
-            HANDLE hProcess = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pe32.th32ProcessID);
-            if (hProcess) {
-                char processPath[MAX_PATH];
-                DWORD pathSize = MAX_PATH;
-                if (QueryFullProcessImageNameA(hProcess, 0, processPath, &pathSize)) {
-                    info.path = std::string(processPath);
-                }
-                CloseHandle(hProcess);
-            }
-
-            processes.push_back(info);
-        } while (Process32Next(hSnapshot, &pe32));
-    }
-
-    CloseHandle(hSnapshot);
-    return processes;
+    return ProcessTable::Instance().Acquire()->processes;
 }
 
 std::vector<std::string> ScreenWatcher::getProcessModules(DWORD processID) {
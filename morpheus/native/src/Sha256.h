@@ -0,0 +1,32 @@
+#ifndef SHA256_H
+#define SHA256_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Streaming SHA-256 (FIPS 180-4). Self-contained so the addon does not depend
+// on which OpenSSL symbols the host Node build exports.
+class Sha256 {
+public:
+    using Digest = std::array<uint8_t, 32>;
+
+    Sha256();
+
+    void Update(const void* data, size_t length);
+    Digest Finish();
+
+    static std::string ToHex(const Digest& digest);
+    static bool FromHex(const std::string& hex, Digest& digest);
+
+private:
+    void Transform(const uint8_t* block);
+
+    uint32_t state_[8];
+    uint8_t buffer_[64];
+    size_t bufferLength_;
+    uint64_t totalLength_;
+};
+
+#endif // SHA256_H
@@ -0,0 +1,357 @@
+#include "SignatureScanner.h"
+#include "ProcessTable.h"
+#include "WorkStealingPool.h"
+#include <algorithm>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdio>
+#endif
+
+SignatureScanner::SignatureScanner() : rules_(Compile(DefaultRules(), 1)) {
+}
+
+SignatureScanner::~SignatureScanner() {
+#ifdef __linux__
+    for (auto& job : jobs_) {
+        if (job->fd >= 0) close(job->fd);
+    }
+#endif
+}
+
+std::vector<SignatureRule> SignatureScanner::DefaultRules() {
+    std::vector<SignatureRule> rules;
+
+    // Interview and exam assistants, found by the product names and endpoints
+    // that survive repacking and renaming of the binary
+    SignatureRule brands;
+    brands.id = "assistant-brand";
+    brands.any = {"cluely.com", "interviewcoder.co", "finalroundai.com", "lockedinai.com",
+                  "parakeet-ai.com", "leetcodewizard.io", "interviewsolver.com", "aiapply.co"};
+    brands.threatLevel = 4;
+    rules.push_back(brands);
+
+    // An app that hides its windows from screen capture and talks to an LLM API
+    SignatureRule stealthOverlay;
+    stealthOverlay.id = "stealth-llm-overlay";
+    stealthOverlay.required = {"setContentProtection"};
+    stealthOverlay.any = {"api.openai.com", "api.anthropic.com", "generativelanguage.googleapis.com",
+                          "api.groq.com", "api.deepseek.com", "api.perplexity.ai", "openrouter.ai/api"};
+    stealthOverlay.threatLevel = 3;
+    rules.push_back(stealthOverlay);
+
+    // Window exclusion from capture plus click-through: the overlay pattern
+    SignatureRule clickThrough;
+    clickThrough.id = "capture-excluded-overlay";
+    clickThrough.required = {"setContentProtection", "setIgnoreMouseEvents", "setAlwaysOnTop"};
+    clickThrough.threatLevel = 2;
+    rules.push_back(clickThrough);
+
+    // Direct clients of several LLM APIs
+    SignatureRule llmClient;
+    llmClient.id = "multi-llm-client";
+    llmClient.any = stealthOverlay.any;
+    llmClient.minAny = 2;
+    llmClient.threatLevel = 2;
+    rules.push_back(llmClient);
+
+    return rules;
+}
+
+std::shared_ptr<const SignatureScanner::CompiledRules> SignatureScanner::Compile(
+    const std::vector<SignatureRule>& rules, uint64_t generation) {
+    auto compiled = std::make_shared<CompiledRules>();
+    compiled->rules = rules;
+    compiled->generation = generation;
+
+    for (size_t r = 0; r < rules.size(); r++) {
+        for (int required = 1; required >= 0; required--) {
+            for (const auto& text : required ? rules[r].required : rules[r].any) {
+                if (text.empty()) continue;
+                compiled->matcher.Add(text, static_cast<int>(compiled->stringRule.size()));
+                compiled->stringRule.push_back(static_cast<int>(r));
+                compiled->stringRequired.push_back(required != 0);
+            }
+        }
+    }
+    compiled->matcher.Compile();
+    return compiled;
+}
+
+std::vector<int> SignatureScanner::Evaluate(const CompiledRules& rules, const std::vector<uint8_t>& seen) {
+    std::vector<int> requiredMissing(rules.rules.size(), 0);
+    std::vector<int> anySeen(rules.rules.size(), 0);
+    std::vector<int> stringCount(rules.rules.size(), 0);
+
+    for (size_t s = 0; s < rules.stringRule.size(); s++) {
+        int rule = rules.stringRule[s];
+        stringCount[rule]++;
+        if (rules.stringRequired[s]) {
+            if (!seen[s]) requiredMissing[rule]++;
+        } else if (seen[s]) {
+            anySeen[rule]++;
+        }
+    }
+
+    std::vector<int> matched;
+    for (size_t r = 0; r < rules.rules.size(); r++) {
+        const SignatureRule& rule = rules.rules[r];
+        if (stringCount[r] == 0 || requiredMissing[r] > 0) continue;
+        if (!rule.any.empty() && anySeen[r] < std::max(1, rule.minAny)) continue;
+        matched.push_back(static_cast<int>(r));
+    }
+    return matched;
+}
+
+void SignatureScanner::SetRules(const std::vector<SignatureRule>& rules) {
+    std::lock_guard<std::mutex> advanceLock(advanceMutex_);
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    rules_ = Compile(rules, rules_->generation + 1);
+    results_.clear();
+#ifdef __linux__
+    for (auto& job : jobs_) {
+        if (job->fd >= 0) close(job->fd);
+    }
+#endif
+    jobs_.clear();
+}
+
+bool SignatureScanner::HasJobLocked(const FileKey& key) const {
+    return std::any_of(jobs_.begin(), jobs_.end(), [&](const std::unique_ptr<Job>& job) { return job->key == key; });
+}
+
+void SignatureScanner::QueueLocked(const FileSlot& slot, int& fd, int ownerPid, unsigned long long ownerStartTime) {
+    if (!slot.opened || results_.count(slot.key) || HasJobLocked(slot.key) || jobs_.size() >= kMaxPendingFiles) {
+        return;
+    }
+
+    std::unique_ptr<Job> job(new Job());
+    job->key = slot.key;
+    job->fd = fd;
+    job->ownerPid = ownerPid;
+    job->ownerStartTime = ownerStartTime;
+    job->limit = std::min<uint64_t>(slot.key.size, kMaxScanBytes);
+    job->rules = rules_;
+    job->seen.assign(rules_->stringRule.size(), 0);
+    jobs_.push_back(std::move(job));
+    fd = -1; // Owned by the job now
+}
+
+SignatureVerdict SignatureScanner::VerdictLocked(const PidEntry& entry) const {
+    SignatureVerdict verdict;
+
+    const std::pair<const FileSlot*, const char*> slots[] = {{&entry.exe, "exe"}, {&entry.asar, "asar"}};
+    for (const auto& slot : slots) {
+        if (!slot.first->opened) continue;
+
+        auto result = results_.find(slot.first->key);
+        if (result == results_.end()) {
+            verdict.state = SignatureVerdict::State::Pending;
+            continue;
+        }
+        if (verdict.state == SignatureVerdict::State::Unavailable) {
+            verdict.state = SignatureVerdict::State::Complete;
+        }
+        for (int rule : result->second) {
+            SignatureMatch match;
+            match.ruleId = rules_->rules[rule].id;
+            match.threatLevel = rules_->rules[rule].threatLevel;
+            match.file = slot.second;
+            verdict.matches.push_back(std::move(match));
+        }
+    }
+    return verdict;
+}
+
+SignatureVerdict SignatureScanner::Lookup(const ProcessInfo& process) {
+#ifdef __linux__
+    auto settled = [&](const FileSlot& slot) {
+        return !slot.opened || results_.count(slot.key) || HasJobLocked(slot.key);
+    };
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = pids_.find(process.pid);
+        if (it != pids_.end() && it->second.startTime == process.startTime && it->second.path == process.path) {
+            // A file neither scanned nor queued: the queue was full, or the rules changed
+            if (settled(it->second.exe) && settled(it->second.asar)) {
+                return VerdictLocked(it->second);
+            }
+        }
+    }
+
+    PidEntry entry;
+    entry.startTime = process.startTime;
+    entry.path = process.path;
+
+    auto openSlot = [](const char* path, FileSlot& slot) {
+        int fd = open(path, O_RDONLY | O_CLOEXEC);
+        struct stat fileStat;
+        if (fd >= 0 && fstat(fd, &fileStat) == 0 && S_ISREG(fileStat.st_mode) && fileStat.st_size > 0) {
+            slot.opened = true;
+            slot.key = FileKey::FromStat(fileStat);
+            return fd;
+        }
+        if (fd >= 0) close(fd);
+        return -1;
+    };
+
+    char exePath[64];
+    snprintf(exePath, sizeof(exePath), "/proc/%d/exe", process.pid);
+    int exeFd = openSlot(exePath, entry.exe);
+
+    // Electron keeps the application code next to the binary
+    int asarFd = -1;
+    size_t slash = process.path.rfind('/');
+    if (entry.exe.opened && slash != std::string::npos) {
+        std::string asarPath = process.path.substr(0, slash) + "/resources/app.asar";
+        asarFd = openSlot(asarPath.c_str(), entry.asar);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    PidEntry& cached = pids_[process.pid];
+    cached = std::move(entry);
+
+    QueueLocked(cached.exe, exeFd, process.pid, process.startTime);
+    QueueLocked(cached.asar, asarFd, 0, 0); // Not write-protected: always streamed
+    if (exeFd >= 0) close(exeFd);
+    if (asarFd >= 0) close(asarFd);
+    return VerdictLocked(cached);
+#else
+    (void)process;
+    return SignatureVerdict();
+#endif
+}
+
+void SignatureScanner::ScanSlice(Job& job, uint64_t bytes) {
+#ifdef __linux__
+    bytes = std::min<uint64_t>(bytes, job.limit - job.offset);
+    if (bytes == 0) {
+        return;
+    }
+
+    const PatternMatcher& matcher = job.rules->matcher;
+    std::vector<uint8_t>& seen = job.seen;
+    auto onMatch = [&seen](int stringId) { seen[stringId] = 1; };
+
+    // Same mapping rule as ExecutableHasher: a shrunk file would SIGBUS
+    struct stat fileStat;
+    if (fstat(job.fd, &fileStat) != 0 || static_cast<uint64_t>(fileStat.st_size) != job.key.size) {
+        job.failed = true;
+        return;
+    }
+
+    unsigned long long ownerStartTime = 0;
+    bool canMap = job.ownerPid > 0 && ProcessTable::ReadStartTime(job.ownerPid, ownerStartTime) &&
+                  ownerStartTime == job.ownerStartTime;
+
+    if (canMap) {
+        static const uint64_t pageSize = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+        uint64_t mapOffset = job.offset & ~(pageSize - 1);
+        size_t mapLength = static_cast<size_t>(job.offset + bytes - mapOffset);
+
+        void* mapping = mmap(nullptr, mapLength, PROT_READ, MAP_PRIVATE, job.fd, static_cast<off_t>(mapOffset));
+        if (mapping != MAP_FAILED) {
+            madvise(mapping, mapLength, MADV_SEQUENTIAL);
+            job.state = matcher.ScanChunk(job.state, static_cast<const char*>(mapping) + (job.offset - mapOffset),
+                                          static_cast<size_t>(bytes), onMatch);
+            munmap(mapping, mapLength);
+            job.offset += bytes;
+            return;
+        }
+    }
+
+    static thread_local std::vector<char> buffer(1024 * 1024);
+    while (bytes > 0) {
+        size_t chunk = static_cast<size_t>(std::min<uint64_t>(bytes, buffer.size()));
+        ssize_t n = pread(job.fd, buffer.data(), chunk, static_cast<off_t>(job.offset));
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) {
+            job.failed = true;
+            return;
+        }
+        job.state = matcher.ScanChunk(job.state, buffer.data(), static_cast<size_t>(n), onMatch);
+        job.offset += static_cast<uint64_t>(n);
+        bytes -= static_cast<uint64_t>(n);
+    }
+#else
+    (void)job;
+    (void)bytes;
+#endif
+}
+
+void SignatureScanner::Advance(size_t byteBudget) {
+#ifdef __linux__
+    std::lock_guard<std::mutex> advanceLock(advanceMutex_);
+
+    struct Slice {
+        Job* job;
+        uint64_t bytes;
+    };
+    std::vector<Slice> slices;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        uint64_t remaining = byteBudget;
+        for (auto& job : jobs_) {
+            if (remaining == 0) break;
+
+            uint64_t take = std::min(job->limit - job->offset, remaining);
+            slices.push_back({job.get(), take});
+            remaining -= take;
+        }
+    }
+
+    if (slices.empty()) {
+        return;
+    }
+
+    WorkStealingPool::Instance().ParallelFor(slices.size(), [&](size_t index) {
+        ScanSlice(*slices[index].job, slices[index].bytes);
+    });
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = jobs_.begin(); it != jobs_.end();) {
+        Job& job = **it;
+        bool complete = job.offset >= job.limit;
+        if (!job.failed && !complete) {
+            ++it;
+            continue;
+        }
+
+        // A failed file is left unscanned; the next lookup of a process using it
+        // reopens and queues it again
+        if (complete && !job.failed) {
+            results_[job.key] = Evaluate(*job.rules, job.seen);
+        }
+        close(job.fd);
+        it = jobs_.erase(it);
+    }
+#else
+    (void)byteBudget;
+#endif
+}
+
+size_t SignatureScanner::PendingFiles() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return jobs_.size();
+}
+
+void SignatureScanner::Sweep(const std::vector<ProcessInfo>& processes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    for (auto it = pids_.begin(); it != pids_.end();) {
+        auto listed = std::lower_bound(processes.begin(), processes.end(), it->first,
+                                       [](const ProcessInfo& process, int pid) { return process.pid < pid; });
+        if (listed == processes.end() || listed->pid != it->first || listed->startTime != it->second.startTime) {
+            it = pids_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
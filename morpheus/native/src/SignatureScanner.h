@@ -0,0 +1,131 @@
+#ifndef SIGNATURE_SCANNER_H
+#define SIGNATURE_SCANNER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "CommonTypes.h"
+#include "FileKey.h"
+#include "PatternMatcher.h"
+
+// A YARA-style rule over literal strings: it matches a file that contains every
+// string in `required` and at least `minAny` distinct strings from `any`.
+// Strings are matched case-insensitively.
+struct SignatureRule {
+    std::string id;
+    std::vector<std::string> required;
+    std::vector<std::string> any;
+    int minAny = 1;      // Ignored when `any` is empty
+    int threatLevel = 3; // ProcessInfo::threatLevel scale; 3 = HIGH
+};
+
+struct SignatureMatch {
+    std::string ruleId;
+    int threatLevel = 0;
+    std::string file; // "exe" or "asar"
+};
+
+struct SignatureVerdict {
+    enum class State {
+        Unavailable, // Nothing to scan (exited, or no access)
+        Pending,     // At least one file is queued or partially scanned
+        Complete
+    };
+
+    State state = State::Unavailable;
+    std::vector<SignatureMatch> matches; // Files already scanned, even while Pending
+};
+
+// Scans each process's executable and, for Electron apps, the resources/app.asar
+// next to it against one Aho-Corasick automaton built from every rule string.
+// Follows ExecutableHasher: files are opened once (the executable through
+// /proc/<pid>/exe), keyed by (device, inode, mtime, size), and scanned a byte
+// budget at a time in Advance() with the automaton state carried between
+// slices, so a string split across two slices still matches. Results are kept
+// per file until the rule set changes. Linux only; other platforms report
+// Unavailable.
+class SignatureScanner {
+public:
+    static constexpr uint64_t kMaxScanBytes = 512ULL * 1024 * 1024; // Larger files are scanned up to this point
+    static constexpr size_t kMaxPendingFiles = 64;                   // Open descriptors held for queued files
+
+    SignatureScanner();
+    ~SignatureScanner();
+
+    // Replaces the rule set; cached results and queued scans are dropped
+    void SetRules(const std::vector<SignatureRule>& rules);
+    static std::vector<SignatureRule> DefaultRules();
+
+    // Matches for the process's files; the first lookup of a file queues it
+    SignatureVerdict Lookup(const ProcessInfo& process);
+
+    // Scans up to byteBudget bytes of queued files
+    void Advance(size_t byteBudget);
+
+    // Files queued or partly scanned
+    size_t PendingFiles();
+
+    // Drops per-pid entries for processes not in the list (sorted by pid); file
+    // results are kept since another process may run the same binary later
+    void Sweep(const std::vector<ProcessInfo>& processes);
+
+private:
+    SignatureScanner(const SignatureScanner&) = delete;
+    SignatureScanner& operator=(const SignatureScanner&) = delete;
+
+    struct CompiledRules {
+        PatternMatcher matcher{true};
+        std::vector<SignatureRule> rules;
+        std::vector<int> stringRule;        // Pattern id -> rule index
+        std::vector<bool> stringRequired;   // Pattern id -> listed under `required`
+        uint64_t generation = 0;
+    };
+
+    struct Job {
+        FileKey key;
+        int fd = -1;
+        int ownerPid = 0;                       // mmap only while a process still runs the file; 0 = never
+        unsigned long long ownerStartTime = 0;
+        uint64_t offset = 0;
+        uint64_t limit = 0;                     // min(size, kMaxScanBytes)
+        int32_t state = 0;                      // Automaton state after `offset` bytes
+        std::vector<uint8_t> seen;              // Pattern id -> occurs in the file
+        bool failed = false;
+        std::shared_ptr<const CompiledRules> rules;
+    };
+
+    struct FileSlot {
+        bool opened = false;
+        FileKey key;
+    };
+
+    struct PidEntry {
+        unsigned long long startTime = 0;
+        std::string path;
+        FileSlot exe;
+        FileSlot asar;
+    };
+
+    static std::shared_ptr<const CompiledRules> Compile(const std::vector<SignatureRule>& rules, uint64_t generation);
+    static std::vector<int> Evaluate(const CompiledRules& rules, const std::vector<uint8_t>& seen);
+    static void ScanSlice(Job& job, uint64_t bytes);
+
+    bool HasJobLocked(const FileKey& key) const;
+    void QueueLocked(const FileSlot& slot, int& fd, int ownerPid, unsigned long long ownerStartTime);
+    SignatureVerdict VerdictLocked(const PidEntry& entry) const;
+
+    std::shared_ptr<const CompiledRules> rules_;
+    std::unordered_map<FileKey, std::vector<int>, FileKeyHash> results_; // File -> matched rule indexes
+    std::unordered_map<int, PidEntry> pids_;
+    std::vector<std::unique_ptr<Job>> jobs_; // FIFO; Job objects stay put while Advance scans them
+
+    std::mutex mutex_;        // Guards everything above
+    std::mutex advanceMutex_; // One Advance at a time; only Advance mutates or removes jobs
+};
+
+#endif // SIGNATURE_SCANNER_H
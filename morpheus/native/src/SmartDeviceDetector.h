@@ -11,6 +11,7 @@
 #include <thread>
 #include "CommonTypes.h"
 #include "SystemDetector.h"
+#include "SnapshotPublisher.h"
 
 #ifdef _WIN32
 #ifndef WIN32_LEAN_AND_MEAN
@@ -87,6 +88,8 @@ public:
     std::vector<InputDeviceInfo> ScanAllInputDevices();
     std::vector<StorageDeviceInfo> ScanAllStorageDevices();
     std::vector<DeviceViolation> GetActiveViolations();
+    // Violations published at the end of the last monitoring pass (generation 0 before the first)
+    std::shared_ptr<const PublishedSnapshot<std::vector<DeviceViolation>>> GetViolationSnapshot();
     SystemSecurityProfile GetSecurityProfile();
 
     // Threat Analysis
@@ -133,7 +136,8 @@ private:
 
     SystemDetector *systemDetector_;
     SystemSecurityProfile securityProfile_;
-    std::vector<DeviceViolation> activeViolations_;
+    std::vector<DeviceViolation> activeViolations_; // Working set, monitor thread only
+    SnapshotPublisher<std::vector<DeviceViolation>> violationPublisher_;
     std::vector<InputDeviceInfo> lastKnownDevices_;
     std::set<std::string> allowedDeviceIds_;
     std::set<std::string> suspiciousVendors_;
@@ -573,6 +573,8 @@ void SmartDeviceDetector::ScanAndAnalyzeDevices() {
     }
 
     lastKnownDevices_ = currentDevices;
+
+    violationPublisher_.Publish(activeViolations_);
 }
 
 void SmartDeviceDetector::EmitViolation(const DeviceViolation& violation) {
@@ -598,10 +600,11 @@ void SmartDeviceDetector::EmitViolation(const DeviceViolation& violation) {
 
 void SmartDeviceDetector::EmitHeartbeat() {
     if (tsfn_) {
-        auto callback = [this](Napi::Env env, Napi::Function jsCallback) {
+        size_t activeViolations = GetViolationSnapshot()->value.size();
+        auto callback = [activeViolations](Napi::Env env, Napi::Function jsCallback) {
             Napi::Object result = Napi::Object::New(env);
             result.Set("type", Napi::String::New(env, "heartbeat"));
-            result.Set("activeViolations", Napi::Number::New(env, activeViolations_.size()));
+            result.Set("activeViolations", Napi::Number::New(env, activeViolations));
             result.Set("timestamp", Napi::Number::New(env, std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count()));
 
             jsCallback.Call({result});
@@ -612,7 +615,15 @@ void SmartDeviceDetector::EmitHeartbeat() {
 }
 
 std::vector<DeviceViolation> SmartDeviceDetector::GetActiveViolations() {
-    return activeViolations_;
+    return GetViolationSnapshot()->value;
+}
+
+std::shared_ptr<const PublishedSnapshot<std::vector<DeviceViolation>>> SmartDeviceDetector::GetViolationSnapshot() {
+    auto published = violationPublisher_.Load();
+    if (!published) {
+        published = std::make_shared<const PublishedSnapshot<std::vector<DeviceViolation>>>();
+    }
+    return published;
 }
 
 SystemSecurityProfile SmartDeviceDetector::GetSecurityProfile() {
@@ -1821,6 +1821,8 @@ void SmartDeviceDetector::ScanAndAnalyzeDevices() {
 
     // Store current devices
     lastKnownDevices_ = currentDevices;
+
+    violationPublisher_.Publish(activeViolations_);
 }
 
 // Cross-platform secondary display detection
@@ -2521,7 +2523,15 @@ bool SmartDeviceDetector::AnalyzeDeviceThreat(const InputDeviceInfo& device) {
 
 // Getter methods
 std::vector<DeviceViolation> SmartDeviceDetector::GetActiveViolations() {
-    return activeViolations_;
+    return GetViolationSnapshot()->value;
+}
+
+std::shared_ptr<const PublishedSnapshot<std::vector<DeviceViolation>>> SmartDeviceDetector::GetViolationSnapshot() {
+    auto published = violationPublisher_.Load();
+    if (!published) {
+        published = std::make_shared<const PublishedSnapshot<std::vector<DeviceViolation>>>();
+    }
+    return published;
 }
 
 SystemSecurityProfile SmartDeviceDetector::GetSecurityProfile() {
@@ -2561,11 +2571,13 @@ void SmartDeviceDetector::EmitHeartbeat() {
     counter_.fetch_add(1);
 
     if (tsfn_) {
-        tsfn_.BlockingCall([this](Napi::Env env, Napi::Function jsCallback) {
+        int counter = counter_.load();
+        int activeViolations = static_cast<int>(GetViolationSnapshot()->value.size());
+        tsfn_.BlockingCall([counter, activeViolations](Napi::Env env, Napi::Function jsCallback) {
             Napi::Object eventObj = Napi::Object::New(env);
             eventObj.Set("type", "heartbeat");
-            eventObj.Set("counter", counter_.load());
-            eventObj.Set("activeViolations", static_cast<int>(activeViolations_.size()));
+            eventObj.Set("counter", counter);
+            eventObj.Set("activeViolations", activeViolations);
 
             jsCallback.Call({eventObj});
         });
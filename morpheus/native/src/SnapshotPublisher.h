@@ -0,0 +1,52 @@
+#ifndef SNAPSHOT_PUBLISHER_H
+#define SNAPSHOT_PUBLISHER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+// Immutable value published by a detector loop
+template <typename T>
+struct PublishedSnapshot {
+    uint64_t generation = 0;
+    std::chrono::steady_clock::time_point publishedAt;
+    T value;
+};
+
+// RCU-style holder for the latest result of a background loop. The loop builds a
+// new value and publishes it; readers take a shared_ptr copy and never block on,
+// or race with, the next scan.
+template <typename T>
+class SnapshotPublisher {
+public:
+    using Snapshot = PublishedSnapshot<T>;
+
+    // Latest snapshot, or nullptr before the first Publish
+    std::shared_ptr<const Snapshot> Load() const {
+        return std::atomic_load(&current_);
+    }
+
+    std::shared_ptr<const Snapshot> Publish(T value) {
+        auto snapshot = std::make_shared<Snapshot>();
+        snapshot->publishedAt = std::chrono::steady_clock::now();
+        snapshot->value = std::move(value);
+
+        // Serialized so generations are published in increasing order
+        std::lock_guard<std::mutex> lock(publishMutex_);
+        snapshot->generation = ++generation_;
+        std::shared_ptr<const Snapshot> published = snapshot;
+        std::atomic_store(&current_, published);
+        return published;
+    }
+
+    uint64_t Generation() const { return generation_.load(); }
+
+private:
+    std::shared_ptr<const Snapshot> current_;
+    std::atomic<uint64_t> generation_{0};
+    std::mutex publishMutex_;
+};
+
+#endif // SNAPSHOT_PUBLISHER_H
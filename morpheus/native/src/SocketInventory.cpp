@@ -0,0 +1,386 @@
+#include "SocketInventory.h"
+#include "ProcessTable.h"
+#include <algorithm>
+#include <cstring>
+#include <unordered_set>
+
+#ifdef __linux__
+#include <arpa/inet.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <linux/inet_diag.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <linux/sock_diag.h>
+#include <linux/tcp.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+
+static std::string FormatAddress(int family, const void* address) {
+    char text[INET6_ADDRSTRLEN];
+    if (!inet_ntop(family, address, text, sizeof(text))) {
+        return "";
+    }
+    return text;
+}
+
+static bool IsUnspecified(int family, const void* address) {
+    static const unsigned char zeros[16] = {0};
+    return memcmp(address, zeros, family == AF_INET ? 4 : 16) == 0;
+}
+
+static void SetRemote(SocketEntry& entry, int family, const void* address, uint16_t port) {
+    entry.remoteAddress = FormatAddress(family, address);
+    entry.remotePort = port;
+    if (family == AF_INET) {
+        entry.remoteBytes[10] = 0xff;
+        entry.remoteBytes[11] = 0xff;
+        memcpy(entry.remoteBytes + 12, address, 4);
+    } else {
+        memcpy(entry.remoteBytes, address, 16);
+    }
+}
+
+// Dumps one (family, protocol) pair. Returns false if the kernel refused the
+// request (no sock_diag, or no inet_diag module for the protocol).
+static bool DumpInetDiag(int family, int protocol, std::vector<SocketEntry>& sockets) {
+    int fd = socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC, NETLINK_SOCK_DIAG);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct {
+        struct nlmsghdr header;
+        struct inet_diag_req_v2 request;
+    } message;
+    memset(&message, 0, sizeof(message));
+    message.header.nlmsg_len = sizeof(message);
+    message.header.nlmsg_type = SOCK_DIAG_BY_FAMILY;
+    message.header.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+    message.request.sdiag_family = static_cast<__u8>(family);
+    message.request.sdiag_protocol = static_cast<__u8>(protocol);
+    message.request.idiag_states = ~0U;
+    if (protocol == IPPROTO_TCP) {
+        message.request.idiag_ext = 1 << (INET_DIAG_INFO - 1);
+    }
+
+    struct sockaddr_nl kernel;
+    memset(&kernel, 0, sizeof(kernel));
+    kernel.nl_family = AF_NETLINK;
+
+    if (sendto(fd, &message, sizeof(message), 0, reinterpret_cast<struct sockaddr*>(&kernel), sizeof(kernel)) < 0) {
+        close(fd);
+        return false;
+    }
+
+    const SocketEntry::Protocol entryProtocol =
+        protocol == IPPROTO_TCP ? SocketEntry::Protocol::Tcp : SocketEntry::Protocol::Udp;
+    static thread_local std::vector<char> buffer(64 * 1024);
+    bool ok = true;
+    bool done = false;
+
+    while (!done) {
+        ssize_t received = recv(fd, buffer.data(), buffer.size(), 0);
+        if (received < 0 && errno == EINTR) continue;
+        if (received <= 0) {
+            ok = false;
+            break;
+        }
+
+        int remaining = static_cast<int>(received);
+        for (struct nlmsghdr* header = reinterpret_cast<struct nlmsghdr*>(buffer.data()); NLMSG_OK(header, remaining);
+             header = NLMSG_NEXT(header, remaining)) {
+            if (header->nlmsg_type == NLMSG_DONE) {
+                done = true;
+                break;
+            }
+            if (header->nlmsg_type == NLMSG_ERROR) {
+                ok = false;
+                done = true;
+                break;
+            }
+
+            const struct inet_diag_msg* diag = static_cast<const struct inet_diag_msg*>(NLMSG_DATA(header));
+            SocketEntry entry;
+            entry.protocol = entryProtocol;
+            entry.family = diag->idiag_family;
+            entry.state = diag->idiag_state;
+            entry.inode = diag->idiag_inode;
+            entry.uid = static_cast<int>(diag->idiag_uid);
+            entry.localAddress = FormatAddress(family, diag->id.idiag_src);
+            entry.localPort = ntohs(diag->id.idiag_sport);
+            if (diag->id.idiag_dport != 0 && !IsUnspecified(family, diag->id.idiag_dst)) {
+                SetRemote(entry, family, diag->id.idiag_dst, ntohs(diag->id.idiag_dport));
+            }
+
+            int attributesLength = static_cast<int>(header->nlmsg_len - NLMSG_LENGTH(sizeof(*diag)));
+            for (const struct rtattr* attribute = reinterpret_cast<const struct rtattr*>(diag + 1);
+                 RTA_OK(attribute, attributesLength); attribute = RTA_NEXT(attribute, attributesLength)) {
+                // Older kernels send a shorter tcp_info without the byte counters
+                if (attribute->rta_type == INET_DIAG_INFO &&
+                    RTA_PAYLOAD(attribute) >= offsetof(struct tcp_info, tcpi_bytes_received) + sizeof(uint64_t)) {
+                    struct tcp_info info;
+                    memcpy(&info, RTA_DATA(attribute), std::min<size_t>(RTA_PAYLOAD(attribute), sizeof(info)));
+                    entry.bytesSent = info.tcpi_bytes_acked;
+                    entry.bytesReceived = info.tcpi_bytes_received;
+                }
+            }
+            sockets.push_back(std::move(entry));
+        }
+    }
+
+    close(fd);
+    return ok;
+}
+
+// Parses one /proc/net table. Addresses are the raw 32-bit words of the
+// network-order address printed in host order, so copying the parsed words
+// back into memory restores the original bytes.
+static bool ReadProcNetFile(const char* path, int family, SocketEntry::Protocol protocol,
+                            std::vector<SocketEntry>& sockets) {
+    FILE* file = fopen(path, "re");
+    if (!file) {
+        return false;
+    }
+
+    auto parseAddress = [family](const char* text, unsigned char* address, uint16_t& port) {
+        size_t words = family == AF_INET ? 1 : 4;
+        if (strlen(text) < words * 8 + 2) return false;
+        for (size_t w = 0; w < words; w++) {
+            char hex[9];
+            memcpy(hex, text + w * 8, 8);
+            hex[8] = '\0';
+            uint32_t word = static_cast<uint32_t>(strtoul(hex, nullptr, 16));
+            memcpy(address + w * 4, &word, 4);
+        }
+        const char* colon = text + words * 8;
+        if (*colon != ':') return false;
+        port = static_cast<uint16_t>(strtoul(colon + 1, nullptr, 16));
+        return true;
+    };
+
+    char line[512];
+    if (!fgets(line, sizeof(line), file)) { // Header
+        fclose(file);
+        return false;
+    }
+
+    while (fgets(line, sizeof(line), file)) {
+        char local[64], remote[64];
+        unsigned state = 0;
+        unsigned uid = 0;
+        unsigned long long inode = 0;
+        // sl local rem st tx:rx tr:when retrnsmt uid timeout inode
+        if (sscanf(line, " %*d: %63s %63s %x %*x:%*x %*x:%*x %*x %u %*d %llu", local, remote, &state, &uid, &inode) != 5) {
+            continue;
+        }
+
+        unsigned char localAddress[16] = {0}, remoteAddress[16] = {0};
+        SocketEntry entry;
+        entry.protocol = protocol;
+        entry.family = family;
+        entry.state = static_cast<int>(state);
+        entry.uid = static_cast<int>(uid);
+        entry.inode = inode;
+        uint16_t remotePort = 0;
+        if (!parseAddress(local, localAddress, entry.localPort) || !parseAddress(remote, remoteAddress, remotePort)) {
+            continue;
+        }
+        entry.localAddress = FormatAddress(family, localAddress);
+        if (remotePort != 0 && !IsUnspecified(family, remoteAddress)) {
+            SetRemote(entry, family, remoteAddress, remotePort);
+        }
+        sockets.push_back(std::move(entry));
+    }
+
+    fclose(file);
+    return true;
+}
+#endif
+
+SocketInventory::SocketInventory() : sockDiagFailed_(false), source_(SocketInventorySource::None) {
+}
+
+bool SocketInventory::DumpSockDiag(std::vector<SocketEntry>& sockets) {
+#ifdef __linux__
+    const int families[] = {AF_INET, AF_INET6};
+    const int protocols[] = {IPPROTO_TCP, IPPROTO_UDP};
+    for (int family : families) {
+        for (int protocol : protocols) {
+            if (!DumpInetDiag(family, protocol, sockets)) {
+                return false;
+            }
+        }
+    }
+    return true;
+#else
+    (void)sockets;
+    return false;
+#endif
+}
+
+bool SocketInventory::ReadProcNet(std::vector<SocketEntry>& sockets) {
+#ifdef __linux__
+    // Missing IPv6 tables are fine (ipv6 disabled); IPv4 TCP must be there
+    bool ok = ReadProcNetFile("/proc/net/tcp", AF_INET, SocketEntry::Protocol::Tcp, sockets);
+    ReadProcNetFile("/proc/net/tcp6", AF_INET6, SocketEntry::Protocol::Tcp, sockets);
+    ReadProcNetFile("/proc/net/udp", AF_INET, SocketEntry::Protocol::Udp, sockets);
+    ReadProcNetFile("/proc/net/udp6", AF_INET6, SocketEntry::Protocol::Udp, sockets);
+    return ok;
+#else
+    (void)sockets;
+    return false;
+#endif
+}
+
+void SocketInventory::ResolveOwners(std::vector<SocketEntry>& sockets, const std::vector<ProcessInfo>& processes) {
+#ifdef __linux__
+    auto findProcess = [&](int pid) {
+        auto it = std::lower_bound(processes.begin(), processes.end(), pid,
+                                   [](const ProcessInfo& process, int p) { return process.pid < p; });
+        return (it != processes.end() && it->pid == pid) ? &*it : nullptr;
+    };
+
+    // Forget closed sockets, and owners that exited or whose pid was reused
+    std::unordered_set<unsigned long long> live;
+    live.reserve(sockets.size());
+    for (const auto& socket : sockets) {
+        if (socket.inode != 0) live.insert(socket.inode);
+    }
+    for (auto it = owners_.begin(); it != owners_.end();) {
+        const ProcessInfo* owner = findProcess(it->second.pid);
+        if (!live.count(it->first) || !owner || owner->startTime != it->second.startTime) {
+            it = owners_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    for (auto it = unowned_.begin(); it != unowned_.end();) {
+        it = live.count(it->first) ? std::next(it) : unowned_.erase(it);
+    }
+
+    // Inodes needing a walk, and the uids that own them
+    std::unordered_set<unsigned long long> pending;
+    std::unordered_set<int> pendingUids;
+    for (const auto& socket : sockets) {
+        if (socket.inode == 0 || owners_.count(socket.inode)) continue;
+        auto unowned = unowned_.find(socket.inode);
+        if (unowned != unowned_.end() && --unowned->second > 0) continue;
+        if (pending.insert(socket.inode).second) {
+            pendingUids.insert(socket.uid);
+        }
+    }
+
+    if (!pending.empty()) {
+        // Candidates: same uid (or uid unknown); processes that owned sockets
+        // before are the likeliest to have opened the new ones
+        std::vector<const ProcessInfo*> candidates;
+        for (const auto& process : processes) {
+            if (process.uid < 0 || pendingUids.count(process.uid)) {
+                candidates.push_back(&process);
+            }
+        }
+        std::stable_partition(candidates.begin(), candidates.end(), [&](const ProcessInfo* process) {
+            return ownerSocketCounts_.count(process->pid) > 0;
+        });
+
+        char path[64];
+        for (const ProcessInfo* process : candidates) {
+            if (pending.empty()) break;
+
+            snprintf(path, sizeof(path), "/proc/%d/fd", process->pid);
+            int dirFd = open(path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+            if (dirFd < 0) continue;
+            DIR* dir = fdopendir(dirFd);
+            if (!dir) {
+                close(dirFd);
+                continue;
+            }
+
+            struct dirent* entry;
+            while ((entry = readdir(dir)) != nullptr && !pending.empty()) {
+                if (entry->d_name[0] == '.') continue;
+
+                // stat through the fd link yields the socket inode without a readlink
+                struct stat fileStat;
+                if (fstatat(dirFd, entry->d_name, &fileStat, 0) != 0 || !S_ISSOCK(fileStat.st_mode)) continue;
+
+                auto found = pending.find(static_cast<unsigned long long>(fileStat.st_ino));
+                if (found == pending.end()) continue;
+                owners_[*found] = Owner{process->pid, process->startTime};
+                unowned_.erase(*found);
+                pending.erase(found);
+            }
+            closedir(dir);
+        }
+
+        // Other network namespaces, or processes we may not inspect
+        for (unsigned long long inode : pending) {
+            unowned_[inode] = kUnownedRetryRefreshes;
+        }
+    }
+
+    ownerSocketCounts_.clear();
+    for (auto& socket : sockets) {
+        auto owner = socket.inode ? owners_.find(socket.inode) : owners_.end();
+        if (owner != owners_.end()) {
+            socket.pid = owner->second.pid;
+            socket.startTime = owner->second.startTime;
+            ownerSocketCounts_[socket.pid]++;
+        }
+    }
+#else
+    (void)sockets;
+    (void)processes;
+#endif
+}
+
+std::vector<SocketEntry> SocketInventory::Refresh(const std::vector<ProcessInfo>& processes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::vector<SocketEntry> sockets;
+    source_ = SocketInventorySource::None;
+
+    if (!sockDiagFailed_) {
+        if (DumpSockDiag(sockets)) {
+            source_ = SocketInventorySource::SockDiag;
+        } else {
+            // Seccomp'd or built without inet_diag: use /proc/net from now on
+            sockDiagFailed_ = true;
+            sockets.clear();
+        }
+    }
+    if (source_ == SocketInventorySource::None && ReadProcNet(sockets)) {
+        source_ = SocketInventorySource::ProcNet;
+    }
+
+    ResolveOwners(sockets, processes);
+    return sockets;
+}
+
+SocketInventory& SocketInventory::Instance() {
+    static SocketInventory instance;
+    return instance;
+}
+
+std::shared_ptr<const SocketInventorySnapshot> SocketInventory::Acquire(int maxAgeMs) {
+    std::lock_guard<std::mutex> lock(snapshotMutex_);
+    auto now = std::chrono::steady_clock::now();
+    if (snapshot_ && now - snapshot_->capturedAt < std::chrono::milliseconds(maxAgeMs)) {
+        return snapshot_;
+    }
+
+    auto processes = ProcessTable::Instance().Acquire(maxAgeMs);
+    auto snapshot = std::make_shared<SocketInventorySnapshot>();
+    snapshot->generation = snapshot_ ? snapshot_->generation + 1 : 1;
+    snapshot->capturedAt = now;
+    snapshot->sockets = Refresh(processes->processes);
+    snapshot_ = snapshot;
+    return snapshot_;
+}
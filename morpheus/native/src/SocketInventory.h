@@ -0,0 +1,96 @@
+#ifndef SOCKET_INVENTORY_H
+#define SOCKET_INVENTORY_H
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "CommonTypes.h"
+
+// One TCP or UDP socket, attributed to the process holding it
+struct SocketEntry {
+    enum class Protocol : uint8_t { Tcp, Udp };
+
+    Protocol protocol = Protocol::Tcp;
+    int family = 0;                   // AF_INET or AF_INET6
+    std::string localAddress;
+    uint16_t localPort = 0;
+    std::string remoteAddress;        // Empty for listening and unconnected sockets
+    uint16_t remotePort = 0;
+    uint8_t remoteBytes[16] = {};     // remoteAddress in network order, IPv4 as IPv4-mapped IPv6
+    int state = 0;                    // Kernel TCP state numbering (1 = ESTABLISHED, 10 = LISTEN); UDP uses 1 or 7
+    unsigned long long inode = 0;     // 0 for sockets no descriptor refers to (TIME_WAIT)
+    int uid = -1;
+    uint64_t bytesSent = 0;           // TCP only, and only from sock_diag (tcp_info); 0 otherwise
+    uint64_t bytesReceived = 0;
+    int pid = 0;                      // 0 if no process could be found
+    unsigned long long startTime = 0;
+
+    bool IsListening() const { return protocol == Protocol::Tcp && state == 10; }
+    bool IsConnected() const { return !remoteAddress.empty(); }
+};
+
+// Immutable result of one refresh of the shared inventory
+struct SocketInventorySnapshot {
+    uint64_t generation = 0;
+    std::chrono::steady_clock::time_point capturedAt;
+    std::vector<SocketEntry> sockets;
+};
+
+enum class SocketInventorySource {
+    None = 0,
+    SockDiag = 1, // NETLINK_SOCK_DIAG dump
+    ProcNet = 2   // /proc/net/{tcp,udp}{,6}
+};
+
+// TCP and UDP sockets of the host, each mapped to its owning process through an
+// inode -> pid index. The index is maintained incrementally: a refresh only
+// walks /proc/<pid>/fd when the dump contains socket inodes it has not seen,
+// walking processes of the socket's uid (previous socket owners first) and
+// stopping once every new inode is placed. Inodes no process could be found for
+// are retried after a few refreshes rather than on every one. Linux only; other
+// platforms return no sockets.
+class SocketInventory {
+public:
+    static constexpr int kUnownedRetryRefreshes = 8;
+    static constexpr int kDefaultMaxAgeMs = 1000;
+
+    SocketInventory();
+
+    // Inventory shared by ProcessWatcher and ScreenWatcher. As with ProcessTable,
+    // the first caller past maxAgeMs refreshes (against the shared process
+    // table) and everyone else reuses that snapshot.
+    static SocketInventory& Instance();
+    std::shared_ptr<const SocketInventorySnapshot> Acquire(int maxAgeMs = kDefaultMaxAgeMs);
+
+    // processes must be sorted by pid
+    std::vector<SocketEntry> Refresh(const std::vector<ProcessInfo>& processes);
+
+    SocketInventorySource Source() const { return source_; }
+
+private:
+    struct Owner {
+        int pid = 0;
+        unsigned long long startTime = 0;
+    };
+
+    bool DumpSockDiag(std::vector<SocketEntry>& sockets);
+    static bool ReadProcNet(std::vector<SocketEntry>& sockets);
+    void ResolveOwners(std::vector<SocketEntry>& sockets, const std::vector<ProcessInfo>& processes);
+
+    std::unordered_map<unsigned long long, Owner> owners_; // Socket inode -> process
+    std::unordered_map<int, unsigned> ownerSocketCounts_;  // Pid -> sockets it owned at the last refresh
+    std::unordered_map<unsigned long long, int> unowned_;  // Socket inode -> refreshes until retried
+    bool sockDiagFailed_;
+    SocketInventorySource source_;
+    std::mutex mutex_;
+
+    std::shared_ptr<const SocketInventorySnapshot> snapshot_;
+    std::mutex snapshotMutex_; // Guards snapshot_ and serializes Acquire refreshes
+};
+
+#endif // SOCKET_INVENTORY_H
@@ -1,4 +1,5 @@
 #include "VMDetector.h"
+#include "ProcessTable.h"
 #include <iostream>
 #include <algorithm>
 #include <sstream>
@@ -492,33 +493,23 @@ std::vector<std::string> VMDetector::checkWindowsVMProcesses() {
     std::vector<std::string> foundProcesses;
     
     try {
-        HANDLE hProcessSnap = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
-        if (hProcessSnap == INVALID_HANDLE_VALUE) {
-            return foundProcesses;
-        }
-        
-        PROCESSENTRY32 pe32;
-        pe32.dwSize = sizeof(PROCESSENTRY32);
+        auto snapshot = ProcessTable::Instance().Acquire();
         
-        if (Process32First(hProcessSnap, &pe32)) {
-            do {
-                std::string processName(pe32.szExeFile);
-                std::transform(processName.begin(), processName.end(), processName.begin(), ::tolower);
+        for (const auto& process : snapshot->processes) {
+            std::string processName = process.name;
+            std::transform(processName.begin(), processName.end(), processName.begin(), ::tolower);
+            
+            for (const auto& vmProcess : vmProcessNames) {
+                std::string vmProcessLower = vmProcess;
+                std::transform(vmProcessLower.begin(), vmProcessLower.end(), vmProcessLower.begin(), ::tolower);
                 
-                for (const auto& vmProcess : vmProcessNames) {
-                    std::string vmProcessLower = vmProcess;
-                    std::transform(vmProcessLower.begin(), vmProcessLower.end(), vmProcessLower.begin(), ::tolower);
-                    
-                    if (processName.find(vmProcessLower) != std::string::npos) {
-                        foundProcesses.push_back(pe32.szExeFile);
-                        std::cout << "[VMDetector] Found VM process: " << pe32.szExeFile << std::endl;
-                        break;
-                    }
+                if (processName.find(vmProcessLower) != std::string::npos) {
+                    foundProcesses.push_back(process.name);
+                    std::cout << "[VMDetector] Found VM process: " << process.name << std::endl;
+                    break;
                 }
-            } while (Process32Next(hProcessSnap, &pe32));
+            }
         }
-        
-        CloseHandle(hProcessSnap);
     } catch (...) {
         std::cout << "[VMDetector] Process enumeration failed" << std::endl;
     }
@@ -641,14 +632,11 @@ std::vector<std::string> VMDetector::checkMacOSVMProcesses() {
     std::vector<std::string> foundProcesses;
     
     try {
-        FILE* pipe = popen("ps -axo comm 2>/dev/null", "r");
-        if (!pipe) return foundProcesses;
-        
-        char buffer[512];
+        auto snapshot = ProcessTable::Instance().Acquire();
         
-        while (fgets(buffer, sizeof(buffer), pipe) != NULL) {
-            std::string processName(buffer);
-            processName.erase(processName.find_last_not_of(" \n\r\t") + 1);
+        for (const auto& process : snapshot->processes) {
+            // Same string `ps -axo comm` used to report: the executable path
+            const std::string& processName = process.path.empty() ? process.name : process.path;
             
             for (const auto& vmProcess : vmProcessNames) {
                 if (processName.find(vmProcess) != std::string::npos) {
@@ -658,8 +646,6 @@ std::vector<std::string> VMDetector::checkMacOSVMProcesses() {
                 }
             }
         }
-        
-        pclose(pipe);
     } catch (...) {
         std::cout << "[VMDetector] Process enumeration failed" << std::endl;
     }
@@ -0,0 +1,201 @@
+#include "WorkStealingPool.h"
+#include <algorithm>
+#include <chrono>
+#include <exception>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#elif __APPLE__
+#include <pthread.h>
+#include <sys/qos.h>
+#elif __linux__
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+WorkStealingPool& WorkStealingPool::Instance() {
+    static WorkStealingPool instance;
+    return instance;
+}
+
+WorkStealingPool::WorkStealingPool()
+    : queued_(0), nextQueue_(0), maxParallelism_(DefaultParallelism()), stopping_(false) {
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    stopping_.store(true);
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+    }
+    wake_.notify_all();
+
+    for (auto& thread : threads_) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+}
+
+size_t WorkStealingPool::DefaultParallelism() {
+    size_t hardware = std::thread::hardware_concurrency();
+    return std::max<size_t>(1, hardware / 2);
+}
+
+void WorkStealingPool::SetMaxParallelism(size_t maxParallelism) {
+    maxParallelism_.store(maxParallelism > 0 ? maxParallelism : DefaultParallelism());
+}
+
+size_t WorkStealingPool::MaxParallelism() const {
+    return maxParallelism_.load();
+}
+
+void WorkStealingPool::StartWorkers() {
+    // The caller of ParallelFor is one of the participants
+    size_t hardware = std::max<unsigned>(2, std::thread::hardware_concurrency());
+    size_t workerCount = hardware - 1;
+
+    for (size_t i = 0; i < workerCount; i++) {
+        queues_.push_back(std::make_unique<WorkerQueue>());
+    }
+    for (size_t i = 0; i < workerCount; i++) {
+        threads_.emplace_back([this, i]() { WorkerLoop(i); });
+    }
+}
+
+void WorkStealingPool::WorkerLoop(size_t index) {
+#ifdef _WIN32
+    SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_BELOW_NORMAL);
+#elif __APPLE__
+    pthread_set_qos_class_self_np(QOS_CLASS_UTILITY, 0);
+#elif __linux__
+    setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), 10);
+#endif
+
+    while (!stopping_.load()) {
+        if (TryRunOne(index)) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        wake_.wait(lock, [this]() { return stopping_.load() || queued_.load() > 0; });
+    }
+}
+
+void WorkStealingPool::Push(std::function<void()> task) {
+    // Counted before it becomes visible so a thief can never take the count below zero
+    queued_.fetch_add(1);
+    size_t target = nextQueue_.fetch_add(1) % queues_.size();
+    std::lock_guard<std::mutex> lock(queues_[target]->mutex);
+    queues_[target]->tasks.push_back(std::move(task));
+}
+
+bool WorkStealingPool::TryRunOne(size_t preferred) {
+    std::function<void()> task;
+    size_t count = queues_.size();
+
+    // Own queue from the front, everyone else's from the back
+    for (size_t offset = 0; offset < count && !task; offset++) {
+        WorkerQueue& queue = *queues_[(preferred + offset) % count];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) continue;
+
+        if (offset == 0) {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        } else {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        }
+    }
+
+    if (!task) {
+        return false;
+    }
+
+    queued_.fetch_sub(1);
+    task();
+    return true;
+}
+
+void WorkStealingPool::ParallelFor(size_t count, const std::function<void(size_t)>& fn) {
+    if (count == 0) {
+        return;
+    }
+
+    std::call_once(startOnce_, [this]() { StartWorkers(); });
+
+    size_t width = std::min({maxParallelism_.load(), count, queues_.size() + 1});
+    if (width <= 1) {
+        for (size_t i = 0; i < count; i++) {
+            fn(i);
+        }
+        return;
+    }
+
+    // Participants claim small chunks from a shared cursor, so a few slow
+    // processes do not leave the other threads idle
+    size_t grain = std::max<size_t>(1, count / (width * 4));
+    std::atomic<size_t> cursor(0);
+    std::exception_ptr firstError;
+    std::mutex errorMutex;
+
+    auto body = [&]() {
+        while (true) {
+            size_t begin = cursor.fetch_add(grain);
+            if (begin >= count) break;
+            size_t end = std::min(count, begin + grain);
+            for (size_t i = begin; i < end; i++) {
+                try {
+                    fn(i);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(errorMutex);
+                    if (!firstError) firstError = std::current_exception();
+                }
+            }
+        }
+    };
+
+    size_t helpers = width - 1;
+    std::mutex doneMutex;
+    std::condition_variable done;
+    size_t remaining = helpers;
+
+    for (size_t i = 0; i < helpers; i++) {
+        Push([&]() {
+            body();
+            // Notify under the lock: the caller's stack frame may go away as soon
+            // as it observes remaining == 0
+            std::lock_guard<std::mutex> lock(doneMutex);
+            remaining--;
+            done.notify_all();
+        });
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+    }
+    wake_.notify_all();
+
+    body();
+
+    // Help with queued work (ours or another caller's) rather than block while
+    // our helpers are still waiting in a busy worker's queue
+    size_t preferred = nextQueue_.load();
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(doneMutex);
+            if (remaining == 0) break;
+        }
+        if (!TryRunOne(preferred)) {
+            std::unique_lock<std::mutex> lock(doneMutex);
+            done.wait_for(lock, std::chrono::milliseconds(1), [&]() { return remaining == 0; });
+        }
+    }
+
+    if (firstError) {
+        std::rethrow_exception(firstError);
+    }
+}
@@ -0,0 +1,62 @@
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Shared executor for per-process deep analysis (module enumeration, path and
+// capability checks). Each worker owns a task deque and steals from the others
+// when it runs dry; workers run at reduced priority so a deep scan never competes
+// with the exam UI. Results are written per index by the caller's function, so
+// output order never depends on scheduling.
+class WorkStealingPool {
+public:
+    static WorkStealingPool& Instance();
+
+    // Upper bound on threads (including the caller) used by one ParallelFor.
+    // 0 restores the default of half the hardware threads.
+    void SetMaxParallelism(size_t maxParallelism);
+    size_t MaxParallelism() const;
+
+    // Runs fn(i) for every i in [0, count) and returns once all have finished.
+    // The calling thread takes part. The first exception thrown by fn is
+    // rethrown here after the remaining indices have run.
+    void ParallelFor(size_t count, const std::function<void(size_t)>& fn);
+
+    ~WorkStealingPool();
+
+private:
+    struct WorkerQueue {
+        std::deque<std::function<void()>> tasks;
+        std::mutex mutex;
+    };
+
+    WorkStealingPool();
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    void StartWorkers();
+    void WorkerLoop(size_t index);
+    void Push(std::function<void()> task);
+    bool TryRunOne(size_t preferred);
+    static size_t DefaultParallelism();
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues_;
+    std::vector<std::thread> threads_;
+    std::once_flag startOnce_;
+    std::mutex sleepMutex_;
+    std::condition_variable wake_;
+    std::atomic<size_t> queued_;
+    std::atomic<size_t> nextQueue_;
+    std::atomic<size_t> maxParallelism_;
+    std::atomic<bool> stopping_;
+};
+
+#endif // WORK_STEALING_POOL_H
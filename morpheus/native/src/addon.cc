@@ -12,6 +12,10 @@
 #endif
 
 #include <napi.h>
+#include <algorithm>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
 #include "ProcessWatcher.h"
 #include "ScreenWatcher.h"
 #include "VMDetector.h"
@@ -21,6 +25,8 @@
 #include "SystemDetector.h"
 #include "SmartDeviceDetector.h"
 #include "PermissionChecker.h"
+#include "WorkStealingPool.h"
+#include "ProcessTable.h"
 
 static ProcessWatcher* process_watcher_instance = nullptr;
 static ScreenWatcher* screen_watcher_instance = nullptr;
@@ -31,6 +37,161 @@ static ClipboardWatcher* clipboard_watcher_instance = nullptr;
 static SystemDetector* system_detector_instance = nullptr;
 static SmartDeviceDetector* smart_device_detector_instance = nullptr;
 
+// Held by *Async scans while they run on the thread pool (serializing scans of
+// the same detector) and by the stop functions before deleting an instance.
+// The synchronous ProcessWatcher getters take it too, so they never run
+// alongside a queued scan.
+static std::mutex process_watcher_scan_mutex;
+static std::mutex screen_watcher_scan_mutex;
+static std::mutex vm_detector_scan_mutex;
+static std::mutex smart_device_detector_scan_mutex;
+
+// Entries are SHA-256 hex strings or { sha256, preHash (16 hex digits), label }
+static std::vector<KnownBadExecutable> ParseKnownBadExecutables(const Napi::Array& array) {
+    std::vector<KnownBadExecutable> entries;
+    for (uint32_t i = 0; i < array.Length(); i++) {
+        Napi::Value value = array.Get(i);
+        KnownBadExecutable entry;
+        std::string sha256;
+
+        if (value.IsString()) {
+            sha256 = value.As<Napi::String>().Utf8Value();
+        } else if (value.IsObject()) {
+            Napi::Object object = value.As<Napi::Object>();
+            if (object.Has("sha256") && object.Get("sha256").IsString()) {
+                sha256 = object.Get("sha256").As<Napi::String>().Utf8Value();
+            }
+            if (object.Has("preHash") && object.Get("preHash").IsString()) {
+                std::string preHash = object.Get("preHash").As<Napi::String>().Utf8Value();
+                char* end = nullptr;
+                entry.preHash = strtoull(preHash.c_str(), &end, 16);
+                entry.hasPreHash = !preHash.empty() && end && *end == '\0';
+            }
+            if (object.Has("label") && object.Get("label").IsString()) {
+                entry.label = object.Get("label").As<Napi::String>().Utf8Value();
+            }
+        }
+
+        if (!Sha256::FromHex(sha256, entry.sha256)) continue;
+        if (entry.label.empty()) entry.label = sha256.substr(0, 12);
+        entries.push_back(std::move(entry));
+    }
+    return entries;
+}
+
+// Entries are { id, required: [strings], any: [strings], minAny, threatLevel };
+// an empty list selects the built-in rules
+static std::vector<SignatureRule> ParseSignatureRules(const Napi::Array& array) {
+    auto strings = [](const Napi::Object& object, const char* key) {
+        std::vector<std::string> values;
+        if (!object.Has(key) || !object.Get(key).IsArray()) return values;
+        Napi::Array list = object.Get(key).As<Napi::Array>();
+        for (uint32_t i = 0; i < list.Length(); i++) {
+            if (list.Get(i).IsString()) {
+                values.push_back(list.Get(i).As<Napi::String>().Utf8Value());
+            }
+        }
+        return values;
+    };
+
+    std::vector<SignatureRule> rules;
+    for (uint32_t i = 0; i < array.Length(); i++) {
+        if (!array.Get(i).IsObject()) continue;
+        Napi::Object object = array.Get(i).As<Napi::Object>();
+        if (!object.Has("id") || !object.Get("id").IsString()) continue;
+
+        SignatureRule rule;
+        rule.id = object.Get("id").As<Napi::String>().Utf8Value();
+        rule.required = strings(object, "required");
+        rule.any = strings(object, "any");
+        if (object.Has("minAny") && object.Get("minAny").IsNumber()) {
+            rule.minAny = object.Get("minAny").As<Napi::Number>().Int32Value();
+        }
+        if (object.Has("threatLevel") && object.Get("threatLevel").IsNumber()) {
+            rule.threatLevel = std::max(0, std::min(4, object.Get("threatLevel").As<Napi::Number>().Int32Value()));
+        }
+        if (rule.required.empty() && rule.any.empty()) continue;
+        rules.push_back(std::move(rule));
+    }
+    if (rules.empty()) {
+        rules = SignatureScanner::DefaultRules();
+    }
+    return rules;
+}
+
+// [{ suffix, category: "ai_tool" | "screen_sharing" | "remote_access" | "vpn_tool", label }];
+// entries with an unknown category are skipped, and an empty list means the defaults
+static std::vector<DomainRule> ParseDomainRules(const Napi::Array& array) {
+    std::vector<DomainRule> rules;
+    for (uint32_t i = 0; i < array.Length(); i++) {
+        if (!array.Get(i).IsObject()) continue;
+        Napi::Object object = array.Get(i).As<Napi::Object>();
+        if (!object.Has("suffix") || !object.Get("suffix").IsString() ||
+            !object.Has("category") || !object.Get("category").IsString()) {
+            continue;
+        }
+
+        DomainRule rule;
+        rule.suffix = object.Get("suffix").As<Napi::String>().Utf8Value();
+        rule.category = ProcessWatcher::EndpointCategoryFromName(object.Get("category").As<Napi::String>().Utf8Value());
+        rule.label = (object.Has("label") && object.Get("label").IsString())
+                         ? object.Get("label").As<Napi::String>().Utf8Value()
+                         : rule.suffix;
+        if (rule.category < 0 || rule.suffix.empty()) continue;
+        rules.push_back(std::move(rule));
+    }
+    return rules;
+}
+
+// Options shared by startProcessWatcher and startProcessMonitor; returns the
+// loop interval
+static int ApplyProcessWatcherOptions(Napi::Object options) {
+    int intervalMs = 1500;
+    if (options.Has("intervalMs") && options.Get("intervalMs").IsNumber()) {
+        intervalMs = options.Get("intervalMs").As<Napi::Number>().Int32Value();
+    }
+    
+    if (options.Has("blacklist") && options.Get("blacklist").IsArray()) {
+        Napi::Array blacklistArray = options.Get("blacklist").As<Napi::Array>();
+        std::vector<std::string> blacklist;
+        
+        for (uint32_t i = 0; i < blacklistArray.Length(); i++) {
+            if (blacklistArray.Get(i).IsString()) {
+                blacklist.push_back(blacklistArray.Get(i).As<Napi::String>().Utf8Value());
+            }
+        }
+        
+        process_watcher_instance->SetBlacklist(blacklist);
+    }
+
+    if (options.Has("knownBadExecutables") && options.Get("knownBadExecutables").IsArray()) {
+        process_watcher_instance->SetKnownBadExecutables(
+            ParseKnownBadExecutables(options.Get("knownBadExecutables").As<Napi::Array>()));
+    }
+
+    if (options.Has("signatureRules") && options.Get("signatureRules").IsArray()) {
+        process_watcher_instance->SetSignatureRules(
+            ParseSignatureRules(options.Get("signatureRules").As<Napi::Array>()));
+    }
+
+    if (options.Has("endpointRangesFile") && options.Get("endpointRangesFile").IsString()) {
+        size_t ranges = 0, rejected = 0;
+        process_watcher_instance->LoadEndpointRanges(
+            options.Get("endpointRangesFile").As<Napi::String>().Utf8Value(), ranges, rejected);
+    }
+
+    if (options.Has("domainRules") && options.Get("domainRules").IsArray()) {
+        process_watcher_instance->SetDomainRules(ParseDomainRules(options.Get("domainRules").As<Napi::Array>()));
+    }
+
+    // Best effort: without CAP_NET_RAW the watcher runs without it
+    if (options.Has("domainObserver") && options.Get("domainObserver").IsBoolean() &&
+        options.Get("domainObserver").As<Napi::Boolean>().Value()) {
+        process_watcher_instance->StartDomainObserver();
+    }
+    return intervalMs;
+}
+
 // JavaScript interface functions
 Napi::Value StartProcessWatcher(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
@@ -51,34 +212,42 @@ Napi::Value StartProcessWatcher(const Napi::CallbackInfo& info) {
     // Parse options if provided
     int intervalMs = 1500;
     if (info.Length() >= 2 && info[1].IsObject()) {
-        Napi::Object options = info[1].As<Napi::Object>();
-        
-        if (options.Has("intervalMs")) {
-            intervalMs = options.Get("intervalMs").As<Napi::Number>().Int32Value();
-        }
-        
-        if (options.Has("blacklist") && options.Get("blacklist").IsArray()) {
-            Napi::Array blacklistArray = options.Get("blacklist").As<Napi::Array>();
-            std::vector<std::string> blacklist;
-            
-            for (uint32_t i = 0; i < blacklistArray.Length(); i++) {
-                if (blacklistArray.Get(i).IsString()) {
-                    blacklist.push_back(blacklistArray.Get(i).As<Napi::String>().Utf8Value());
-                }
-            }
-            
-            process_watcher_instance->SetBlacklist(blacklist);
-        }
+        intervalMs = ApplyProcessWatcherOptions(info[1].As<Napi::Object>());
     }
     
     process_watcher_instance->Start(info[0].As<Napi::Function>(), intervalMs);
     return Napi::Boolean::New(env, true);
 }
 
+// Callback-free variant for pollers: the watcher loop publishes reports in
+// the background (reacting to exec/exit events where available) and the
+// report, delta and suspicious-process getters return the latest one.
+// Stopped by stopProcessWatcher.
+Napi::Value StartProcessMonitor(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (process_watcher_instance && process_watcher_instance->IsRunning()) {
+        return Napi::Boolean::New(env, false); // Already running
+    }
+
+    if (!process_watcher_instance) {
+        process_watcher_instance = new ProcessWatcher();
+    }
+
+    int intervalMs = 1500;
+    if (info.Length() >= 1 && info[0].IsObject()) {
+        intervalMs = ApplyProcessWatcherOptions(info[0].As<Napi::Object>());
+    }
+
+    process_watcher_instance->StartMonitor(intervalMs);
+    return Napi::Boolean::New(env, true);
+}
+
 Napi::Value StopProcessWatcher(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     
     if (process_watcher_instance) {
+        std::lock_guard<std::mutex> scanLock(process_watcher_scan_mutex);
         process_watcher_instance->Stop();
         delete process_watcher_instance;
         process_watcher_instance = nullptr;
@@ -88,6 +257,475 @@ Napi::Value StopProcessWatcher(const Napi::CallbackInfo& info) {
 }
 
 
+// Result marshalling shared by the synchronous getters and their *Async
+// (Promise) variants. Only these run on the JS thread.
+static Napi::Array ProcessSnapshotToArray(Napi::Env env, const std::vector<ProcessInfo>& processes) {
+    Napi::Array result = Napi::Array::New(env, processes.size());
+
+    for (size_t i = 0; i < processes.size(); i++) {
+        Napi::Object processObj = Napi::Object::New(env);
+
+        // Basic process info
+        processObj.Set("pid", Napi::Number::New(env, processes[i].pid));
+        processObj.Set("name", Napi::String::New(env, processes[i].name));
+        processObj.Set("path", Napi::String::New(env, processes[i].path));
+
+        // Classification info
+        processObj.Set("threatLevel", Napi::Number::New(env, processes[i].threatLevel));
+        processObj.Set("category", Napi::Number::New(env, processes[i].category));
+        processObj.Set("confidence", Napi::Number::New(env, processes[i].confidence));
+        processObj.Set("riskReason", Napi::String::New(env, processes[i].riskReason));
+        processObj.Set("flagged", Napi::Boolean::New(env, processes[i].flagged));
+        processObj.Set("suspicious", Napi::Boolean::New(env, processes[i].suspicious));
+        processObj.Set("blacklisted", Napi::Boolean::New(env, processes[i].blacklisted));
+
+        // Evidence array
+        Napi::Array evidenceArray = Napi::Array::New(env, processes[i].evidence.size());
+        for (size_t j = 0; j < processes[i].evidence.size(); j++) {
+            evidenceArray[j] = Napi::String::New(env, processes[i].evidence[j]);
+        }
+        processObj.Set("evidence", evidenceArray);
+
+        // Loaded modules
+        Napi::Array modulesArray = Napi::Array::New(env, processes[i].loadedModules.size());
+        for (size_t j = 0; j < processes[i].loadedModules.size(); j++) {
+            modulesArray[j] = Napi::String::New(env, processes[i].loadedModules[j]);
+        }
+        processObj.Set("loadedModules", modulesArray);
+
+        result[i] = processObj;
+    }
+
+    return result;
+}
+
+static Napi::Array SuspiciousProcessesToArray(Napi::Env env, const std::vector<ProcessInfo>& suspiciousProcesses) {
+    Napi::Array result = Napi::Array::New(env, suspiciousProcesses.size());
+
+    for (size_t i = 0; i < suspiciousProcesses.size(); i++) {
+        Napi::Object processObj = Napi::Object::New(env);
+
+        processObj.Set("pid", Napi::Number::New(env, suspiciousProcesses[i].pid));
+        processObj.Set("name", Napi::String::New(env, suspiciousProcesses[i].name));
+        processObj.Set("path", Napi::String::New(env, suspiciousProcesses[i].path));
+        processObj.Set("threatLevel", Napi::Number::New(env, suspiciousProcesses[i].threatLevel));
+        processObj.Set("category", Napi::Number::New(env, suspiciousProcesses[i].category));
+        processObj.Set("confidence", Napi::Number::New(env, suspiciousProcesses[i].confidence));
+        processObj.Set("riskReason", Napi::String::New(env, suspiciousProcesses[i].riskReason));
+
+        Napi::Array evidenceArray = Napi::Array::New(env, suspiciousProcesses[i].evidence.size());
+        for (size_t j = 0; j < suspiciousProcesses[i].evidence.size(); j++) {
+            evidenceArray[j] = Napi::String::New(env, suspiciousProcesses[i].evidence[j]);
+        }
+        processObj.Set("evidence", evidenceArray);
+
+        result[i] = processObj;
+    }
+
+    return result;
+}
+
+struct ProcessReportOptions {
+    bool includeModules = true;
+    bool includeEvidence = true;
+    bool includeRiskReason = true;
+};
+
+static ProcessReportOptions ParseProcessReportOptions(const Napi::CallbackInfo& info) {
+    ProcessReportOptions reportOptions;
+    if (info.Length() >= 1 && info[0].IsObject()) {
+        Napi::Object options = info[0].As<Napi::Object>();
+
+        if (options.Has("includeModules") && options.Get("includeModules").IsBoolean()) {
+            reportOptions.includeModules = options.Get("includeModules").As<Napi::Boolean>().Value();
+        }
+        if (options.Has("includeEvidence") && options.Get("includeEvidence").IsBoolean()) {
+            reportOptions.includeEvidence = options.Get("includeEvidence").As<Napi::Boolean>().Value();
+        }
+        if (options.Has("includeRiskReason") && options.Get("includeRiskReason").IsBoolean()) {
+            reportOptions.includeRiskReason = options.Get("includeRiskReason").As<Napi::Boolean>().Value();
+        }
+    }
+    return reportOptions;
+}
+
+static Napi::Object ProcessReportEntryToObject(Napi::Env env, const ProcessInfo& process, const ProcessReportOptions& reportOptions) {
+    Napi::Object processObj = Napi::Object::New(env);
+
+    processObj.Set("pid", Napi::Number::New(env, process.pid));
+    processObj.Set("name", Napi::String::New(env, process.name));
+    processObj.Set("path", Napi::String::New(env, process.path));
+    processObj.Set("parentPid", Napi::Number::New(env, process.parentPid));
+    processObj.Set("sessionId", Napi::Number::New(env, process.sessionId));
+    processObj.Set("uid", Napi::Number::New(env, process.uid));
+    processObj.Set("capabilities", Napi::Number::New(env, process.capabilities));
+    processObj.Set("threatLevel", Napi::Number::New(env, process.threatLevel));
+    processObj.Set("category", Napi::Number::New(env, process.category));
+    processObj.Set("confidence", Napi::Number::New(env, process.confidence));
+    processObj.Set("flagged", Napi::Boolean::New(env, process.flagged));
+    processObj.Set("suspicious", Napi::Boolean::New(env, process.suspicious));
+    processObj.Set("blacklisted", Napi::Boolean::New(env, process.blacklisted));
+
+    if (reportOptions.includeRiskReason) {
+        processObj.Set("riskReason", Napi::String::New(env, process.riskReason));
+    }
+
+    if (reportOptions.includeEvidence) {
+        Napi::Array evidenceArray = Napi::Array::New(env, process.evidence.size());
+        for (size_t j = 0; j < process.evidence.size(); j++) {
+            evidenceArray[j] = Napi::String::New(env, process.evidence[j]);
+        }
+        processObj.Set("evidence", evidenceArray);
+    }
+
+    if (reportOptions.includeModules) {
+        Napi::Array modulesArray = Napi::Array::New(env, process.loadedModules.size());
+        for (size_t j = 0; j < process.loadedModules.size(); j++) {
+            modulesArray[j] = Napi::String::New(env, process.loadedModules[j]);
+        }
+        processObj.Set("loadedModules", modulesArray);
+    }
+
+    return processObj;
+}
+
+// generation is the published report's, the same one getProcessDelta takes
+static Napi::Object ProcessReportToObject(Napi::Env env, const PublishedSnapshot<ProcessReport>& published, const ProcessReportOptions& reportOptions) {
+    const ProcessReport& report = published.value;
+    Napi::Array processes = Napi::Array::New(env, report.processes.size());
+    for (size_t i = 0; i < report.processes.size(); i++) {
+        processes[i] = ProcessReportEntryToObject(env, report.processes[i], reportOptions);
+    }
+
+    Napi::Array suspiciousIndices = Napi::Array::New(env, report.suspiciousIndices.size());
+    for (size_t i = 0; i < report.suspiciousIndices.size(); i++) {
+        suspiciousIndices[i] = Napi::Number::New(env, static_cast<double>(report.suspiciousIndices[i]));
+    }
+
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("generation", Napi::Number::New(env, static_cast<double>(published.generation)));
+    result.Set("processes", processes);
+    result.Set("suspiciousIndices", suspiciousIndices);
+    return result;
+}
+
+static uint64_t ParseSinceGeneration(const Napi::CallbackInfo& info) {
+    if (info.Length() >= 1 && info[0].IsObject()) {
+        Napi::Object options = info[0].As<Napi::Object>();
+        if (options.Has("sinceGeneration") && options.Get("sinceGeneration").IsNumber()) {
+            double since = options.Get("sinceGeneration").As<Napi::Number>().DoubleValue();
+            return since > 0 ? static_cast<uint64_t>(since) : 0;
+        }
+    }
+    return 0;
+}
+
+struct ProcessLineageQuery {
+    int pid = 0;
+    bool ancestry = false;
+};
+
+// { pid, direction: 'subtree' | 'ancestry' } alongside the report options
+static bool ParseProcessLineageQuery(const Napi::CallbackInfo& info, ProcessLineageQuery& query) {
+    if (info.Length() < 1 || !info[0].IsObject()) {
+        return false;
+    }
+
+    Napi::Object options = info[0].As<Napi::Object>();
+    if (!options.Has("pid") || !options.Get("pid").IsNumber()) {
+        return false;
+    }
+    query.pid = options.Get("pid").As<Napi::Number>().Int32Value();
+
+    if (options.Has("direction") && options.Get("direction").IsString()) {
+        query.ancestry = options.Get("direction").As<Napi::String>().Utf8Value() == "ancestry";
+    }
+    return true;
+}
+
+static Napi::Array ProcessLineageToArray(Napi::Env env, const std::vector<ProcessLineageNode>& nodes,
+                                         const ProcessReportOptions& reportOptions) {
+    Napi::Array result = Napi::Array::New(env, nodes.size());
+    for (size_t i = 0; i < nodes.size(); i++) {
+        Napi::Object entry = ProcessReportEntryToObject(env, nodes[i].process, reportOptions);
+        entry.Set("depth", Napi::Number::New(env, nodes[i].depth));
+        result[i] = entry;
+    }
+    return result;
+}
+
+static Napi::Array NetworkPatternsToArray(Napi::Env env, const std::vector<NetworkPattern>& patterns) {
+    Napi::Array result = Napi::Array::New(env, patterns.size());
+    for (size_t i = 0; i < patterns.size(); i++) {
+        const NetworkPattern& pattern = patterns[i];
+        Napi::Object entry = Napi::Object::New(env);
+        entry.Set("pid", Napi::Number::New(env, pattern.pid));
+        entry.Set("processName", Napi::String::New(env, pattern.processName));
+
+        Napi::Array remotes = Napi::Array::New(env, pattern.remoteAddresses.size());
+        for (size_t j = 0; j < pattern.remoteAddresses.size(); j++) {
+            remotes[j] = Napi::String::New(env, pattern.remoteAddresses[j]);
+        }
+        entry.Set("remoteAddresses", remotes);
+
+        Napi::Array sockets = Napi::Array::New(env, pattern.sockets.size());
+        for (size_t j = 0; j < pattern.sockets.size(); j++) {
+            const SocketEntry& socket = pattern.sockets[j];
+            Napi::Object socketObj = Napi::Object::New(env);
+            socketObj.Set("protocol", Napi::String::New(env, socket.protocol == SocketEntry::Protocol::Tcp ? "tcp" : "udp"));
+            socketObj.Set("localAddress", Napi::String::New(env, socket.localAddress));
+            socketObj.Set("localPort", Napi::Number::New(env, socket.localPort));
+            if (socket.IsConnected()) {
+                socketObj.Set("remoteAddress", Napi::String::New(env, socket.remoteAddress));
+                socketObj.Set("remotePort", Napi::Number::New(env, socket.remotePort));
+            }
+            socketObj.Set("state", Napi::Number::New(env, socket.state));
+            socketObj.Set("bytesSent", Napi::Number::New(env, static_cast<double>(socket.bytesSent)));
+            socketObj.Set("bytesReceived", Napi::Number::New(env, static_cast<double>(socket.bytesReceived)));
+            sockets[j] = socketObj;
+        }
+        entry.Set("sockets", sockets);
+
+        entry.Set("bytesTransferred", Napi::Number::New(env, static_cast<double>(pattern.bytesTransferred)));
+        entry.Set("uploadBitsPerSecond", Napi::Number::New(env, pattern.uploadBitsPerSecond));
+        entry.Set("downloadBitsPerSecond", Napi::Number::New(env, pattern.downloadBitsPerSecond));
+        entry.Set("sustainedUploadBitsPerSecond", Napi::Number::New(env, pattern.sustainedUploadBitsPerSecond));
+        entry.Set("burstiness", Napi::Number::New(env, pattern.burstiness));
+        entry.Set("isVideoStream", Napi::Boolean::New(env, pattern.isVideoStream));
+        entry.Set("isWebRTC", Napi::Boolean::New(env, pattern.isWebRTC));
+        entry.Set("isVPN", Napi::Boolean::New(env, pattern.isVPN));
+
+        Napi::Array endpointMatches = Napi::Array::New(env, pattern.endpointMatches.size());
+        for (size_t j = 0; j < pattern.endpointMatches.size(); j++) {
+            const NetworkEndpointMatch& match = pattern.endpointMatches[j];
+            Napi::Object matchObj = Napi::Object::New(env);
+            matchObj.Set("source", Napi::String::New(env, match.source));
+            matchObj.Set("remoteAddress", Napi::String::New(env, match.remoteAddress));
+            matchObj.Set("category", Napi::Number::New(env, static_cast<int>(match.category)));
+            matchObj.Set("label", Napi::String::New(env, match.label));
+            if (!match.cidr.empty()) {
+                matchObj.Set("cidr", Napi::String::New(env, match.cidr));
+            }
+            if (!match.domain.empty()) {
+                matchObj.Set("domain", Napi::String::New(env, match.domain));
+            }
+            endpointMatches[j] = matchObj;
+        }
+        entry.Set("endpointMatches", endpointMatches);
+        result[i] = entry;
+    }
+    return result;
+}
+
+static Napi::Object ProcessDeltaToObject(Napi::Env env, const ProcessDelta& delta, const ProcessReportOptions& reportOptions) {
+    Napi::Array added = Napi::Array::New(env, delta.added.size());
+    for (size_t i = 0; i < delta.added.size(); i++) {
+        added[i] = ProcessReportEntryToObject(env, delta.added[i], reportOptions);
+    }
+
+    Napi::Array removed = Napi::Array::New(env, delta.removed.size());
+    for (size_t i = 0; i < delta.removed.size(); i++) {
+        Napi::Object removedObj = Napi::Object::New(env);
+        removedObj.Set("pid", Napi::Number::New(env, delta.removed[i].pid));
+        removedObj.Set("category", Napi::Number::New(env, delta.removed[i].category));
+        removedObj.Set("threatLevel", Napi::Number::New(env, delta.removed[i].threatLevel));
+        removed[i] = removedObj;
+    }
+
+    // Threats that went away, so pollers can raise threat-cleared without
+    // diffing removed and reclassified themselves
+    Napi::Array cleared = Napi::Array::New(env, delta.cleared.size());
+    for (size_t i = 0; i < delta.cleared.size(); i++) {
+        Napi::Object clearedObj = Napi::Object::New(env);
+        clearedObj.Set("pid", Napi::Number::New(env, delta.cleared[i].previous.pid));
+        clearedObj.Set("category", Napi::Number::New(env, delta.cleared[i].previous.category));
+        clearedObj.Set("threatLevel", Napi::Number::New(env, delta.cleared[i].previous.threatLevel));
+        clearedObj.Set("reason", Napi::String::New(env, delta.cleared[i].exited ? "exited" : "reclassified"));
+        cleared[i] = clearedObj;
+    }
+
+    Napi::Array reclassified = Napi::Array::New(env, delta.reclassified.size());
+    for (size_t i = 0; i < delta.reclassified.size(); i++) {
+        Napi::Object processObj = ProcessReportEntryToObject(env, delta.reclassified[i].process, reportOptions);
+        processObj.Set("previousCategory", Napi::Number::New(env, delta.reclassified[i].previousCategory));
+        processObj.Set("previousThreatLevel", Napi::Number::New(env, delta.reclassified[i].previousThreatLevel));
+        processObj.Set("previousBlacklisted", Napi::Boolean::New(env, delta.reclassified[i].previousBlacklisted));
+        reclassified[i] = processObj;
+    }
+
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("fromGeneration", Napi::Number::New(env, static_cast<double>(delta.fromGeneration)));
+    result.Set("generation", Napi::Number::New(env, static_cast<double>(delta.toGeneration)));
+    result.Set("fullResync", Napi::Boolean::New(env, delta.fullResync));
+    result.Set("added", added);
+    result.Set("removed", removed);
+    result.Set("reclassified", reclassified);
+    result.Set("cleared", cleared);
+    return result;
+}
+
+static Napi::Array ScreenSharingSessionsToArray(Napi::Env env, const std::vector<ScreenSharingSession>& sessions) {
+    Napi::Array result = Napi::Array::New(env, sessions.size());
+
+    for (size_t i = 0; i < sessions.size(); i++) {
+        Napi::Object sessionObj = Napi::Object::New(env);
+        sessionObj.Set("method", Napi::Number::New(env, static_cast<int>(sessions[i].method)));
+        sessionObj.Set("processName", Napi::String::New(env, sessions[i].processName));
+        sessionObj.Set("pid", Napi::Number::New(env, sessions[i].pid));
+        sessionObj.Set("targetUrl", Napi::String::New(env, sessions[i].targetUrl));
+        sessionObj.Set("description", Napi::String::New(env, sessions[i].description));
+        sessionObj.Set("confidence", Napi::Number::New(env, sessions[i].confidence));
+        sessionObj.Set("isActive", Napi::Boolean::New(env, sessions[i].isActive));
+
+        result[i] = sessionObj;
+    }
+
+    return result;
+}
+
+static Napi::Object VMDetectionResultToObject(Napi::Env env, const VMDetectionResult& result) {
+    Napi::Object jsResult = Napi::Object::New(env);
+    jsResult.Set("isInsideVM", Napi::Boolean::New(env, result.isInsideVM));
+    jsResult.Set("detectedVM", Napi::String::New(env, result.detectedVM));
+    jsResult.Set("detectionMethod", Napi::String::New(env, result.detectionMethod));
+
+    // Running VM processes
+    Napi::Array processArray = Napi::Array::New(env);
+    for (size_t i = 0; i < result.runningVMProcesses.size(); i++) {
+        processArray[i] = Napi::String::New(env, result.runningVMProcesses[i]);
+    }
+    jsResult.Set("runningVMProcesses", processArray);
+
+    // VM indicators
+    Napi::Array indicatorArray = Napi::Array::New(env);
+    for (size_t i = 0; i < result.vmIndicators.size(); i++) {
+        indicatorArray[i] = Napi::String::New(env, result.vmIndicators[i]);
+    }
+    jsResult.Set("vmIndicators", indicatorArray);
+
+    return jsResult;
+}
+
+static Napi::Array InputDevicesToArray(Napi::Env env, const std::vector<InputDeviceInfo>& devices) {
+    Napi::Array result = Napi::Array::New(env, devices.size());
+
+    for (size_t i = 0; i < devices.size(); i++) {
+        Napi::Object deviceObj = Napi::Object::New(env);
+        deviceObj.Set("name", Napi::String::New(env, devices[i].name));
+        deviceObj.Set("type", Napi::String::New(env, devices[i].type));
+        deviceObj.Set("deviceId", Napi::String::New(env, devices[i].deviceId));
+        deviceObj.Set("manufacturer", Napi::String::New(env, devices[i].manufacturer));
+        deviceObj.Set("vendorId", Napi::String::New(env, devices[i].vendorId));
+        deviceObj.Set("productId", Napi::String::New(env, devices[i].productId));
+        deviceObj.Set("isExternal", Napi::Boolean::New(env, devices[i].isExternal));
+        deviceObj.Set("isVirtual", Napi::Boolean::New(env, devices[i].isVirtual));
+        deviceObj.Set("isSpoofed", Napi::Boolean::New(env, devices[i].isSpoofed));
+        deviceObj.Set("isBluetooth", Napi::Boolean::New(env, devices[i].isBluetooth));
+        deviceObj.Set("isWireless", Napi::Boolean::New(env, devices[i].isWireless));
+        deviceObj.Set("threatLevel", Napi::Number::New(env, devices[i].threatLevel));
+        deviceObj.Set("threatReason", Napi::String::New(env, devices[i].threatReason));
+        deviceObj.Set("isAllowed", Napi::Boolean::New(env, devices[i].isAllowed));
+
+        result[i] = deviceObj;
+    }
+
+    return result;
+}
+
+static Napi::Array VideoDevicesToArray(Napi::Env env, const std::vector<InputDeviceInfo>& devices) {
+    Napi::Array result = Napi::Array::New(env, devices.size());
+
+    for (size_t i = 0; i < devices.size(); i++) {
+        Napi::Object deviceObj = Napi::Object::New(env);
+        deviceObj.Set("name", Napi::String::New(env, devices[i].name));
+        deviceObj.Set("type", Napi::String::New(env, devices[i].type));
+        deviceObj.Set("deviceId", Napi::String::New(env, devices[i].deviceId));
+        deviceObj.Set("manufacturer", Napi::String::New(env, devices[i].manufacturer));
+        deviceObj.Set("vendorId", Napi::String::New(env, devices[i].vendorId));
+        deviceObj.Set("productId", Napi::String::New(env, devices[i].productId));
+        deviceObj.Set("isExternal", Napi::Boolean::New(env, devices[i].isExternal));
+        deviceObj.Set("isVirtual", Napi::Boolean::New(env, devices[i].isVirtual));
+        deviceObj.Set("isSpoofed", Napi::Boolean::New(env, devices[i].isSpoofed));
+        deviceObj.Set("threatLevel", Napi::Number::New(env, devices[i].threatLevel));
+        deviceObj.Set("threatReason", Napi::String::New(env, devices[i].threatReason));
+        deviceObj.Set("isAllowed", Napi::Boolean::New(env, devices[i].isAllowed));
+
+        result[i] = deviceObj;
+    }
+
+    return result;
+}
+
+static Napi::Array StorageDevicesToArray(Napi::Env env, const std::vector<StorageDeviceInfo>& devices) {
+    Napi::Array result = Napi::Array::New(env, devices.size());
+
+    for (size_t i = 0; i < devices.size(); i++) {
+        Napi::Object deviceObj = Napi::Object::New(env);
+        deviceObj.Set("id", Napi::String::New(env, devices[i].id));
+        deviceObj.Set("type", Napi::String::New(env, devices[i].type));
+        deviceObj.Set("name", Napi::String::New(env, devices[i].name));
+        deviceObj.Set("path", Napi::String::New(env, devices[i].path));
+        deviceObj.Set("isExternal", Napi::Boolean::New(env, devices[i].isExternal));
+
+        result[i] = deviceObj;
+    }
+
+    return result;
+}
+
+// Runs a scan on the libuv thread pool and settles a Promise with the marshalled
+// result on the JS thread. Detector instances must be created before queueing.
+template <typename Result>
+class ScanPromiseWorker : public Napi::AsyncWorker {
+public:
+    using ScanFn = std::function<Result()>;
+    using MarshalFn = std::function<Napi::Value(Napi::Env, const Result&)>;
+
+    ScanPromiseWorker(Napi::Env env, ScanFn scan, MarshalFn marshal, const std::string& errorPrefix)
+        : Napi::AsyncWorker(env),
+          deferred_(Napi::Promise::Deferred::New(env)),
+          scan_(std::move(scan)),
+          marshal_(std::move(marshal)),
+          errorPrefix_(errorPrefix) {}
+
+    Napi::Promise GetPromise() const { return deferred_.Promise(); }
+
+    void Execute() override {
+        try {
+            result_ = scan_();
+        } catch (const std::exception& e) {
+            SetError(errorPrefix_ + e.what());
+        } catch (...) {
+            SetError(errorPrefix_ + "unknown error");
+        }
+    }
+
+    void OnOK() override {
+        deferred_.Resolve(marshal_(Env(), result_));
+    }
+
+    void OnError(const Napi::Error& error) override {
+        deferred_.Reject(error.Value());
+    }
+
+private:
+    Napi::Promise::Deferred deferred_;
+    ScanFn scan_;
+    MarshalFn marshal_;
+    std::string errorPrefix_;
+    Result result_;
+};
+
+template <typename Result>
+static Napi::Value QueueScan(Napi::Env env, typename ScanPromiseWorker<Result>::ScanFn scan,
+                             typename ScanPromiseWorker<Result>::MarshalFn marshal,
+                             const std::string& errorPrefix) {
+    auto* worker = new ScanPromiseWorker<Result>(env, std::move(scan), std::move(marshal), errorPrefix);
+    Napi::Promise promise = worker->GetPromise();
+    worker->Queue();
+    return promise;
+}
+
 // 2025 ProcessWatcher functions
 Napi::Value GetProcessSnapshot(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
@@ -97,84 +735,511 @@ Napi::Value GetProcessSnapshot(const Napi::CallbackInfo& info) {
     }
 
     try {
-        std::vector<ProcessInfo> processes = process_watcher_instance->GetProcessSnapshot();
-
-        Napi::Array result = Napi::Array::New(env, processes.size());
-
-        for (size_t i = 0; i < processes.size(); i++) {
-            Napi::Object processObj = Napi::Object::New(env);
-
-            // Basic process info
-            processObj.Set("pid", Napi::Number::New(env, processes[i].pid));
-            processObj.Set("name", Napi::String::New(env, processes[i].name));
-            processObj.Set("path", Napi::String::New(env, processes[i].path));
-
-            // Classification info
-            processObj.Set("threatLevel", Napi::Number::New(env, processes[i].threatLevel));
-            processObj.Set("category", Napi::Number::New(env, processes[i].category));
-            processObj.Set("confidence", Napi::Number::New(env, processes[i].confidence));
-            processObj.Set("riskReason", Napi::String::New(env, processes[i].riskReason));
-            processObj.Set("flagged", Napi::Boolean::New(env, processes[i].flagged));
-            processObj.Set("suspicious", Napi::Boolean::New(env, processes[i].suspicious));
-            processObj.Set("blacklisted", Napi::Boolean::New(env, processes[i].blacklisted));
-
-            // Evidence array
-            Napi::Array evidenceArray = Napi::Array::New(env, processes[i].evidence.size());
-            for (size_t j = 0; j < processes[i].evidence.size(); j++) {
-                evidenceArray[j] = Napi::String::New(env, processes[i].evidence[j]);
-            }
-            processObj.Set("evidence", evidenceArray);
+        std::vector<ProcessInfo> processes;
+        {
+            std::lock_guard<std::mutex> lock(process_watcher_scan_mutex);
+            processes = process_watcher_instance->GetProcessSnapshot();
+        }
+        return ProcessSnapshotToArray(env, processes);
+    } catch (const std::exception& e) {
+        Napi::Error::New(env, std::string("Error getting enhanced process snapshot: ") + e.what()).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
 
-            // Loaded modules
-            Napi::Array modulesArray = Napi::Array::New(env, processes[i].loadedModules.size());
-            for (size_t j = 0; j < processes[i].loadedModules.size(); j++) {
-                modulesArray[j] = Napi::String::New(env, processes[i].loadedModules[j]);
-            }
-            processObj.Set("loadedModules", modulesArray);
+Napi::Value DetectSuspiciousBehavior(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (!process_watcher_instance) {
+        process_watcher_instance = new ProcessWatcher();
+    }
 
-            result[i] = processObj;
+    try {
+        std::vector<ProcessInfo> suspiciousProcesses;
+        {
+            std::lock_guard<std::mutex> lock(process_watcher_scan_mutex);
+            suspiciousProcesses = process_watcher_instance->DetectSuspiciousBehavior();
         }
+        return SuspiciousProcessesToArray(env, suspiciousProcesses);
+    } catch (const std::exception& e) {
+        Napi::Error::New(env, std::string("Error detecting suspicious behavior: ") + e.what()).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
 
-        return result;
+// One enumeration + classification pass returning the full snapshot and the
+// indices of suspicious entries. Options: { includeModules, includeEvidence,
+// includeRiskReason } (all default true) to skip materializing unused fields.
+Napi::Value GetProcessReport(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (!process_watcher_instance) {
+        process_watcher_instance = new ProcessWatcher();
+    }
+
+    ProcessReportOptions reportOptions = ParseProcessReportOptions(info);
+
+    try {
+        std::shared_ptr<const PublishedSnapshot<ProcessReport>> published;
+        {
+            std::lock_guard<std::mutex> lock(process_watcher_scan_mutex);
+            published = process_watcher_instance->AcquireReport();
+        }
+        return ProcessReportToObject(env, *published, reportOptions);
     } catch (const std::exception& e) {
-        Napi::Error::New(env, std::string("Error getting enhanced process snapshot: ") + e.what()).ThrowAsJavaScriptException();
+        Napi::Error::New(env, std::string("Error getting process report: ") + e.what()).ThrowAsJavaScriptException();
         return env.Null();
     }
 }
 
-Napi::Value DetectSuspiciousBehavior(const Napi::CallbackInfo& info) {
+
+// Typed changes since a generation returned by an earlier call. Options are those
+// of getProcessReport plus { sinceGeneration }; a missing, zero or expired
+// generation (and periodically every caller) gets a full resync in `added`.
+Napi::Value GetProcessDelta(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
 
     if (!process_watcher_instance) {
         process_watcher_instance = new ProcessWatcher();
     }
 
+    ProcessReportOptions reportOptions = ParseProcessReportOptions(info);
+    uint64_t sinceGeneration = ParseSinceGeneration(info);
+
     try {
-        std::vector<ProcessInfo> suspiciousProcesses = process_watcher_instance->DetectSuspiciousBehavior();
+        ProcessDelta delta;
+        {
+            std::lock_guard<std::mutex> lock(process_watcher_scan_mutex);
+            delta = process_watcher_instance->GetProcessDelta(sinceGeneration);
+        }
+        return ProcessDeltaToObject(env, delta, reportOptions);
+    } catch (const std::exception& e) {
+        Napi::Error::New(env, std::string("Error getting process delta: ") + e.what()).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
 
-        Napi::Array result = Napi::Array::New(env, suspiciousProcesses.size());
+// Promise variants: the scan runs on the libuv thread pool, only marshalling
+// happens on the JS thread
+Napi::Value GetProcessSnapshotAsync(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (!process_watcher_instance) {
+        process_watcher_instance = new ProcessWatcher();
+    }
+
+    return QueueScan<std::vector<ProcessInfo>>(env,
+        []() {
+            std::lock_guard<std::mutex> lock(process_watcher_scan_mutex);
+            if (!process_watcher_instance) throw std::runtime_error("process watcher stopped");
+            return process_watcher_instance->GetProcessSnapshot();
+        },
+        ProcessSnapshotToArray,
+        "Error getting enhanced process snapshot: ");
+}
 
-        for (size_t i = 0; i < suspiciousProcesses.size(); i++) {
-            Napi::Object processObj = Napi::Object::New(env);
+Napi::Value DetectSuspiciousBehaviorAsync(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
 
-            processObj.Set("pid", Napi::Number::New(env, suspiciousProcesses[i].pid));
-            processObj.Set("name", Napi::String::New(env, suspiciousProcesses[i].name));
-            processObj.Set("path", Napi::String::New(env, suspiciousProcesses[i].path));
-            processObj.Set("threatLevel", Napi::Number::New(env, suspiciousProcesses[i].threatLevel));
-            processObj.Set("category", Napi::Number::New(env, suspiciousProcesses[i].category));
-            processObj.Set("confidence", Napi::Number::New(env, suspiciousProcesses[i].confidence));
-            processObj.Set("riskReason", Napi::String::New(env, suspiciousProcesses[i].riskReason));
+    if (!process_watcher_instance) {
+        process_watcher_instance = new ProcessWatcher();
+    }
+
+    return QueueScan<std::vector<ProcessInfo>>(env,
+        []() {
+            std::lock_guard<std::mutex> lock(process_watcher_scan_mutex);
+            if (!process_watcher_instance) throw std::runtime_error("process watcher stopped");
+            return process_watcher_instance->DetectSuspiciousBehavior();
+        },
+        SuspiciousProcessesToArray,
+        "Error detecting suspicious behavior: ");
+}
+
+Napi::Value GetProcessReportAsync(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
 
-            result[i] = processObj;
+    if (!process_watcher_instance) {
+        process_watcher_instance = new ProcessWatcher();
+    }
+
+    ProcessReportOptions reportOptions = ParseProcessReportOptions(info);
+
+    using PublishedReport = std::shared_ptr<const PublishedSnapshot<ProcessReport>>;
+    return QueueScan<PublishedReport>(env,
+        []() {
+            std::lock_guard<std::mutex> lock(process_watcher_scan_mutex);
+            if (!process_watcher_instance) throw std::runtime_error("process watcher stopped");
+            return process_watcher_instance->AcquireReport();
+        },
+        [reportOptions](Napi::Env env, const PublishedReport& published) -> Napi::Value {
+            return ProcessReportToObject(env, *published, reportOptions);
+        },
+        "Error getting process report: ");
+}
+
+Napi::Value GetProcessDeltaAsync(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (!process_watcher_instance) {
+        process_watcher_instance = new ProcessWatcher();
+    }
+
+    ProcessReportOptions reportOptions = ParseProcessReportOptions(info);
+    uint64_t sinceGeneration = ParseSinceGeneration(info);
+
+    return QueueScan<ProcessDelta>(env,
+        [sinceGeneration]() {
+            std::lock_guard<std::mutex> lock(process_watcher_scan_mutex);
+            if (!process_watcher_instance) throw std::runtime_error("process watcher stopped");
+            return process_watcher_instance->GetProcessDelta(sinceGeneration);
+        },
+        [reportOptions](Napi::Env env, const ProcessDelta& delta) -> Napi::Value {
+            return ProcessDeltaToObject(env, delta, reportOptions);
+        },
+        "Error getting process delta: ");
+}
+
+Napi::Value GetProcessLineage(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    ProcessLineageQuery query;
+    if (!ParseProcessLineageQuery(info, query)) {
+        Napi::TypeError::New(env, "Options object with numeric pid expected").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    if (!process_watcher_instance) {
+        process_watcher_instance = new ProcessWatcher();
+    }
+
+    ProcessReportOptions reportOptions = ParseProcessReportOptions(info);
+
+    try {
+        std::vector<ProcessLineageNode> nodes;
+        {
+            std::lock_guard<std::mutex> lock(process_watcher_scan_mutex);
+            nodes = process_watcher_instance->GetProcessLineage(query.pid, query.ancestry);
         }
+        return ProcessLineageToArray(env, nodes, reportOptions);
+    } catch (const std::exception& e) {
+        Napi::Error::New(env, std::string("Error getting process lineage: ") + e.what()).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
 
-        return result;
+Napi::Value GetProcessLineageAsync(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    ProcessLineageQuery query;
+    if (!ParseProcessLineageQuery(info, query)) {
+        Napi::TypeError::New(env, "Options object with numeric pid expected").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    if (!process_watcher_instance) {
+        process_watcher_instance = new ProcessWatcher();
+    }
+
+    ProcessReportOptions reportOptions = ParseProcessReportOptions(info);
+
+    return QueueScan<std::vector<ProcessLineageNode>>(env,
+        [query]() {
+            std::lock_guard<std::mutex> lock(process_watcher_scan_mutex);
+            if (!process_watcher_instance) throw std::runtime_error("process watcher stopped");
+            return process_watcher_instance->GetProcessLineage(query.pid, query.ancestry);
+        },
+        [reportOptions](Napi::Env env, const std::vector<ProcessLineageNode>& nodes) -> Napi::Value {
+            return ProcessLineageToArray(env, nodes, reportOptions);
+        },
+        "Error getting process lineage: ");
+}
+
+// Per-process socket summary; Linux only, repeated calls within a second share one scan
+Napi::Value DetectNetworkPatterns(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (!process_watcher_instance) {
+        process_watcher_instance = new ProcessWatcher();
+    }
+
+    try {
+        std::vector<NetworkPattern> patterns;
+        {
+            std::lock_guard<std::mutex> lock(process_watcher_scan_mutex);
+            patterns = process_watcher_instance->DetectNetworkPatterns();
+        }
+        return NetworkPatternsToArray(env, patterns);
     } catch (const std::exception& e) {
-        Napi::Error::New(env, std::string("Error detecting suspicious behavior: ") + e.what()).ThrowAsJavaScriptException();
+        Napi::Error::New(env, std::string("Error detecting network patterns: ") + e.what()).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+Napi::Value DetectNetworkPatternsAsync(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (!process_watcher_instance) {
+        process_watcher_instance = new ProcessWatcher();
+    }
+
+    return QueueScan<std::vector<NetworkPattern>>(env,
+        []() {
+            std::lock_guard<std::mutex> lock(process_watcher_scan_mutex);
+            if (!process_watcher_instance) throw std::runtime_error("process watcher stopped");
+            return process_watcher_instance->DetectNetworkPatterns();
+        },
+        [](Napi::Env env, const std::vector<NetworkPattern>& patterns) -> Napi::Value {
+            return NetworkPatternsToArray(env, patterns);
+        },
+        "Error detecting network patterns: ");
+}
+
+Napi::Value SetKnownBadExecutables(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 1 || !info[0].IsArray()) {
+        Napi::TypeError::New(env, "Array expected").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    if (!process_watcher_instance) {
+        process_watcher_instance = new ProcessWatcher();
+    }
+
+    std::vector<KnownBadExecutable> entries = ParseKnownBadExecutables(info[0].As<Napi::Array>());
+    process_watcher_instance->SetKnownBadExecutables(entries);
+    return Napi::Number::New(env, static_cast<double>(entries.size()));
+}
+
+// Hash state of a process's executable; hashing itself advances with each
+// process report, so a new file reads as "pending" at first
+Napi::Value GetExecutableHash(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 1 || !info[0].IsNumber()) {
+        Napi::TypeError::New(env, "Process ID expected").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    if (!process_watcher_instance) {
+        process_watcher_instance = new ProcessWatcher();
+    }
+
+    ExecutableVerdict verdict = process_watcher_instance->GetExecutableVerdict(info[0].As<Napi::Number>().Int32Value());
+
+    static const char* const stateNames[] = {"unavailable", "pending", "clean", "known-bad"};
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("state", Napi::String::New(env, stateNames[static_cast<int>(verdict.state)]));
+    if (!verdict.sha256.empty()) {
+        result.Set("sha256", Napi::String::New(env, verdict.sha256));
+    }
+    if (verdict.preHashed) {
+        char preHash[17];
+        snprintf(preHash, sizeof(preHash), "%016llx", static_cast<unsigned long long>(verdict.preHash));
+        result.Set("preHash", Napi::String::New(env, preHash));
+    }
+    if (!verdict.label.empty()) {
+        result.Set("label", Napi::String::New(env, verdict.label));
+    }
+    return result;
+}
+
+Napi::Value SetSignatureRules(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() >= 1 && !info[0].IsArray()) {
+        Napi::TypeError::New(env, "Array expected").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    if (!process_watcher_instance) {
+        process_watcher_instance = new ProcessWatcher();
+    }
+
+    std::vector<SignatureRule> rules =
+        ParseSignatureRules(info.Length() >= 1 ? info[0].As<Napi::Array>() : Napi::Array::New(env));
+    process_watcher_instance->SetSignatureRules(rules);
+    return Napi::Number::New(env, static_cast<double>(rules.size()));
+}
+
+// Loads (and from then on watches) the endpoint range file; each line is
+// "<cidr> <ai_tool|screen_sharing|remote_access|vpn_tool> [label]"
+Napi::Value LoadEndpointRanges(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 1 || !info[0].IsString()) {
+        Napi::TypeError::New(env, "Path expected").ThrowAsJavaScriptException();
         return env.Null();
     }
+
+    if (!process_watcher_instance) {
+        process_watcher_instance = new ProcessWatcher();
+    }
+
+    std::string path = info[0].As<Napi::String>().Utf8Value();
+    size_t ranges = 0, rejected = 0;
+    if (!process_watcher_instance->LoadEndpointRanges(path, ranges, rejected)) {
+        Napi::Error::New(env, "Cannot read endpoint ranges: " + path).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("ranges", Napi::Number::New(env, static_cast<double>(ranges)));
+    result.Set("rejected", Napi::Number::New(env, static_cast<double>(rejected)));
+    return result;
 }
 
+// Starts the passive SNI/DNS observer; false without Linux and CAP_NET_RAW
+Napi::Value StartDomainObserver(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (!process_watcher_instance) {
+        process_watcher_instance = new ProcessWatcher();
+    }
+    return Napi::Boolean::New(env, process_watcher_instance->StartDomainObserver());
+}
+
+Napi::Value StopDomainObserver(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (process_watcher_instance) {
+        process_watcher_instance->StopDomainObserver();
+    }
+    return env.Undefined();
+}
+
+Napi::Value SetDomainRules(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() >= 1 && !info[0].IsArray()) {
+        Napi::TypeError::New(env, "Array expected").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    if (!process_watcher_instance) {
+        process_watcher_instance = new ProcessWatcher();
+    }
+
+    std::vector<DomainRule> rules =
+        ParseDomainRules(info.Length() >= 1 ? info[0].As<Napi::Array>() : Napi::Array::New(env));
+    process_watcher_instance->SetDomainRules(rules);
+    return Napi::Number::New(env, static_cast<double>(rules.empty() ? DomainObserver::DefaultRules().size() : rules.size()));
+}
+
+Napi::Value GetDomainObserverStats(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    DomainObserverStats stats;
+    if (process_watcher_instance) {
+        stats = process_watcher_instance->GetDomainObserverStats();
+    }
+
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("packets", Napi::Number::New(env, static_cast<double>(stats.packets)));
+    result.Set("names", Napi::Number::New(env, static_cast<double>(stats.names)));
+    result.Set("hits", Napi::Number::New(env, static_cast<double>(stats.hits)));
+    result.Set("dropped", Napi::Number::New(env, static_cast<double>(stats.dropped)));
+    return result;
+}
+
+// Signature matches for a process's executable and app.asar; scanning advances
+// with each process report, so a new file reads as "pending" at first
+Napi::Value GetSignatureMatches(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 1 || !info[0].IsNumber()) {
+        Napi::TypeError::New(env, "Process ID expected").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    if (!process_watcher_instance) {
+        process_watcher_instance = new ProcessWatcher();
+    }
+
+    SignatureVerdict verdict = process_watcher_instance->GetSignatureVerdict(info[0].As<Napi::Number>().Int32Value());
+
+    static const char* const stateNames[] = {"unavailable", "pending", "complete"};
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("state", Napi::String::New(env, stateNames[static_cast<int>(verdict.state)]));
+
+    Napi::Array matches = Napi::Array::New(env, verdict.matches.size());
+    for (size_t i = 0; i < verdict.matches.size(); i++) {
+        Napi::Object match = Napi::Object::New(env);
+        match.Set("ruleId", Napi::String::New(env, verdict.matches[i].ruleId));
+        match.Set("threatLevel", Napi::Number::New(env, verdict.matches[i].threatLevel));
+        match.Set("file", Napi::String::New(env, verdict.matches[i].file));
+        matches[i] = match;
+    }
+    result.Set("matches", matches);
+    return result;
+}
+
+// Caps the threads used for per-process deep analysis (module enumeration in
+// recording/screen-capture scans). 0 or no argument restores the default.
+// Returns the effective cap.
+Napi::Value SetAnalysisParallelism(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    size_t maxParallelism = 0;
+    if (info.Length() >= 1 && info[0].IsNumber()) {
+        int requested = info[0].As<Napi::Number>().Int32Value();
+        maxParallelism = requested > 0 ? static_cast<size_t>(requested) : 0;
+    }
+
+    WorkStealingPool::Instance().SetMaxParallelism(maxParallelism);
+    return Napi::Number::New(env, static_cast<double>(WorkStealingPool::Instance().MaxParallelism()));
+}
+
+// Selects how the Linux process-table walk reads /proc/<pid>/stat: "io_uring"
+// batches the reads, anything else uses pread. Returns the engine in effect, or
+// "unsupported" on other platforms.
+Napi::Value SetProcfsIoEngine(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+#ifdef __linux__
+    ProcfsIoEngine requested = ProcfsIoEngine::Pread;
+    if (info.Length() >= 1 && info[0].IsString() && info[0].As<Napi::String>().Utf8Value() == "io_uring") {
+        requested = ProcfsIoEngine::IoUring;
+    }
+
+    ProcfsIoEngine active = ProcessTable::Instance().SetProcfsIoEngine(requested);
+    return Napi::String::New(env, active == ProcfsIoEngine::IoUring ? "io_uring" : "pread");
+#else
+    return Napi::String::New(env, "unsupported");
+#endif
+}
+
+// Times the synchronous read loop, the pread engine and the io_uring engine over
+// every /proc/<pid>/stat. Resolves with average microseconds per full pass.
+Napi::Value BenchmarkProcfsReaderAsync(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    int iterations = 20;
+    if (info.Length() >= 1 && info[0].IsNumber()) {
+        iterations = std::max(1, info[0].As<Napi::Number>().Int32Value());
+    }
+
+    return QueueScan<ProcfsBenchmarkResult>(env,
+        [iterations]() {
+#ifdef __linux__
+            return ProcfsBatchReader::Benchmark(iterations);
+#else
+            (void)iterations;
+            return ProcfsBenchmarkResult();
+#endif
+        },
+        [](Napi::Env env, const ProcfsBenchmarkResult& result) -> Napi::Value {
+            Napi::Object obj = Napi::Object::New(env);
+            obj.Set("fileCount", Napi::Number::New(env, static_cast<double>(result.fileCount)));
+            obj.Set("iterations", Napi::Number::New(env, result.iterations));
+            obj.Set("synchronousUs", Napi::Number::New(env, result.synchronousUs));
+            obj.Set("preadUs", Napi::Number::New(env, result.preadUs));
+            obj.Set("ioUringUs", Napi::Number::New(env, result.ioUringUs));
+            obj.Set("ioUringAvailable", Napi::Boolean::New(env, result.ioUringAvailable));
+            return obj;
+        },
+        "Error benchmarking procfs reader: ");
+}
 
 // Screen Watcher functions
 Napi::Value StartScreenWatcher(const Napi::CallbackInfo& info) {
@@ -186,8 +1251,10 @@ Napi::Value StartScreenWatcher(const Napi::CallbackInfo& info) {
     }
     
     if (screen_watcher_instance) {
+        std::lock_guard<std::mutex> scanLock(screen_watcher_scan_mutex);
         screen_watcher_instance->stopWatching();
         delete screen_watcher_instance;
+        screen_watcher_instance = nullptr;
     }
     
     screen_watcher_instance = new ScreenWatcher();
@@ -219,6 +1286,7 @@ Napi::Value StopScreenWatcher(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     
     if (screen_watcher_instance) {
+        std::lock_guard<std::mutex> scanLock(screen_watcher_scan_mutex);
         screen_watcher_instance->stopWatching();
         delete screen_watcher_instance;
         screen_watcher_instance = nullptr;
@@ -235,7 +1303,8 @@ Napi::Value GetCurrentScreenStatus(const Napi::CallbackInfo& info) {
     }
 
     try {
-        ScreenStatus status = screen_watcher_instance->getCurrentStatus();
+        auto published = screen_watcher_instance->acquireStatus();
+        const ScreenStatus& status = published->value;
 
         Napi::Object result = Napi::Object::New(env);
         result.Set("mirroring", Napi::Boolean::New(env, status.mirroring));
@@ -243,6 +1312,7 @@ Napi::Value GetCurrentScreenStatus(const Napi::CallbackInfo& info) {
         result.Set("screenSharing", Napi::Boolean::New(env, status.screenSharing));
         result.Set("hasActiveCaptureSession", Napi::Boolean::New(env, status.hasActiveCaptureSession));
         result.Set("overallThreatLevel", Napi::Number::New(env, status.overallThreatLevel));
+        result.Set("generation", Napi::Number::New(env, static_cast<double>(published->generation)));
 
         // All displays
         Napi::Array displayArray = Napi::Array::New(env);
@@ -311,23 +1381,7 @@ Napi::Value DetectScreenSharingSessions(const Napi::CallbackInfo& info) {
 
     try {
         std::vector<ScreenSharingSession> sessions = screen_watcher_instance->detectScreenSharingSessions();
-
-        Napi::Array result = Napi::Array::New(env, sessions.size());
-
-        for (size_t i = 0; i < sessions.size(); i++) {
-            Napi::Object sessionObj = Napi::Object::New(env);
-            sessionObj.Set("method", Napi::Number::New(env, static_cast<int>(sessions[i].method)));
-            sessionObj.Set("processName", Napi::String::New(env, sessions[i].processName));
-            sessionObj.Set("pid", Napi::Number::New(env, sessions[i].pid));
-            sessionObj.Set("targetUrl", Napi::String::New(env, sessions[i].targetUrl));
-            sessionObj.Set("description", Napi::String::New(env, sessions[i].description));
-            sessionObj.Set("confidence", Napi::Number::New(env, sessions[i].confidence));
-            sessionObj.Set("isActive", Napi::Boolean::New(env, sessions[i].isActive));
-
-            result[i] = sessionObj;
-        }
-
-        return result;
+        return ScreenSharingSessionsToArray(env, sessions);
     } catch (const std::exception& e) {
         Napi::Error::New(env, std::string("Error detecting screen sharing sessions: ") + e.what()).ThrowAsJavaScriptException();
         return env.Null();
@@ -366,6 +1420,42 @@ Napi::Value CalculateScreenSharingThreatLevel(const Napi::CallbackInfo& info) {
     }
 }
 
+Napi::Value DetectScreenSharingSessionsAsync(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (!screen_watcher_instance) {
+        screen_watcher_instance = new ScreenWatcher();
+    }
+
+    return QueueScan<std::vector<ScreenSharingSession>>(env,
+        []() {
+            std::lock_guard<std::mutex> lock(screen_watcher_scan_mutex);
+            if (!screen_watcher_instance) throw std::runtime_error("screen watcher stopped");
+            return screen_watcher_instance->detectScreenSharingSessions();
+        },
+        ScreenSharingSessionsToArray,
+        "Error detecting screen sharing sessions: ");
+}
+
+Napi::Value CalculateScreenSharingThreatLevelAsync(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (!screen_watcher_instance) {
+        screen_watcher_instance = new ScreenWatcher();
+    }
+
+    return QueueScan<double>(env,
+        []() {
+            std::lock_guard<std::mutex> lock(screen_watcher_scan_mutex);
+            if (!screen_watcher_instance) throw std::runtime_error("screen watcher stopped");
+            return screen_watcher_instance->calculateScreenSharingThreatLevel();
+        },
+        [](Napi::Env env, const double& threatLevel) -> Napi::Value {
+            return Napi::Number::New(env, threatLevel);
+        },
+        "Error calculating threat level: ");
+}
+
 // VM Detector functions
 Napi::Value StartVMDetector(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
@@ -401,6 +1491,7 @@ Napi::Value StopVMDetector(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     
     if (vm_detector_instance) {
+        std::lock_guard<std::mutex> scanLock(vm_detector_scan_mutex);
         vm_detector_instance->Stop();
         delete vm_detector_instance;
         vm_detector_instance = nullptr;
@@ -418,33 +1509,30 @@ Napi::Value DetectVirtualMachine(const Napi::CallbackInfo& info) {
     
     try {
         VMDetectionResult result = vm_detector_instance->detectVirtualMachine();
-        
-        Napi::Object jsResult = Napi::Object::New(env);
-        jsResult.Set("isInsideVM", Napi::Boolean::New(env, result.isInsideVM));
-        jsResult.Set("detectedVM", Napi::String::New(env, result.detectedVM));
-        jsResult.Set("detectionMethod", Napi::String::New(env, result.detectionMethod));
-        
-        // Running VM processes
-        Napi::Array processArray = Napi::Array::New(env);
-        for (size_t i = 0; i < result.runningVMProcesses.size(); i++) {
-            processArray[i] = Napi::String::New(env, result.runningVMProcesses[i]);
-        }
-        jsResult.Set("runningVMProcesses", processArray);
-        
-        // VM indicators
-        Napi::Array indicatorArray = Napi::Array::New(env);
-        for (size_t i = 0; i < result.vmIndicators.size(); i++) {
-            indicatorArray[i] = Napi::String::New(env, result.vmIndicators[i]);
-        }
-        jsResult.Set("vmIndicators", indicatorArray);
-        
-        return jsResult;
+        return VMDetectionResultToObject(env, result);
     } catch (const std::exception& e) {
         Napi::Error::New(env, std::string("Error detecting VM: ") + e.what()).ThrowAsJavaScriptException();
         return env.Null();
     }
 }
 
+Napi::Value DetectVirtualMachineAsync(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (!vm_detector_instance) {
+        vm_detector_instance = new VMDetector();
+    }
+
+    return QueueScan<VMDetectionResult>(env,
+        []() {
+            std::lock_guard<std::mutex> lock(vm_detector_scan_mutex);
+            if (!vm_detector_instance) throw std::runtime_error("VM detector stopped");
+            return vm_detector_instance->detectVirtualMachine();
+        },
+        VMDetectionResultToObject,
+        "Error detecting VM: ");
+}
+
 
 // Focus Idle Watcher functions
 Napi::Value StartFocusIdleWatcher(const Napi::CallbackInfo& info) {
@@ -892,9 +1980,32 @@ Napi::Object Init(Napi::Env env, Napi::Object exports) {
     // Process Watcher functions
     exports.Set(Napi::String::New(env, "startProcessWatcher"), Napi::Function::New(env, StartProcessWatcher));
     exports.Set(Napi::String::New(env, "stopProcessWatcher"), Napi::Function::New(env, StopProcessWatcher));
+    exports.Set(Napi::String::New(env, "startProcessMonitor"), Napi::Function::New(env, StartProcessMonitor));
     exports.Set(Napi::String::New(env, "getProcessSnapshot"), Napi::Function::New(env, GetProcessSnapshot));
     exports.Set(Napi::String::New(env, "getCurrentRunningProcesses"), Napi::Function::New(env, GetProcessSnapshot)); // Alias for compatibility
     exports.Set(Napi::String::New(env, "detectSuspiciousBehavior"), Napi::Function::New(env, DetectSuspiciousBehavior));
+    exports.Set(Napi::String::New(env, "getProcessReport"), Napi::Function::New(env, GetProcessReport));
+    exports.Set(Napi::String::New(env, "getProcessSnapshotAsync"), Napi::Function::New(env, GetProcessSnapshotAsync));
+    exports.Set(Napi::String::New(env, "detectSuspiciousBehaviorAsync"), Napi::Function::New(env, DetectSuspiciousBehaviorAsync));
+    exports.Set(Napi::String::New(env, "getProcessReportAsync"), Napi::Function::New(env, GetProcessReportAsync));
+    exports.Set(Napi::String::New(env, "getProcessDelta"), Napi::Function::New(env, GetProcessDelta));
+    exports.Set(Napi::String::New(env, "getProcessDeltaAsync"), Napi::Function::New(env, GetProcessDeltaAsync));
+    exports.Set(Napi::String::New(env, "getProcessLineage"), Napi::Function::New(env, GetProcessLineage));
+    exports.Set(Napi::String::New(env, "getProcessLineageAsync"), Napi::Function::New(env, GetProcessLineageAsync));
+    exports.Set(Napi::String::New(env, "detectNetworkPatterns"), Napi::Function::New(env, DetectNetworkPatterns));
+    exports.Set(Napi::String::New(env, "detectNetworkPatternsAsync"), Napi::Function::New(env, DetectNetworkPatternsAsync));
+    exports.Set(Napi::String::New(env, "setKnownBadExecutables"), Napi::Function::New(env, SetKnownBadExecutables));
+    exports.Set(Napi::String::New(env, "getExecutableHash"), Napi::Function::New(env, GetExecutableHash));
+    exports.Set(Napi::String::New(env, "setSignatureRules"), Napi::Function::New(env, SetSignatureRules));
+    exports.Set(Napi::String::New(env, "loadEndpointRanges"), Napi::Function::New(env, LoadEndpointRanges));
+    exports.Set(Napi::String::New(env, "startDomainObserver"), Napi::Function::New(env, StartDomainObserver));
+    exports.Set(Napi::String::New(env, "stopDomainObserver"), Napi::Function::New(env, StopDomainObserver));
+    exports.Set(Napi::String::New(env, "setDomainRules"), Napi::Function::New(env, SetDomainRules));
+    exports.Set(Napi::String::New(env, "getDomainObserverStats"), Napi::Function::New(env, GetDomainObserverStats));
+    exports.Set(Napi::String::New(env, "getSignatureMatches"), Napi::Function::New(env, GetSignatureMatches));
+    exports.Set(Napi::String::New(env, "setAnalysisParallelism"), Napi::Function::New(env, SetAnalysisParallelism));
+    exports.Set(Napi::String::New(env, "setProcfsIoEngine"), Napi::Function::New(env, SetProcfsIoEngine));
+    exports.Set(Napi::String::New(env, "benchmarkProcfsReaderAsync"), Napi::Function::New(env, BenchmarkProcfsReaderAsync));
 
     
     // Screen Watcher functions
@@ -905,6 +2016,8 @@ Napi::Object Init(Napi::Env env, Napi::Object exports) {
     exports.Set(Napi::String::New(env, "detectScreenSharingSessions"), Napi::Function::New(env, DetectScreenSharingSessions));
     exports.Set(Napi::String::New(env, "isScreenBeingCaptured"), Napi::Function::New(env, IsScreenBeingCaptured));
     exports.Set(Napi::String::New(env, "calculateScreenSharingThreatLevel"), Napi::Function::New(env, CalculateScreenSharingThreatLevel));
+    exports.Set(Napi::String::New(env, "detectScreenSharingSessionsAsync"), Napi::Function::New(env, DetectScreenSharingSessionsAsync));
+    exports.Set(Napi::String::New(env, "calculateScreenSharingThreatLevelAsync"), Napi::Function::New(env, CalculateScreenSharingThreatLevelAsync));
 
     // Recording/Overlay Detection functions (extending ScreenWatcher)
     exports.Set(Napi::String::New(env, "detectRecordingAndOverlays"), Napi::Function::New(env, DetectRecordingAndOverlays));
@@ -914,6 +2027,7 @@ Napi::Object Init(Napi::Env env, Napi::Object exports) {
     exports.Set(Napi::String::New(env, "startVMDetector"), Napi::Function::New(env, StartVMDetector));
     exports.Set(Napi::String::New(env, "stopVMDetector"), Napi::Function::New(env, StopVMDetector));
     exports.Set(Napi::String::New(env, "detectVirtualMachine"), Napi::Function::New(env, DetectVirtualMachine));
+    exports.Set(Napi::String::New(env, "detectVirtualMachineAsync"), Napi::Function::New(env, DetectVirtualMachineAsync));
     
     // Notification Watcher functions
     
@@ -1202,6 +2316,7 @@ Napi::Object Init(Napi::Env env, Napi::Object exports) {
         Napi::Env env = info.Env();
         try {
             if (smart_device_detector_instance) {
+                std::lock_guard<std::mutex> scanLock(smart_device_detector_scan_mutex);
                 smart_device_detector_instance->Stop();
                 delete smart_device_detector_instance;
                 smart_device_detector_instance = nullptr;
@@ -1220,7 +2335,8 @@ Napi::Object Init(Napi::Env env, Napi::Object exports) {
                 smart_device_detector_instance = new SmartDeviceDetector();
             }
 
-            std::vector<DeviceViolation> violations = smart_device_detector_instance->GetActiveViolations();
+            auto published = smart_device_detector_instance->GetViolationSnapshot();
+            const std::vector<DeviceViolation>& violations = published->value;
             Napi::Array result = Napi::Array::New(env, violations.size());
 
             for (size_t i = 0; i < violations.size(); i++) {
@@ -1339,29 +2455,7 @@ Napi::Object Init(Napi::Env env, Napi::Object exports) {
             }
 
             std::vector<InputDeviceInfo> devices = smart_device_detector_instance->ScanAllInputDevices();
-            Napi::Array result = Napi::Array::New(env, devices.size());
-
-            for (size_t i = 0; i < devices.size(); i++) {
-                Napi::Object deviceObj = Napi::Object::New(env);
-                deviceObj.Set("name", Napi::String::New(env, devices[i].name));
-                deviceObj.Set("type", Napi::String::New(env, devices[i].type));
-                deviceObj.Set("deviceId", Napi::String::New(env, devices[i].deviceId));
-                deviceObj.Set("manufacturer", Napi::String::New(env, devices[i].manufacturer));
-                deviceObj.Set("vendorId", Napi::String::New(env, devices[i].vendorId));
-                deviceObj.Set("productId", Napi::String::New(env, devices[i].productId));
-                deviceObj.Set("isExternal", Napi::Boolean::New(env, devices[i].isExternal));
-                deviceObj.Set("isVirtual", Napi::Boolean::New(env, devices[i].isVirtual));
-                deviceObj.Set("isSpoofed", Napi::Boolean::New(env, devices[i].isSpoofed));
-                deviceObj.Set("isBluetooth", Napi::Boolean::New(env, devices[i].isBluetooth));
-                deviceObj.Set("isWireless", Napi::Boolean::New(env, devices[i].isWireless));
-                deviceObj.Set("threatLevel", Napi::Number::New(env, devices[i].threatLevel));
-                deviceObj.Set("threatReason", Napi::String::New(env, devices[i].threatReason));
-                deviceObj.Set("isAllowed", Napi::Boolean::New(env, devices[i].isAllowed));
-
-                result[i] = deviceObj;
-            }
-
-            return result;
+            return InputDevicesToArray(env, devices);
         } catch (const std::exception& e) {
             Napi::Error::New(env, std::string("Error scanning input devices: ") + e.what()).ThrowAsJavaScriptException();
             return env.Null();
@@ -1376,20 +2470,7 @@ Napi::Object Init(Napi::Env env, Napi::Object exports) {
             }
 
             std::vector<StorageDeviceInfo> devices = smart_device_detector_instance->ScanAllStorageDevices();
-            Napi::Array result = Napi::Array::New(env, devices.size());
-
-            for (size_t i = 0; i < devices.size(); i++) {
-                Napi::Object deviceObj = Napi::Object::New(env);
-                deviceObj.Set("id", Napi::String::New(env, devices[i].id));
-                deviceObj.Set("type", Napi::String::New(env, devices[i].type));
-                deviceObj.Set("name", Napi::String::New(env, devices[i].name));
-                deviceObj.Set("path", Napi::String::New(env, devices[i].path));
-                deviceObj.Set("isExternal", Napi::Boolean::New(env, devices[i].isExternal));
-
-                result[i] = deviceObj;
-            }
-
-            return result;
+            return StorageDevicesToArray(env, devices);
         } catch (const std::exception& e) {
             Napi::Error::New(env, std::string("Error scanning storage devices: ") + e.what()).ThrowAsJavaScriptException();
             return env.Null();
@@ -1404,33 +2485,62 @@ Napi::Object Init(Napi::Env env, Napi::Object exports) {
             }
 
             std::vector<InputDeviceInfo> devices = smart_device_detector_instance->ScanVideoDevices();
-            Napi::Array result = Napi::Array::New(env, devices.size());
-
-            for (size_t i = 0; i < devices.size(); i++) {
-                Napi::Object deviceObj = Napi::Object::New(env);
-                deviceObj.Set("name", Napi::String::New(env, devices[i].name));
-                deviceObj.Set("type", Napi::String::New(env, devices[i].type));
-                deviceObj.Set("deviceId", Napi::String::New(env, devices[i].deviceId));
-                deviceObj.Set("manufacturer", Napi::String::New(env, devices[i].manufacturer));
-                deviceObj.Set("vendorId", Napi::String::New(env, devices[i].vendorId));
-                deviceObj.Set("productId", Napi::String::New(env, devices[i].productId));
-                deviceObj.Set("isExternal", Napi::Boolean::New(env, devices[i].isExternal));
-                deviceObj.Set("isVirtual", Napi::Boolean::New(env, devices[i].isVirtual));
-                deviceObj.Set("isSpoofed", Napi::Boolean::New(env, devices[i].isSpoofed));
-                deviceObj.Set("threatLevel", Napi::Number::New(env, devices[i].threatLevel));
-                deviceObj.Set("threatReason", Napi::String::New(env, devices[i].threatReason));
-                deviceObj.Set("isAllowed", Napi::Boolean::New(env, devices[i].isAllowed));
-
-                result[i] = deviceObj;
-            }
-
-            return result;
+            return VideoDevicesToArray(env, devices);
         } catch (const std::exception& e) {
             Napi::Error::New(env, std::string("Error scanning video devices: ") + e.what()).ThrowAsJavaScriptException();
             return env.Null();
         }
     }));
 
+    // Promise variants of the device scans (WMI/IOKit work stays off the JS thread)
+    exports.Set(Napi::String::New(env, "scanAllInputDevicesAsync"), Napi::Function::New(env, [](const Napi::CallbackInfo& info) -> Napi::Value {
+        Napi::Env env = info.Env();
+        if (!smart_device_detector_instance) {
+            smart_device_detector_instance = new SmartDeviceDetector();
+        }
+
+        return QueueScan<std::vector<InputDeviceInfo>>(env,
+            []() {
+                std::lock_guard<std::mutex> lock(smart_device_detector_scan_mutex);
+                if (!smart_device_detector_instance) throw std::runtime_error("smart device detector stopped");
+                return smart_device_detector_instance->ScanAllInputDevices();
+            },
+            InputDevicesToArray,
+            "Error scanning input devices: ");
+    }));
+
+    exports.Set(Napi::String::New(env, "scanAllStorageDevicesAsync"), Napi::Function::New(env, [](const Napi::CallbackInfo& info) -> Napi::Value {
+        Napi::Env env = info.Env();
+        if (!smart_device_detector_instance) {
+            smart_device_detector_instance = new SmartDeviceDetector();
+        }
+
+        return QueueScan<std::vector<StorageDeviceInfo>>(env,
+            []() {
+                std::lock_guard<std::mutex> lock(smart_device_detector_scan_mutex);
+                if (!smart_device_detector_instance) throw std::runtime_error("smart device detector stopped");
+                return smart_device_detector_instance->ScanAllStorageDevices();
+            },
+            StorageDevicesToArray,
+            "Error scanning storage devices: ");
+    }));
+
+    exports.Set(Napi::String::New(env, "scanVideoDevicesAsync"), Napi::Function::New(env, [](const Napi::CallbackInfo& info) -> Napi::Value {
+        Napi::Env env = info.Env();
+        if (!smart_device_detector_instance) {
+            smart_device_detector_instance = new SmartDeviceDetector();
+        }
+
+        return QueueScan<std::vector<InputDeviceInfo>>(env,
+            []() {
+                std::lock_guard<std::mutex> lock(smart_device_detector_scan_mutex);
+                if (!smart_device_detector_instance) throw std::runtime_error("smart device detector stopped");
+                return smart_device_detector_instance->ScanVideoDevices();
+            },
+            VideoDevicesToArray,
+            "Error scanning video devices: ");
+    }));
+
     // Legacy compatibility
     exports.Set(Napi::String::New(env, "start"), Napi::Function::New(env, Start));
     exports.Set(Napi::String::New(env, "stop"), Napi::Function::New(env, Stop));
@@ -4,6 +4,7 @@ class ProcessWatchWorker extends WorkerBase {
     constructor() {
         super('process-watch');
         this.isUsingProcessWatcher = false;
+        this.isUsingProcessMonitor = false;
     }
     
     startNativeMode() {
@@ -18,26 +19,118 @@ class ProcessWatchWorker extends WorkerBase {
     startPollingMode() {
         console.log(`[${this.moduleName}] Using enhanced detection mode`);
 
+        // Prefer the fused report: one enumeration and classification pass per tick
+        const hasReport = this.nativeAddon &&
+                          typeof this.nativeAddon.getProcessReport === 'function';
+        // Async variant scans on the libuv thread pool so heartbeats keep flowing
+        const hasAsyncReport = this.nativeAddon &&
+                               typeof this.nativeAddon.getProcessReportAsync === 'function';
+        // Delta variant only marshals processes that started, exited or changed
+        // class since the last tick; the table below is patched in place
+        const hasAsyncDelta = this.nativeAddon &&
+                              typeof this.nativeAddon.getProcessDeltaAsync === 'function';
+        this.reportInFlight = false;
+        this.processTable = new Map();
+        this.deltaGeneration = 0;
+        this.lastSentAt = 0;
+
+        // Callback-free native loop: reports are rebuilt in the background on
+        // exec/exit events, and the delta getter only diffs the latest one, so
+        // it can be polled often without rescanning
+        if (hasAsyncDelta && typeof this.nativeAddon.startProcessMonitor === 'function') {
+            try {
+                this.isUsingProcessMonitor = this.nativeAddon.startProcessMonitor({ intervalMs: 1500 });
+            } catch (err) {
+                console.error(`[${this.moduleName}] Error starting process monitor:`, err);
+            }
+        }
+        const pollIntervalMs = this.isUsingProcessMonitor ? 250 : 1500;
+
         // Check if enhanced methods are available
         const hasEnhanced = this.nativeAddon &&
                            typeof this.nativeAddon.getProcessSnapshot === 'function' &&
                            typeof this.nativeAddon.detectSuspiciousBehavior === 'function';
 
-        if (!hasEnhanced && (!this.nativeAddon || typeof this.nativeAddon.getProcessSnapshot !== 'function')) {
+        if (!hasReport && !hasAsyncReport && !hasEnhanced && (!this.nativeAddon || typeof this.nativeAddon.getProcessSnapshot !== 'function')) {
             console.error(`[${this.moduleName}] Process detection methods not available, falling back`);
             this.startFallbackMode();
             return;
         }
 
-        console.log(`[${this.moduleName}] Starting enhanced process detection with 1.5s interval`);
+        console.log(`[${this.moduleName}] Starting enhanced process detection with ${pollIntervalMs}ms interval`);
 
-        this.processPollingInterval = setInterval(() => {
-            if (!this.isRunning) return;
+        this.processPollingInterval = setInterval(async () => {
+            if (!this.isRunning || this.reportInFlight) return;
 
             try {
                 let processedData;
 
-                if (hasEnhanced) {
+                if (hasAsyncDelta) {
+                    this.reportInFlight = true;
+                    let delta;
+                    try {
+                        delta = await this.nativeAddon.getProcessDeltaAsync({
+                            sinceGeneration: this.deltaGeneration,
+                            includeModules: false,
+                            includeEvidence: false
+                        });
+                    } finally {
+                        this.reportInFlight = false;
+                    }
+                    if (!this.isRunning) return;
+
+                    // Exits and downgrades of flagged processes go out on their
+                    // own, before the table forgets the process
+                    for (const cleared of this.collectClearedThreats(delta)) {
+                        this.sendToParent({
+                            type: 'proctor-event',
+                            module: this.moduleName,
+                            payload: cleared
+                        });
+                    }
+
+                    this.applyProcessDelta(delta);
+
+                    // Fast polls only report changes; unchanged state still goes
+                    // out at the regular 1.5s cadence
+                    const changed = delta.fullResync || delta.added.length > 0 ||
+                                    delta.removed.length > 0 || delta.reclassified.length > 0;
+                    if (!changed && Date.now() - this.lastSentAt < 1500) return;
+
+                    const processes = Array.from(this.processTable.values());
+                    const suspiciousBehavior = processes.filter(p => p.threatLevel > 0);
+
+                    processedData = this.processEnhancedSnapshot(suspiciousBehavior, processes);
+                    processedData.delta = {
+                        fullResync: delta.fullResync,
+                        added: delta.added.length,
+                        removed: delta.removed.length,
+                        reclassified: delta.reclassified.length,
+                        cleared: delta.cleared ? delta.cleared.length : 0
+                    };
+                    console.log(`[${this.moduleName}] Enhanced detection: ${suspiciousBehavior.length} suspicious processes found`);
+                } else if (hasReport || hasAsyncReport) {
+                    const reportOptions = {
+                        includeModules: false,
+                        includeEvidence: false
+                    };
+                    let report;
+                    if (hasAsyncReport) {
+                        this.reportInFlight = true;
+                        try {
+                            report = await this.nativeAddon.getProcessReportAsync(reportOptions);
+                        } finally {
+                            this.reportInFlight = false;
+                        }
+                        if (!this.isRunning) return;
+                    } else {
+                        report = this.nativeAddon.getProcessReport(reportOptions);
+                    }
+                    const suspiciousBehavior = report.suspiciousIndices.map(i => report.processes[i]);
+
+                    processedData = this.processEnhancedSnapshot(suspiciousBehavior, report.processes);
+                    console.log(`[${this.moduleName}] Enhanced detection: ${suspiciousBehavior.length} suspicious processes found`);
+                } else if (hasEnhanced) {
                     // Use enhanced detection with threat scoring
                     const suspiciousBehavior = this.nativeAddon.detectSuspiciousBehavior();
                     const enhancedSnapshot = this.nativeAddon.getProcessSnapshot();
@@ -56,14 +149,67 @@ class ProcessWatchWorker extends WorkerBase {
                     module: this.moduleName,
                     payload: processedData
                 });
+                this.lastSentAt = Date.now();
 
             } catch (err) {
                 console.error(`[${this.moduleName}] Error in process detection:`, err);
                 this.startFallbackMode();
             }
-        }, 1500);
+        }, pollIntervalMs);
     }
     
+    // threat-cleared events for flagged processes that exited or lost their
+    // threat level. A full resync carries no baseline, so it is compared
+    // against the table instead.
+    collectClearedThreats(delta) {
+        let cleared = delta.cleared || [];
+        if (delta.fullResync) {
+            const current = new Map(delta.added.map(p => [p.pid, p]));
+            cleared = [];
+            for (const previous of this.processTable.values()) {
+                if (previous.threatLevel <= 0) continue;
+                const now = current.get(previous.pid);
+                if (!now || now.name !== previous.name || now.path !== previous.path) {
+                    cleared.push({ pid: previous.pid, category: previous.category, threatLevel: previous.threatLevel, reason: 'exited' });
+                } else if (now.threatLevel === 0) {
+                    cleared.push({ pid: previous.pid, category: previous.category, threatLevel: previous.threatLevel, reason: 'reclassified' });
+                }
+            }
+        }
+
+        return cleared.map(entry => {
+            const known = this.processTable.get(entry.pid) || {};
+            return {
+                module: this.moduleName,
+                eventType: 'threat-cleared',
+                reason: entry.reason,
+                pid: entry.pid,
+                name: known.name || '',
+                path: known.path || '',
+                category: entry.category,
+                threatLevel: entry.threatLevel,
+                timestamp: Date.now(),
+                source: 'native'
+            };
+        });
+    }
+
+    applyProcessDelta(delta) {
+        if (delta.fullResync) {
+            this.processTable.clear();
+        }
+        for (const process of delta.removed) {
+            this.processTable.delete(process.pid);
+        }
+        for (const process of delta.added) {
+            this.processTable.set(process.pid, process);
+        }
+        for (const process of delta.reclassified) {
+            this.processTable.set(process.pid, process);
+        }
+        this.deltaGeneration = delta.generation;
+    }
+
     startFallbackMode() {
         console.log(`[${this.moduleName}] Using JavaScript process watcher fallback`);
         
@@ -181,10 +327,11 @@ class ProcessWatchWorker extends WorkerBase {
             this.processPollingInterval = null;
         }
         
-        if (this.isUsingProcessWatcher && this.nativeAddon) {
+        if ((this.isUsingProcessWatcher || this.isUsingProcessMonitor) && this.nativeAddon) {
             try {
                 this.nativeAddon.stopProcessWatcher();
                 this.isUsingProcessWatcher = false;
+                this.isUsingProcessMonitor = false;
             } catch (err) {
                 console.error(`[${this.moduleName}] Error stopping process watcher:`, err);
             }